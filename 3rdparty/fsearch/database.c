@@ -857,6 +857,211 @@ bool db_location_add(Database *db,
     return false;
 }
 
+static bool
+db_path_has_data_prefix(const char *dname)
+{
+    GList *info = get_fstable_bindinfo();
+    for (info = g_list_first(info); info != NULL; info = g_list_next(info)) {
+        char *data = info->data;
+        if (strncmp(data, dname, strlen(data)) == 0)
+            return true;
+    }
+    return false;
+}
+
+static void
+db_build_child_path(char *fn, size_t fn_len, const char *dname, const char *name)
+{
+    if (!strcmp(dname, "/"))
+        snprintf(fn, fn_len, "/%s", name);
+    else
+        snprintf(fn, fn_len, "%s/%s", dname, name);
+}
+
+// re-read one directory, add the entries created and drop the entries deleted since it was indexed
+static uint32_t
+db_location_sync_dir(DatabaseLocation *location,
+                     DatabaseConfig *db_config,
+                     BTreeNode *dir_node,
+                     const char *dname,
+                     bool *is_stop)
+{
+    DIR *dir = opendir(dname);
+    if (!dir)
+        return 0;
+
+    struct stat dir_st;
+    if (fstat(dirfd(dir), &dir_st) == 0)
+        dir_node->mtime = dir_st.st_mtime;
+
+    GHashTable *indexed = g_hash_table_new(g_str_hash, g_str_equal);
+    for (BTreeNode *child = dir_node->children; child; child = child->next)
+        g_hash_table_insert(indexed, child->name, child);
+    GHashTable *on_disk = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+
+    const bool has_data_prefix = db_path_has_data_prefix(dname);
+    const int depth = (int)btree_node_depth(dir_node);
+    GTimer *timer = g_timer_new();
+    uint32_t changes = 0;
+
+    struct dirent *dent = NULL;
+    while ((dent = readdir(dir))) {
+        if (!strcmp(dent->d_name, ".") || !strcmp(dent->d_name, ".."))
+            continue;
+
+        if (db_config->filter_hidden_file && dent->d_name[0] == '.')
+            continue;
+
+        g_hash_table_add(on_disk, g_strdup(dent->d_name));
+        if (g_hash_table_contains(indexed, dent->d_name))
+            continue;
+
+        char fn[FILENAME_MAX] = "";
+        db_build_child_path(fn, sizeof(fn), dname, dent->d_name);
+        struct stat st;
+        if (lstat(fn, &st) == -1)
+            continue;
+
+        const bool is_dir = S_ISDIR(st.st_mode);
+        char full_py_name[FILENAME_MAX] = "";
+        char first_py_name[FILENAME_MAX] = "";
+        if (db_config->enable_py)
+            convert_all_pinyin(dent->d_name, first_py_name, full_py_name);
+
+        BTreeNode *node = btree_node_new(dent->d_name,
+                                         full_py_name,
+                                         first_py_name,
+                                         st.st_mtime,
+                                         st.st_size,
+                                         0,
+                                         is_dir);
+        btree_node_prepend(dir_node, node);
+        location->num_items++;
+        changes++;
+
+        if (is_dir && depth < MAX_DIR_DEPTH) {
+            const uint32_t before = location->num_items;
+            db_location_walk_tree_recursive(location, db_config, NULL, NULL, fn, timer, NULL,
+                                            node, 0, is_stop, has_data_prefix, depth + 1);
+            changes += location->num_items - before;
+        }
+    }
+    closedir(dir);
+
+    BTreeNode *child = dir_node->children;
+    while (child) {
+        BTreeNode *next = child->next;
+        if (!g_hash_table_contains(on_disk, child->name)) {
+            const uint32_t removed = btree_node_n_nodes(child);
+            location->num_items -= MIN(removed, location->num_items);
+            changes += removed;
+            btree_node_remove(child);
+        }
+        child = next;
+    }
+
+    g_timer_destroy(timer);
+    g_hash_table_destroy(on_disk);
+    g_hash_table_destroy(indexed);
+    return changes;
+}
+
+// only the directories are stated, a directory whose mtime changed gets its children re-read
+static uint32_t
+db_location_refresh_recursive(DatabaseLocation *location,
+                              DatabaseConfig *db_config,
+                              BTreeNode *node,
+                              const char *dname,
+                              bool *is_stop)
+{
+    if (*is_stop)
+        return 0;
+
+    uint32_t changes = 0;
+    struct stat st;
+    if (lstat(dname, &st) == 0 && S_ISDIR(st.st_mode) && st.st_mtime != node->mtime)
+        changes += db_location_sync_dir(location, db_config, node, dname, is_stop);
+
+    for (BTreeNode *child = node->children; child; child = child->next) {
+        if (!child->is_dir)
+            continue;
+
+        char fn[FILENAME_MAX] = "";
+        db_build_child_path(fn, sizeof(fn), dname, child->name);
+        changes += db_location_refresh_recursive(location, db_config, child, fn, is_stop);
+    }
+    return changes;
+}
+
+static BTreeNode *
+db_location_find_dir(DatabaseLocation *location, const char *path)
+{
+    BTreeNode *node = location->entries;
+    const size_t root_len = strlen(node->name);
+    if (strncmp(path, node->name, root_len) != 0)
+        return NULL;
+
+    const char *rest = path + root_len;
+    if (*rest != '\0' && *rest != '/')
+        return NULL;
+
+    gchar **parts = g_strsplit(rest, "/", -1);
+    for (gchar **part = parts; *part && node; ++part) {
+        if (**part == '\0')
+            continue;
+
+        BTreeNode *child = node->children;
+        while (child && (!child->is_dir || strcmp(child->name, *part) != 0))
+            child = child->next;
+        node = child;
+    }
+    g_strfreev(parts);
+    return node;
+}
+
+static uint32_t
+db_location_apply_refresh(Database *db, const char *location_name, const char *dir_path, bool *is_stop)
+{
+    assert(db != NULL);
+    assert(location_name != NULL);
+
+    db_lock(db);
+    DatabaseLocation *location = db_location_get_for_path(db, strcmp(location_name, "/") ? location_name : "");
+    BTreeNode *node = NULL;
+    if (location)
+        node = dir_path ? db_location_find_dir(location, dir_path) : location->entries;
+
+    uint32_t changes = 0;
+    if (node) {
+        char dname[FILENAME_MAX] = "";
+        btree_node_get_path_full(node, dname, sizeof(dname));
+        if (dir_path) {
+            changes = db_location_sync_dir(location, db->db_config, node, dname, is_stop);
+        } else {
+            changes = db_location_refresh_recursive(location, db->db_config, node, dname, is_stop);
+        }
+    }
+    db_unlock(db);
+
+    // the entries list points into the tree, rebuild it once for the whole batch of changes
+    if (changes > 0) {
+        db_build_initial_entries_list(db);
+        db_update_timestamp(db);
+    }
+    return changes;
+}
+
+uint32_t db_location_refresh(Database *db, const char *location_name, bool *is_stop)
+{
+    return db_location_apply_refresh(db, location_name, NULL, is_stop);
+}
+
+uint32_t db_location_refresh_dir(Database *db, const char *location_name, const char *dir_path, bool *is_stop)
+{
+    assert(dir_path != NULL);
+    return db_location_apply_refresh(db, location_name, dir_path, is_stop);
+}
+
 void db_update_sort_index(Database *db)
 {
     assert(db != NULL);
@@ -59,6 +59,10 @@ bool db_location_add(Database *db,
 
 bool db_location_remove(Database *db, const char *path);
 
+uint32_t db_location_refresh(Database *db, const char *location_name, bool *is_stop);
+
+uint32_t db_location_refresh_dir(Database *db, const char *location_name, const char *dir_path, bool *is_stop);
+
 bool db_location_write_to_file(DatabaseLocation *location, const char *fname);
 
 BTreeNode *
@@ -35,6 +35,7 @@ public:
         kCopyRemote = 0x400,   // 深信服远程拷贝
         kRedo = 0x800,   // 重新执行（ctrl + Y）
         kCountProgressCustomize = 0x1000,   // 强制使用自己统计进度
+        kCopyIntegrityReread = 0x2000,   // 严格完整性校验：同步并丢弃页缓存后重新读取目标文件，代价是每个文件读两遍（需同时设置kCopyIntegrityChecking）
     };
     Q_ENUM(JobFlag)
     Q_DECLARE_FLAGS(JobFlags, JobFlag)
@@ -143,6 +144,7 @@ public:
         kCompleteCustomInfosKey = 17,
         kJobHandlePointer = 18,
         kWorkerPointer = 19,
+        kCopyWayStatisticsKey = 20,   // QVariantMap: "cloned" and "rangeCopied" file counts
     };
     Q_ENUM(NotifyInfoKey)
     enum class NotifyType : uint8_t {
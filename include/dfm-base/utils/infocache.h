@@ -19,6 +19,15 @@ namespace dfmbase {
 class InfoCachePrivate;
 class InfoCache;
 
+struct InfoCacheStatistics
+{
+    quint64 hits { 0 };
+    quint64 misses { 0 };
+    quint64 evictions { 0 };
+    qint64 bytes { 0 };
+    int count { 0 };
+};
+
 // 异步缓存和移除
 class CacheWorker : public QObject
 {
@@ -45,14 +54,13 @@ class TimeToUpdateCache : public QObject
 public:
     ~TimeToUpdateCache() override;
 public Q_SLOTS:
-    void updateInfoTime(const QUrl url);
     void dealRemoveInfo();
     void updateWatcherTime(const QList<QUrl> &urls, const bool add);
 private:
     explicit TimeToUpdateCache(QObject *parent = nullptr);
 };
 
-class InfoCachePrivate;
+struct InfoCacheShard;
 class InfoCache : public QObject
 {
     Q_OBJECT
@@ -69,7 +77,6 @@ public:
 Q_SIGNALS:
     void cacheRemoveCaches(const QList<QUrl> &key);
     void cacheDisconnectWatcher(const QMap<QUrl, FileInfoPointer> infos);
-    void cacheUpdateInfoTime(const QUrl url);
 
 private:
     explicit InfoCache(QObject *parent = nullptr);
@@ -81,10 +88,10 @@ private:
     void cacheInfo(const QUrl url, const FileInfoPointer info);
     void disconnectWatcher(const QMap<QUrl, FileInfoPointer> infos);
     void removeCaches(const QList<QUrl> urls);
-    bool updateSortTimeWorker(const QUrl url);
     void timeRemoveCache();
-    void removeInfosTimeWorker(const QList<QUrl> urls);
+    void evictOverBudget(InfoCacheShard &shard, QMap<QUrl, FileInfoPointer> *evicted);
     void updateSortTimeWatcherWorker(const QList<QUrl> &urls, const bool add);
+    InfoCacheStatistics statistics();
 
 private Q_SLOTS:
     void fileAttributeChanged(const QUrl url);
@@ -110,6 +117,7 @@ public:
     bool cacheDisable(const QString &scheme);
     void setCacheDisbale(const QString &scheme, bool disable = true);
     FileInfoPointer getCacheInfo(const QUrl &url);
+    InfoCacheStatistics statistics();
 Q_SIGNALS:
     void cacheFileInfo(const QUrl url, const FileInfoPointer info);
     void removeCacheFileInfo(const QList<QUrl> &urls);
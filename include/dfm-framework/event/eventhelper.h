@@ -69,7 +69,9 @@ inline void threadEventAlert(const QString &eventName)
 
 inline void threadEventAlert(const QString &space, const QString &topic)
 {
-    threadEventAlert(space + "::" + topic);
+    // build the event name only when it is going to be printed
+    if (Q_UNLIKELY(QThread::currentThread() != QCoreApplication::instance()->thread()))
+        threadEventAlert(space + "::" + topic);
 }
 
 inline void threadEventAlert(EventType type)
@@ -6,6 +6,7 @@
 #define SQLITECONNECTIONPOOL_P_H
 
 #include <dfm-base/dfm_base_global.h>
+#include <dfm-base/base/db/sqliteconnectionpool.h>
 
 #include <QString>
 #include <QtSql>
@@ -18,9 +19,11 @@ public:
     SqliteConnectionPoolPrivate();
     QString makeConnectionName(const QString &databaseName);
     QSqlDatabase createConnection(const QString &databaseName, const QString &connectionName);
+    void applyPragmas(QSqlDatabase *db);
 
 public:
     QString connectionName;
+    QAtomicInt synchronous { static_cast<int>(SqliteConnectionPool::Synchronous::kNormal) };
 };
 
 DFMBASE_END_NAMESPACE
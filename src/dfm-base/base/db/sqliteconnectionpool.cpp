@@ -15,6 +15,7 @@ DFMBASE_USE_NAMESPACE
 
 static constexpr char kDatabaseType[] { "QSQLITE" };
 static constexpr char kTestSql[] { "SELECT 1" };
+static constexpr char kWalSql[] { "PRAGMA journal_mode=WAL;" };
 
 SqliteConnectionPoolPrivate::SqliteConnectionPoolPrivate()
 {
@@ -35,6 +36,7 @@ QSqlDatabase SqliteConnectionPoolPrivate::createConnection(const QString &databa
     db.setDatabaseName(databaseName);
 
     if (db.open()) {
+        applyPragmas(&db);
         qCInfo(logDFMBase).noquote() << QString("Connection created: %1, sn: %2").arg(connectionName).arg(++sn);
         return db;
     } else {
@@ -43,6 +45,19 @@ QSqlDatabase SqliteConnectionPoolPrivate::createConnection(const QString &databa
     }
 }
 
+void SqliteConnectionPoolPrivate::applyPragmas(QSqlDatabase *db)
+{
+    // readers do not block the writer and a commit appends to the log instead of rewriting pages
+    QSqlQuery query(*db);
+    if (!query.exec(kWalSql))
+        qCWarning(logDFMBase).noquote() << "Enable WAL error:" << query.lastError().text();
+
+    static const char *const kSynchronousSql[] { "PRAGMA synchronous=OFF;", "PRAGMA synchronous=NORMAL;",
+                                                 "PRAGMA synchronous=FULL;" };
+    if (!query.exec(kSynchronousSql[synchronous.loadAcquire()]))
+        qCWarning(logDFMBase).noquote() << "Set synchronous error:" << query.lastError().text();
+}
+
 SqliteConnectionPool::SqliteConnectionPool(QObject *parent)
     : QObject(parent), d(new SqliteConnectionPoolPrivate)
 {
@@ -58,6 +73,14 @@ SqliteConnectionPool &SqliteConnectionPool::instance()
     return ins;
 }
 
+/*!
+ * \brief SqliteConnectionPool::setSynchronous set the synchronous level of the connections created afterwards
+ */
+void SqliteConnectionPool::setSynchronous(Synchronous level)
+{
+    d->synchronous.storeRelease(static_cast<int>(level));
+}
+
 QSqlDatabase SqliteConnectionPool::openConnection(const QString &databaseName)
 {
     assert(!databaseName.isEmpty());
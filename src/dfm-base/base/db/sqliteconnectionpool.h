@@ -19,8 +19,16 @@ class SqliteConnectionPool : public QObject
     Q_DISABLE_COPY(SqliteConnectionPool)
 
 public:
+    // PRAGMA synchronous of the connections, in WAL mode kNormal only risks the last commits on power loss
+    enum class Synchronous {
+        kOff,
+        kNormal,
+        kFull
+    };
+
     static SqliteConnectionPool &instance();
     QSqlDatabase openConnection(const QString &databaseName);
+    void setSynchronous(Synchronous level);
 
 private:
     explicit SqliteConnectionPool(QObject *parent = nullptr);
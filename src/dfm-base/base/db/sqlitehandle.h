@@ -10,8 +10,11 @@
 #include <dfm-base/base/db/sqlitequeryable.h>
 
 #include <QObject>
+#include <QSharedPointer>
 #include <QDebug>
 
+#include <iterator>
+
 DFMBASE_BEGIN_NAMESPACE
 
 class SqliteHandle
@@ -78,51 +81,27 @@ public:
     int insert(const T &entity, bool customPK = false)
     {
         static_assert(std::is_base_of<QObject, T>::value, "Template type T must be derived QObject");
-        const QStringList &fieldNames { SqliteHelper::fieldNames<T>() };
-        Q_ASSERT(!fieldNames.isEmpty());
-
-        QString fmtFields;
-        QString fmtValues;
-
-        auto serializeValue = [&entity](const QString &field) -> QString {
-            QVariant &&variant { entity.property(field.toLocal8Bit().data()) };
-            QString &&typeStr { SqliteHelper::typeString(variant.type()) };
-            QString out;
-            if (typeStr.contains("TEXT")) {
-                SerializationHelper::serialize(&out, variant.toString());
-            } else {
-                SerializationHelper::serialize(&out, variant);
-            }
-            return out;
-        };
-
-        int startIndex { 1 };
-        if (customPK)
-            startIndex = 0;
-
-        for (int i = startIndex; i != fieldNames.size(); ++i) {
-            fmtFields += (fieldNames[i] + ",");
-            fmtValues += (serializeValue(fieldNames[i]) + ",");
-        }
-
-        if (fmtFields.endsWith(","))
-            fmtFields.chop(1);
-        if (fmtValues.endsWith(","))
-            fmtValues.chop(1);
-
-        Q_ASSERT(!fmtFields.isEmpty() && !fmtValues.isEmpty());
         int lastId { -1 };
-        if (!excute("INSERT INTO " + SqliteHelper::tableName<T>()
-                            + "(" + fmtFields + ") VALUES (" + fmtValues + ");",
-                    [&lastId](QSqlQuery *query) {
-                        Q_ASSERT(query);
-                        lastId = query->lastInsertId().toInt();
-                    }))
+        if (!insertEntities<T>({ &entity }, customPK, &lastId))
             return -1;
 
         return lastId;
     }
 
+    // Insert all entities with one prepared statement,
+    // call it inside transaction() to write them in one commit
+    template<typename T>
+    bool insertBatch(const QList<QSharedPointer<T>> &entities, bool customPK = false)
+    {
+        static_assert(std::is_base_of<QObject, T>::value, "Template type T must be derived QObject");
+        QList<const T *> rows;
+        rows.reserve(entities.size());
+        for (const auto &entity : entities)
+            rows.append(entity.data());
+
+        return insertEntities<T>(rows, customPK);
+    }
+
     // U: Update
     template<typename T>
     bool update(const Expression::SetExpr &setExpr, const Expression::Expr &whereExpr)
@@ -165,17 +144,120 @@ public:
                       + " WHERE " + whereExpr.toString() + ";");
     }
 
+    // U: Update in batch, each row binds the values of `setFields` followed by the values of `whereFields`
+    template<typename T>
+    bool updateBatch(const QStringList &setFields, const QStringList &whereFields, const QList<QVariantList> &rows)
+    {
+        static_assert(std::is_base_of<QObject, T>::value, "Template type T must be derived QObject");
+        Q_ASSERT(!setFields.isEmpty() && !whereFields.isEmpty());
+        return excuteBatch("UPDATE " + SqliteHelper::tableName<T>()
+                                   + " SET " + setFields.join("=?,") + "=?"
+                                   + " WHERE " + whereFields.join("=? AND ") + "=?;",
+                           rows);
+    }
+
+    // Delete in batch, each row binds the values of `whereFields`
+    template<typename T>
+    bool removeBatch(const QStringList &whereFields, const QList<QVariantList> &rows)
+    {
+        static_assert(std::is_base_of<QObject, T>::value, "Template type T must be derived QObject");
+        Q_ASSERT(!whereFields.isEmpty());
+        return excuteBatch("DELETE FROM " + SqliteHelper::tableName<T>()
+                                   + " WHERE " + whereFields.join("=? AND ") + "=?;",
+                           rows);
+    }
+
     inline bool excute(const QString &sql, std::function<void(QSqlQuery *)> fn = nullptr)
     {
         return SqliteHelper::excute(databaseName, sql, &lastExcutedSql, fn);
     }
 
+    // Prepare `sql` once and execute it for each row of bound values
+    inline bool excuteBatch(const QString &sql, const QList<QVariantList> &rows, std::function<void(QSqlQuery *)> fn = nullptr)
+    {
+        QSqlDatabase db { SqliteConnectionPool::instance().openConnection(databaseName) };
+        QSqlQuery query { db };
+        lastExcutedSql = sql;
+        if (!query.prepare(sql)) {
+            qCWarning(logDFMBase).noquote() << "SQL Error: " << query.lastError().text().trimmed();
+            return false;
+        }
+
+        for (const QVariantList &values : rows) {
+            for (int i = 0; i != values.size(); ++i)
+                query.bindValue(i, values.at(i));
+
+            if (!query.exec()) {
+                qCWarning(logDFMBase).noquote() << "SQL Error: " << query.lastError().text().trimmed();
+                return false;
+            }
+
+            if (fn)
+                fn(&query);
+        }
+
+        return true;
+    }
+
     inline QString lastQuery() const
     {
         return lastExcutedSql;
     }
 
 private:
+    struct InsertStatement
+    {
+        QString sql;
+        QList<QMetaProperty> properties;
+    };
+
+    // The statement and the properties to bind are reflected once per entity type
+    template<typename T>
+    static const InsertStatement &insertStatement(bool customPK)
+    {
+        static const auto build = [](bool withPK) {
+            const QStringList &fieldNames { SqliteHelper::fieldNames<T>() };
+            Q_ASSERT(!fieldNames.isEmpty());
+
+            InsertStatement statement;
+            QStringList fields;
+            for (int i = withPK ? 0 : 1; i < fieldNames.size(); ++i) {
+                fields.append(fieldNames[i]);
+                const int index { T::staticMetaObject.indexOfProperty(fieldNames[i].toLocal8Bit().data()) };
+                statement.properties.append(T::staticMetaObject.property(index));
+            }
+
+            QStringList placeholders;
+            std::fill_n(std::back_inserter(placeholders), fields.size(), QString("?"));
+            statement.sql = "INSERT INTO " + SqliteHelper::tableName<T>()
+                    + "(" + fields.join(",") + ") VALUES (" + placeholders.join(",") + ");";
+            return statement;
+        };
+        static const InsertStatement withPK { build(true) };
+        static const InsertStatement withoutPK { build(false) };
+        return customPK ? withPK : withoutPK;
+    }
+
+    template<typename T>
+    bool insertEntities(const QList<const T *> &entities, bool customPK, int *lastId = nullptr)
+    {
+        const InsertStatement &statement { insertStatement<T>(customPK) };
+        QList<QVariantList> rows;
+        rows.reserve(entities.size());
+        for (const T *entity : entities) {
+            QVariantList values;
+            values.reserve(statement.properties.size());
+            for (const QMetaProperty &property : statement.properties)
+                values.append(property.read(entity));
+            rows.append(std::move(values));
+        }
+
+        return excuteBatch(statement.sql, rows, [lastId](QSqlQuery *query) {
+            if (lastId)
+                *lastId = query->lastInsertId().toInt();
+        });
+    }
+
     QString databaseName;
     QString lastExcutedSql;
 };
@@ -13,6 +13,7 @@
 #include <dfm-base/utils/networkutils.h>
 #include <dfm-base/base/device/deviceproxymanager.h>
 #include <dfm-base/dbusservice/global_server_defines.h>
+#include "private/mounttable.h"
 
 #include <dfm-io/dfile.h>
 #include <dfm-burn/dburn_global.h>
@@ -22,9 +23,9 @@
 #include <QDebug>
 #include <QRegularExpressionMatch>
 #include <QMutex>
+#include <QHash>
 #include <QSettings>
 
-#include <libmount.h>
 #include <fstab.h>
 #include <sys/stat.h>
 
@@ -50,23 +51,13 @@ QString DeviceUtils::getMountInfo(const QString &in, bool lookForMpt)
 {
     if (in.isEmpty())
         return {};
-    libmnt_table *tab { mnt_new_table() };
-    if (!tab)
-        return {};
-    FinallyUtil finally { [tab]() { if (tab) mnt_free_table(tab); } };
-    if (mnt_table_parse_mtab(tab, nullptr) != 0) {
-        qCWarning(logDFMBase) << "Invalid mnt_table_parse_mtab call";
-        return {};
-    }
 
-    auto query = lookForMpt ? mnt_table_find_source : mnt_table_find_target;
-    auto get = lookForMpt ? mnt_fs_get_target : mnt_fs_get_source;
-    std::string stdPath { in.toStdString() };
-    auto fs = query(tab, stdPath.c_str(), MNT_ITER_BACKWARD);
-    if (fs)
-        return { get(fs) };
+    const MountEntry &entry = lookForMpt ? MountTable::instance().findBySource(in)
+                                         : MountTable::instance().findByTarget(in);
+    if (entry.isValid())
+        return lookForMpt ? entry.target : entry.source;
 
-    qCWarning(logDFMBase) << "Invalid libmnt_fs*";
+    qCDebug(logDFMBase) << "no mount info of" << in;
     return {};
 }
 
@@ -296,10 +287,8 @@ bool DeviceUtils::isMtpFile(const QUrl &url)
         return false;
 
     const QString &path = url.toLocalFile();
-    static const QString gvfsMatch { R"(^/run/user/\d+/gvfs/mtp:host|^/root/.gvfs/mtp:host)" };
-    QRegularExpression re { gvfsMatch };
-    QRegularExpressionMatch match { re.match(path) };
-    return match.hasMatch();
+    static const QRegularExpression re { R"(^/run/user/\d+/gvfs/mtp:host|^/root/.gvfs/mtp:host)" };
+    return re.match(path).hasMatch();
 }
 
 bool DeviceUtils::supportDfmioCopyDevice(const QUrl &url)
@@ -611,11 +600,9 @@ bool DeviceUtils::isLowSpeedDevice(const QUrl &url)
         return false;
 
     const QString &path = url.toLocalFile();
-    static const QString lowSpeedMountpoint { "(^/run/user/\\d+/gvfs/|^/root/.gvfs/|^/media/[\\s\\S]*/smbmounts)" };
     // TODO(xust) /media/$USER/smbmounts might be changed in the future.
-    QRegularExpression re { lowSpeedMountpoint };
-    QRegularExpressionMatch match { re.match(path) };
-    return match.hasMatch();
+    static const QRegularExpression re { "(^/run/user/\\d+/gvfs/|^/root/.gvfs/|^/media/[\\s\\S]*/smbmounts)" };
+    return re.match(path).hasMatch();
 }
 
 /*!
@@ -626,35 +613,10 @@ bool DeviceUtils::isLowSpeedDevice(const QUrl &url)
  */
 QString DeviceUtils::getLongestMountRootPath(const QString &filePath)
 {
-    libmnt_table *tab { mnt_new_table() };
-    libmnt_iter *iter { mnt_new_iter(MNT_ITER_BACKWARD) };
-
-    FinallyUtil release([&] {
-        if (tab) mnt_free_table(tab);
-        if (iter) mnt_free_iter(iter);
-    });
-
-    int ret = mnt_table_parse_mtab(tab, nullptr);
-    if (ret != 0)
+    const MountEntry &entry = MountTable::instance().mountOf(filePath);
+    if (!entry.isValid() || entry.target == "/")
         return "/";
-
-    QStringList mpts;
-    libmnt_fs *fs = nullptr;
-    while (mnt_table_next_fs(tab, iter, &fs) == 0) {
-        if (!fs)
-            continue;
-
-        const QString &target = mnt_fs_get_target(fs);
-        mpts.append(target == "/" ? "/" : target + "/");
-    }
-    std::sort(mpts.begin(), mpts.end(), [](const QString &a, const QString &b) { return a.length() > b.length(); });
-
-    QString path = filePath;
-    if (!path.endsWith("/"))
-        path.append("/");
-
-    auto found = std::find_if(mpts.cbegin(), mpts.cend(), [path](const QString &mpt) { return path.startsWith(mpt); });
-    return found != mpts.cend() ? *found : "/";
+    return entry.target + "/";
 }
 QString DeviceUtils::fileSystemType(const QUrl &url)
 {
@@ -766,34 +728,15 @@ bool DeviceUtils::isSiblingOfRoot(const QVariantMap &devInfo)
 bool DeviceUtils::findDlnfsPath(const QString &target, Compare func)
 {
     Q_ASSERT(func);
-    libmnt_table *tab { mnt_new_table() };
-    libmnt_iter *iter = mnt_new_iter(MNT_ITER_BACKWARD);
-
-    FinallyUtil finally([=] {
-        if (tab) mnt_free_table(tab);
-        if (iter) mnt_free_iter(iter);
-    });
-    Q_UNUSED(finally);
 
     auto unifyPath = [](const QString &path) {
         return path.endsWith("/") ? path : path + "/";
     };
 
-    int ret = mnt_table_parse_mtab(tab, nullptr);
-    if (ret != 0) {
-        qCWarning(logDFMBase) << "device: cannot parse mtab" << ret;
-        return false;
-    }
-
-    libmnt_fs *fs = nullptr;
-    while (mnt_table_next_fs(tab, iter, &fs) == 0) {
-        if (!fs)
-            continue;
-        if (strcmp("dlnfs", mnt_fs_get_source(fs)) == 0) {
-            QString mpt = unifyPath(mnt_fs_get_target(fs));
-            if (func(unifyPath(target), mpt))
-                return true;
-        }
+    const auto &mounts = MountTable::instance().entries();
+    for (auto iter = mounts.crbegin(); iter != mounts.crend(); ++iter) {
+        if (iter->source == "dlnfs" && func(unifyPath(target), unifyPath(iter->target)))
+            return true;
     }
 
     return false;
@@ -801,7 +744,10 @@ bool DeviceUtils::findDlnfsPath(const QString &target, Compare func)
 
 bool DeviceUtils::hasMatch(const QString &txt, const QString &rex)
 {
-    QRegularExpression re(rex);
-    QRegularExpressionMatch match = re.match(txt);
-    return match.hasMatch();
+    // callers pass a handful of constant patterns, keep them compiled per thread
+    thread_local QHash<QString, QRegularExpression> compiled;
+    auto iter = compiled.find(rex);
+    if (iter == compiled.end())
+        iter = compiled.insert(rex, QRegularExpression(rex));
+    return iter->match(txt).hasMatch();
 }
@@ -0,0 +1,177 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "mounttable.h"
+
+#include <dfm-base/utils/finallyutil.h>
+
+#include <QDir>
+#include <QFileInfo>
+#include <QDebug>
+
+#include <libmount.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+using namespace dfmbase;
+
+static constexpr char kMountInfoPath[] { "/proc/self/mountinfo" };
+
+MountTable &MountTable::instance()
+{
+    static MountTable ins;
+    return ins;
+}
+
+/*!
+ * \brief MountTable::findByTarget
+ * \param target: the mount point
+ * \return the last filesystem mounted on `target`, invalid if nothing is mounted there.
+ */
+MountEntry MountTable::findByTarget(const QString &target)
+{
+    ensureUpdated();
+
+    QReadLocker lk(&lock);
+    int idx = targetIndex.value(QDir::cleanPath(target), -1);
+    return idx >= 0 ? mounts.at(idx) : MountEntry();
+}
+
+/*!
+ * \brief MountTable::findBySource
+ * \param source: the mount source, /dev/sda1 e.g. symlinks like /dev/disk/by-uuid/xxx are resolved.
+ * \return the last mount of `source`, invalid if it is not mounted.
+ */
+MountEntry MountTable::findBySource(const QString &source)
+{
+    ensureUpdated();
+
+    QReadLocker lk(&lock);
+    int idx = sourceIndex.value(source, -1);
+    if (idx < 0 && source.startsWith("/")) {
+        const QString &canonical = QFileInfo(source).canonicalFilePath();
+        if (!canonical.isEmpty())
+            idx = sourceIndex.value(canonical, -1);
+    }
+    return idx >= 0 ? mounts.at(idx) : MountEntry();
+}
+
+/*!
+ * \brief MountTable::mountOf: the deepest mount that contains `path`
+ * walks up the ancestors of `path`, so a lookup costs one hash lookup per path level.
+ */
+MountEntry MountTable::mountOf(const QString &path)
+{
+    ensureUpdated();
+
+    QString dir = QDir::cleanPath(path);
+    QReadLocker lk(&lock);
+    while (!dir.isEmpty()) {
+        int idx = targetIndex.value(dir, -1);
+        if (idx >= 0)
+            return mounts.at(idx);
+        if (dir == "/")
+            break;
+
+        int pos = dir.lastIndexOf('/');
+        dir = pos > 0 ? dir.left(pos) : (pos == 0 ? QString("/") : QString());
+    }
+    return {};
+}
+
+QList<MountEntry> MountTable::entries()
+{
+    ensureUpdated();
+
+    QReadLocker lk(&lock);
+    return mounts;
+}
+
+/*!
+ * \brief MountTable::invalidate: force the next lookup to parse mtab again
+ */
+void MountTable::invalidate()
+{
+    dirty = true;
+}
+
+MountTable::MountTable()
+{
+    // the kernel flags the file with POLLPRI | POLLERR each time the mount namespace changes
+    monitorFd = ::open(kMountInfoPath, O_RDONLY | O_CLOEXEC);
+    if (monitorFd < 0)
+        qCWarning(logDFMBase) << "device: cannot watch" << kMountInfoPath << ", mtab is parsed on every lookup";
+}
+
+MountTable::~MountTable()
+{
+    if (monitorFd >= 0)
+        ::close(monitorFd);
+}
+
+void MountTable::ensureUpdated()
+{
+    if (mountsChanged())
+        dirty = true;
+
+    if (!dirty)
+        return;
+
+    QWriteLocker lk(&lock);
+    if (!dirty.exchange(false))
+        return;
+    reload();
+}
+
+bool MountTable::mountsChanged() const
+{
+    if (monitorFd < 0)
+        return true;
+
+    struct pollfd fds { monitorFd, POLLPRI, 0 };
+    if (::poll(&fds, 1, 0) <= 0)
+        return false;
+    return fds.revents & (POLLPRI | POLLERR);
+}
+
+void MountTable::reload()
+{
+    mounts.clear();
+    targetIndex.clear();
+    sourceIndex.clear();
+
+    libmnt_table *tab { mnt_new_table() };
+    libmnt_iter *iter { mnt_new_iter(MNT_ITER_FORWARD) };
+    FinallyUtil release([&] {
+        if (tab) mnt_free_table(tab);
+        if (iter) mnt_free_iter(iter);
+    });
+
+    if (!tab || !iter)
+        return;
+
+    int ret = mnt_table_parse_mtab(tab, nullptr);
+    if (ret != 0) {
+        qCWarning(logDFMBase) << "device: cannot parse mtab" << ret;
+        return;
+    }
+
+    // iterate forward so that the latest mount over the same target or source wins
+    libmnt_fs *fs = nullptr;
+    while (mnt_table_next_fs(tab, iter, &fs) == 0) {
+        if (!fs || !mnt_fs_get_target(fs))
+            continue;
+
+        MountEntry entry;
+        entry.target = QDir::cleanPath(mnt_fs_get_target(fs));
+        entry.source = mnt_fs_get_source(fs);
+        entry.fsType = mnt_fs_get_fstype(fs);
+
+        targetIndex.insert(entry.target, mounts.count());
+        if (!entry.source.isEmpty())
+            sourceIndex.insert(entry.source, mounts.count());
+        mounts.append(entry);
+    }
+}
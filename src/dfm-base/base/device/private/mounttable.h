@@ -0,0 +1,64 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef MOUNTTABLE_H
+#define MOUNTTABLE_H
+
+#include <dfm-base/dfm_base_global.h>
+
+#include <QHash>
+#include <QList>
+#include <QReadWriteLock>
+
+#include <atomic>
+
+namespace dfmbase {
+
+struct MountEntry
+{
+    QString source;
+    QString target;
+    QString fsType;
+
+    bool isValid() const { return !target.isEmpty(); }
+};
+
+/*!
+ * \brief The MountTable class
+ * a process-wide index of the mount table. mtab is parsed only when /proc/self/mountinfo
+ * reports a change, lookups by mount point or by path are hash lookups.
+ */
+class MountTable
+{
+    Q_DISABLE_COPY(MountTable)
+
+public:
+    static MountTable &instance();
+
+    MountEntry findByTarget(const QString &target);
+    MountEntry findBySource(const QString &source);
+    MountEntry mountOf(const QString &path);
+    QList<MountEntry> entries();
+    void invalidate();
+
+private:
+    MountTable();
+    ~MountTable();
+
+    void ensureUpdated();
+    bool mountsChanged() const;
+    void reload();
+
+private:
+    QReadWriteLock lock;
+    QList<MountEntry> mounts;
+    QHash<QString, int> targetIndex;
+    QHash<QString, int> sourceIndex;
+    int monitorFd { -1 };
+    std::atomic_bool dirty { true };
+};
+
+}
+
+#endif   // MOUNTTABLE_H
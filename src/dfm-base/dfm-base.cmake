@@ -8,6 +8,8 @@ find_package(PkgConfig REQUIRED)
 pkg_check_modules(gio REQUIRED gio-unix-2.0 IMPORTED_TARGET)
 pkg_check_modules(mount REQUIRED mount IMPORTED_TARGET)
 pkg_check_modules(PC_XCB REQUIRED xcb)
+# decode video thumbnails in process, otherwise the ffmpeg tool is started per file
+pkg_check_modules(libav IMPORTED_TARGET libavformat libavcodec libswscale libavutil)
 
 set(XCB_INCLUDE_DIRS ${PC_XCB_INCLUDE_DIRS})
 set(XCB_LIBRARIES ${PC_XCB_LIBRARIES})
@@ -125,6 +127,11 @@ target_compile_definitions(
         PRIVATE DFM_BASE_INTERNAL_USE=1
 )
 
+if(libav_FOUND)
+    target_link_libraries(${BIN_NAME} PRIVATE PkgConfig::libav)
+    target_compile_definitions(${BIN_NAME} PRIVATE DFM_THUMBNAIL_LIBAV)
+endif()
+
 add_library(DFM${DTK_VERSION_MAJOR}::base ALIAS ${BIN_NAME})
 
 set_target_properties(${BIN_NAME} PROPERTIES
@@ -236,8 +236,11 @@ QList<SortInfoPointer> LocalDirIterator::sortFileInfoList()
 
     auto sortlist = d->dfmioDirIterator->sortFileInfoList();
     QList<SortInfoPointer> wsortlist;
-    for (const auto &sortInfo : sortlist) {
-        SortInfoPointer tmp(new SortFileInfo);
+    wsortlist.reserve(sortlist.count());
+    // take the dfm-io infos one by one, so both lists are not fully alive at the same time
+    while (!sortlist.isEmpty()) {
+        const auto &sortInfo = sortlist.takeFirst();
+        auto tmp = SortInfoPointer::create();
         tmp->setUrl(sortInfo->url);
         tmp->setSize(sortInfo->filesize);
         tmp->setFile(sortInfo->isFile);
@@ -7,26 +7,49 @@
 
 #include <dfm-base/interfaces/sortfileinfo.h>
 
-#include <QPointer>
+#include <QMutex>
+
+#include <atomic>
 
 namespace dfmbase {
+// a directory can hold millions of entries, every one of them owns a SortFileInfoPrivate,
+// so it keeps only the url, the size and one flag word, the deferred stat shares striped locks
 class SortFileInfoPrivate
 {
 public:
-    explicit SortFileInfoPrivate(SortFileInfo *qq);
+    enum InfoFlag : quint16 {
+        kFile = 0x0001,
+        kDir = 0x0002,
+        kSymLink = 0x0004,
+        kHide = 0x0008,
+        kReadable = 0x0010,
+        kWriteable = 0x0020,
+        kExecutable = 0x0040,
+        kStatLater = 0x0080,   // size and permissions are read on first use
+    };
+
+    SortFileInfoPrivate();
     ~SortFileInfoPrivate();
 
+    inline bool testFlag(const InfoFlag flag, std::memory_order order = std::memory_order_relaxed) const
+    {
+        return flags.load(order) & flag;
+    }
+    inline void setFlag(const InfoFlag flag, const bool on, std::memory_order order = std::memory_order_relaxed)
+    {
+        if (on)
+            flags.fetch_or(flag, order);
+        else
+            flags.fetch_and(static_cast<quint16>(~flag), order);
+    }
+
+    QMutex *lock() const;
+    void loadStat();
+
 public:
-    SortFileInfo *const q;   // SortFileInfo实例对象
     QUrl url;
     qint64 filesize { 0 };
-    bool file { false };
-    bool dir { false };
-    bool symLink { false };
-    bool hide { false };
-    bool readable { false };
-    bool writeable { false };
-    bool executable { false };
+    std::atomic<quint16> flags { 0 };
 };
 
 }
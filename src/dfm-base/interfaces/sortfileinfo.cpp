@@ -4,9 +4,17 @@
 
 #include <dfm-base/interfaces/private/sortfileinfo_p.h>
 
+#include <QFile>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
 namespace dfmbase {
+// the lazy members are rarely built concurrently, a few shared locks serve all infos
+static constexpr int kLockStripeCount { 64 };
+
 SortFileInfo::SortFileInfo()
-    : d(new SortFileInfoPrivate(this))
+    : d(new SortFileInfoPrivate)
 {
 }
 
@@ -26,37 +34,47 @@ void SortFileInfo::setSize(const qint64 size)
 
 void SortFileInfo::setFile(const bool isfile)
 {
-    d->file = isfile;
+    d->setFlag(SortFileInfoPrivate::kFile, isfile);
 }
 
 void SortFileInfo::setDir(const bool isdir)
 {
-    d->dir = isdir;
+    d->setFlag(SortFileInfoPrivate::kDir, isdir);
 }
 
 void SortFileInfo::setSymlink(const bool isSymlink)
 {
-    d->symLink = isSymlink;
+    d->setFlag(SortFileInfoPrivate::kSymLink, isSymlink);
 }
 
 void SortFileInfo::setHide(const bool ishide)
 {
-    d->hide = ishide;
+    d->setFlag(SortFileInfoPrivate::kHide, ishide);
 }
 
 void SortFileInfo::setReadable(const bool readable)
 {
-    d->readable = readable;
+    d->setFlag(SortFileInfoPrivate::kReadable, readable);
 }
 
 void SortFileInfo::setWriteable(const bool writeable)
 {
-    d->writeable = writeable;
+    d->setFlag(SortFileInfoPrivate::kWriteable, writeable);
 }
 
 void SortFileInfo::setExecutable(const bool executable)
 {
-    d->executable = executable;
+    d->setFlag(SortFileInfoPrivate::kExecutable, executable);
+}
+
+/*!
+ * \brief SortFileInfo::setStatLater Defer reading size and permissions to their first use
+ * Enumerations that only learn the name and type of an entry set this, the file is stated
+ * once one of fileSize, isReadable, isWriteable or isExecutable is asked for.
+ */
+void SortFileInfo::setStatLater(const bool later)
+{
+    d->setFlag(SortFileInfoPrivate::kStatLater, later, std::memory_order_release);
 }
 
 QUrl SortFileInfo::fileUrl() const
@@ -66,46 +84,58 @@ QUrl SortFileInfo::fileUrl() const
 
 qint64 SortFileInfo::fileSize() const
 {
+    if (d->testFlag(SortFileInfoPrivate::kStatLater, std::memory_order_acquire))
+        d->loadStat();
     return d->filesize;
 }
 
 bool SortFileInfo::isFile() const
 {
-    return d->file;
+    return d->testFlag(SortFileInfoPrivate::kFile);
 }
 
 bool SortFileInfo::isDir() const
 {
-    return d->dir;
+    return d->testFlag(SortFileInfoPrivate::kDir);
 }
 
 bool SortFileInfo::isSymLink() const
 {
-    return d->symLink;
+    return d->testFlag(SortFileInfoPrivate::kSymLink);
 }
 
 bool SortFileInfo::isHide() const
 {
-    return d->hide;
+    return d->testFlag(SortFileInfoPrivate::kHide);
 }
 
 bool SortFileInfo::isReadable() const
 {
-    return d->readable;
+    if (d->testFlag(SortFileInfoPrivate::kStatLater, std::memory_order_acquire))
+        d->loadStat();
+    return d->testFlag(SortFileInfoPrivate::kReadable);
 }
 
 bool SortFileInfo::isWriteable() const
 {
-    return d->writeable;
+    if (d->testFlag(SortFileInfoPrivate::kStatLater, std::memory_order_acquire))
+        d->loadStat();
+    return d->testFlag(SortFileInfoPrivate::kWriteable);
 }
 
 bool SortFileInfo::isExecutable() const
 {
-    return d->executable;
+    if (d->testFlag(SortFileInfoPrivate::kStatLater, std::memory_order_acquire))
+        d->loadStat();
+    return d->testFlag(SortFileInfoPrivate::kExecutable);
 }
 
-SortFileInfoPrivate::SortFileInfoPrivate(SortFileInfo *qq)
-    : q(qq)
+bool SortFileInfo::isStatLater() const
+{
+    return d->testFlag(SortFileInfoPrivate::kStatLater, std::memory_order_acquire);
+}
+
+SortFileInfoPrivate::SortFileInfoPrivate()
 {
 }
 
@@ -113,4 +143,43 @@ SortFileInfoPrivate::~SortFileInfoPrivate()
 {
 }
 
+QMutex *SortFileInfoPrivate::lock() const
+{
+    static QMutex locks[kLockStripeCount];
+    return &locks[(reinterpret_cast<quintptr>(this) / sizeof(SortFileInfoPrivate)) % kLockStripeCount];
+}
+
+/*!
+ * \brief SortFileInfoPrivate::loadStat Read the deferred size and permissions
+ * The file is stated without the lock, a slow file system must not block the other infos
+ * sharing the stripe. Concurrent callers may stat twice, only the first result is kept.
+ */
+void SortFileInfoPrivate::loadStat()
+{
+    QUrl fileUrl;
+    {
+        QMutexLocker lk(lock());
+        if (!testFlag(kStatLater))
+            return;
+        fileUrl = url;
+    }
+
+    const QByteArray &path = QFile::encodeName(fileUrl.path());
+    struct stat st;
+    const bool stated = ::stat(path.constData(), &st) == 0;
+    const bool readable = ::access(path.constData(), R_OK) == 0;
+    const bool writeable = ::access(path.constData(), W_OK) == 0;
+    const bool executable = ::access(path.constData(), X_OK) == 0;
+
+    QMutexLocker lk(lock());
+    if (!testFlag(kStatLater) || url != fileUrl)
+        return;
+    if (stated)
+        filesize = st.st_size;
+    setFlag(kReadable, readable);
+    setFlag(kWriteable, writeable);
+    setFlag(kExecutable, executable);
+    setFlag(kStatLater, false, std::memory_order_release);
+}
+
 }
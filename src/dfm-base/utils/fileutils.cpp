@@ -11,6 +11,7 @@
 #include <dfm-base/utils/dialogmanager.h>
 #include <dfm-base/base/urlroute.h>
 #include <dfm-base/utils/finallyutil.h>
+#include <dfm-base/utils/chinese2pinyin.h>
 #include <dfm-base/base/device/deviceutils.h>
 #include <dfm-base/base/device/deviceproxymanager.h>
 #include <dfm-base/base/schemefactory.h>
@@ -166,11 +167,9 @@ bool FileUtils::isGvfsFile(const QUrl &url)
         return false;
 
     const QString &path = url.toLocalFile();
-    static const QString gvfsMatch { "(^/run/user/\\d+/gvfs/|^/root/.gvfs/|^/media/[\\s\\S]*/smbmounts)" };
     // TODO(xust) /media/$USER/smbmounts might be changed in the future.
-    QRegularExpression re { gvfsMatch };
-    QRegularExpressionMatch match { re.match(path) };
-    return match.hasMatch();
+    static const QRegularExpression re { "(^/run/user/\\d+/gvfs/|^/root/.gvfs/|^/media/[\\s\\S]*/smbmounts)" };
+    return re.match(path).hasMatch();
 }
 
 bool FileUtils::isMtpFile(const QUrl &url)
@@ -1187,6 +1186,73 @@ bool FileUtils::compareString(const QString &str1, const QString &str2, Qt::Sort
     return !((order == Qt::AscendingOrder) ^ compareByStringEx(str1, str2));
 }
 
+static void appendUtf16(QByteArray &key, const QChar ch)
+{
+    key.append(static_cast<char>(ch.unicode() >> 8));
+    key.append(static_cast<char>(ch.unicode() & 0xff));
+}
+
+/*!
+ * \brief FileUtils::collationKey Build a binary key of the name for sorting
+ * Comparing two keys bytewise gives the order of compareByStringEx: digit runs by value,
+ * then letters case insensitive, then chinese characters by pinyin, then other symbols,
+ * a shorter base name first and the suffix last. Names differing only in case or in leading
+ * zeros get equal keys, callers break such ties by comparing the names.
+ * \param name file name
+ * \return key, compare with memcmp or QByteArray::operator<
+ */
+QByteArray FileUtils::collationKey(const QString &name)
+{
+    enum KeyClass : char {
+        kKeyEnd = 0x00,
+        kKeyNumber = 0x10,
+        kKeyLetter = 0x20,
+        kKeyHanzi = 0x30,
+        kKeySymbol = 0x40,
+    };
+
+    const int dotPos = name.lastIndexOf(".");
+    const QString &baseName = name.left(dotPos);
+    const QString &suffix = name.mid(dotPos + 1);
+
+    QByteArray key;
+    key.reserve(name.length() * 3 + 4);
+
+    for (int i = 0; i < baseName.length(); ++i) {
+        const QChar ch = baseName.at(i);
+        if (isNumber(ch)) {
+            int end = i;
+            while (end < baseName.length() && isNumber(baseName.at(end)))
+                ++end;
+            int start = i;
+            while (start < end - 1 && baseName.at(start) == QChar('0'))
+                ++start;
+            // more digits is a bigger value, equal digit counts compare digit by digit
+            key.append(kKeyNumber);
+            key.append(static_cast<char>(qMin(end - start, 0xff)));
+            key.append(baseName.mid(start, end - start).toLatin1());
+            i = end - 1;
+        } else if (isNumOrChar(ch)) {
+            key.append(kKeyLetter);
+            key.append(static_cast<char>(ch.toLower().unicode()));
+        } else if (ch.script() == QChar::Script_Han) {
+            key.append(kKeyHanzi);
+            key.append(Pinyin::Chinese2Pinyin(ch).toLatin1());
+            key.append(kKeyEnd);
+            appendUtf16(key, ch);
+        } else {
+            key.append(kKeySymbol);
+            appendUtf16(key, ch);
+        }
+    }
+    key.append(kKeyEnd);
+
+    for (const QChar ch : suffix)
+        appendUtf16(key, ch);
+
+    return key;
+}
+
 QString FileUtils::encryptString(const QString &str)
 {
     QByteArray byteArray = str.toUtf8();
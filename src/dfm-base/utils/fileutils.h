@@ -79,6 +79,7 @@ public:
     static bool compareByStringEx(const QString &str1, const QString &str2);
     static QString numberStr(const QString &str, int pos);
     static bool compareString(const QString &str1, const QString &str2, Qt::SortOrder order);
+    static QByteArray collationKey(const QString &name);
 
     static QString encryptString(const QString &str);
     static QString decryptString(const QString &str);
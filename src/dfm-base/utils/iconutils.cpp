@@ -7,6 +7,7 @@
 #include <QGraphicsDropShadowEffect>
 #include <QGraphicsScene>
 #include <QGraphicsPixmapItem>
+#include <QPixmapCache>
 
 DFMBASE_USE_NAMESPACE
 
@@ -54,6 +55,41 @@ QPixmap IconUtils::addShadowToPixmap(const QPixmap &originalPixmap, int shadowOf
     return resultPixmap;
 }
 
+static QString shadowedBackgroundKey(qreal width, qreal height, const IconUtils::IconStyle &style, qreal shadowOpacity)
+{
+    return QString("dfm_icon_background_%1x%2_%3_%4_%5_%6_%7")
+            .arg(width)
+            .arg(height)
+            .arg(style.stroke)
+            .arg(style.radius)
+            .arg(style.shadowOffset)
+            .arg(style.shadowRange)
+            .arg(shadowOpacity);
+}
+
+/*!
+ * \brief IconUtils::renderShadowedIconBackground 带阴影的缩略图背景
+ * 阴影模糊开销较大，同一尺寸和样式的背景只渲染一次，结果保存在 QPixmapCache 中，
+ * 缩放后尺寸变化会使用新的缓存项，旧的缓存项由 QPixmapCache 按最近最少使用淘汰。
+ * 只能在 GUI 线程中调用。
+ */
+QPixmap IconUtils::renderShadowedIconBackground(const QSize &size, const IconStyle &style, qreal shadowOpacity)
+{
+    return renderShadowedIconBackground(QSizeF(size), style, shadowOpacity);
+}
+
+QPixmap IconUtils::renderShadowedIconBackground(const QSizeF &size, const IconStyle &style, qreal shadowOpacity)
+{
+    const QString &key = shadowedBackgroundKey(size.width(), size.height(), style, shadowOpacity);
+    QPixmap pixmap;
+    if (QPixmapCache::find(key, &pixmap))
+        return pixmap;
+
+    pixmap = addShadowToPixmap(renderIconBackground(size, style), style.shadowOffset, style.shadowRange, shadowOpacity);
+    QPixmapCache::insert(key, pixmap);
+    return pixmap;
+}
+
 IconUtils::IconStyle IconUtils::getIconStyle(int size)
 {
     IconStyle style;
@@ -22,6 +22,8 @@ struct IconStyle
 QPixmap renderIconBackground(const QSize &size, const IconStyle &style = IconStyle {});
 QPixmap renderIconBackground(const QSizeF &size, const IconStyle &style = IconStyle {});
 QPixmap addShadowToPixmap(const QPixmap &originalPixmap, int shadowOffsetY, qreal blurRadius, qreal shadowOpacity);
+QPixmap renderShadowedIconBackground(const QSize &size, const IconStyle &style, qreal shadowOpacity);
+QPixmap renderShadowedIconBackground(const QSizeF &size, const IconStyle &style, qreal shadowOpacity);
 IconStyle getIconStyle(int size);
 }   // end namespace IconUtils
 
@@ -9,8 +9,10 @@
 
 #include <QtConcurrent>
 
-// cache file total count
-static constexpr int kCacheFileinfoCount = 20000;
+// cache file total bytes, counted by kCacheFileinfoBaseBytes plus the url path of every info
+static constexpr qint64 kCacheFileinfoBytes = (96 * 1024 * 1024);
+// estimated memory of one file info with its dfm-io info and attributes
+static constexpr qint64 kCacheFileinfoBaseBytes = 3 * 1024;
 // cache file watcher total count
 static constexpr int kCacheFileWatcherCount = 5000;
 // rotation training time
@@ -27,6 +29,60 @@ InfoCachePrivate::InfoCachePrivate(InfoCache *qq)
 InfoCachePrivate::~InfoCachePrivate()
 {
     cacheWorkerStoped = true;
+    for (auto &shard : shards) {
+        QMutexLocker lk(&shard.mutex);
+        qDeleteAll(shard.nodes);
+        shard.nodes.clear();
+        shard.head = shard.tail = nullptr;
+    }
+}
+
+InfoCacheShard &InfoCachePrivate::shard(const QUrl &url)
+{
+    return shards[qHash(url) % kInfoCacheShardCount];
+}
+
+void InfoCacheShard::unlink(InfoCacheNode *node)
+{
+    if (node->prev)
+        node->prev->next = node->next;
+    else
+        head = node->next;
+    if (node->next)
+        node->next->prev = node->prev;
+    else
+        tail = node->prev;
+    node->prev = node->next = nullptr;
+}
+
+void InfoCacheShard::pushFront(InfoCacheNode *node)
+{
+    node->prev = nullptr;
+    node->next = head;
+    if (head)
+        head->prev = node;
+    head = node;
+    if (!tail)
+        tail = node;
+}
+
+void InfoCacheShard::touch(InfoCacheNode *node, const qint64 time)
+{
+    node->touchTime = time;
+    if (head == node)
+        return;
+    unlink(node);
+    pushFront(node);
+}
+
+FileInfoPointer InfoCacheShard::take(InfoCacheNode *node)
+{
+    unlink(node);
+    nodes.remove(node->url);
+    bytes -= node->bytes;
+    FileInfoPointer info = node->info;
+    delete node;
+    return info;
 }
 
 InfoCache::InfoCache(QObject *parent)
@@ -135,14 +191,9 @@ void InfoCache::cacheInfo(const QUrl url, const FileInfoPointer info)
         return;
 
     {
-        QReadLocker rlk(&d->mianLock);
-        if (d->mainCache.contains(url))
-            return;
-    }
-
-    {
-        QReadLocker rlk(&d->copyLock);
-        if (d->copyCache.contains(url))
+        auto &shard = d->shard(url);
+        QMutexLocker lk(&shard.mutex);
+        if (shard.nodes.contains(url))
             return;
     }
 
@@ -170,41 +221,44 @@ void InfoCache::cacheInfo(const QUrl url, const FileInfoPointer info)
         }
     }
 
-    // 插入到主和副的所有缓存中
-    d->status = kCacheCopy;
+    // 插入到分片的链表头，分片超出预算时从链表尾淘汰
+    QMap<QUrl, FileInfoPointer> evicted;
     {
-        QWriteLocker wlk(&d->mianLock);
-        d->mainCache.insert(url, info);
-    }
-    d->status = kCacheMain;
-    {
-        QWriteLocker wlk(&d->copyLock);
-        d->copyCache.insert(url, info);
+        auto &shard = d->shard(url);
+        QMutexLocker lk(&shard.mutex);
+        if (shard.nodes.contains(url))
+            return;
+        auto node = new InfoCacheNode;
+        node->url = url;
+        node->info = info;
+        node->bytes = kCacheFileinfoBaseBytes + url.path().size() * static_cast<qint64>(sizeof(QChar));
+        node->touchTime = QDateTime::currentMSecsSinceEpoch();
+        shard.nodes.insert(url, node);
+        shard.pushFront(node);
+        shard.bytes += node->bytes;
+        evictOverBudget(shard, &evicted);
     }
-    // 使用线程处理加入时间序列问题
-    emit cacheUpdateInfoTime(url);
+
+    if (!evicted.isEmpty())
+        emit cacheDisconnectWatcher(evicted);
 }
+
 /*!
- * \brief insertSortTime 处理当前文件的移除时间
- *
- * \param qint64 文件info的当前时间
+ * \brief evictOverBudget 淘汰分片中最久未使用的info，直到分片不超出预算，调用时持有分片的锁
  *
- * \param QString 文件的url
+ * \param InfoCacheShard 分片
  *
- * \return
+ * \param QMap 淘汰的info，需要断开监视器
  */
-bool InfoCache::updateSortTimeWorker(const QUrl url)
-{
-    Q_D(InfoCache);
-    if (d->cacheWorkerStoped)
-        return false;
-    auto time = QDateTime::currentMSecsSinceEpoch();
-    auto key = QString::number(time) + QString("-") + url.toString();
-    if (d->urlTimeSortHash.contains(url))
-        d->timeToUrlMap.remove(d->urlTimeSortHash.value(url));
-    d->timeToUrlMap.insert(key, url);
-    d->urlTimeSortHash.insert(url, key);
-    return d->timeToUrlMap.count() > kCacheFileinfoCount;
+void InfoCache::evictOverBudget(InfoCacheShard &shard, QMap<QUrl, FileInfoPointer> *evicted)
+{
+    static constexpr qint64 kShardBytes = kCacheFileinfoBytes / kInfoCacheShardCount;
+    // 刚插入的在链表头，至少保留它
+    while (shard.bytes > kShardBytes && shard.tail && shard.tail != shard.head) {
+        const QUrl url = shard.tail->url;
+        evicted->insert(url, shard.take(shard.tail));
+        d->evictionCount.fetchAndAddRelaxed(1);
+    }
 }
 
 void InfoCache::stop()
@@ -227,31 +281,19 @@ void InfoCache::removeCaches(const QList<QUrl> urls)
     if (d->cacheWorkerStoped || urls.size() <= 0)
         return;
 
-    // 读取主缓存，插入到
-    d->status = kCacheCopy;
     QMap<QUrl, FileInfoPointer> infos;
-    {
-        QWriteLocker wlk(&d->mianLock);
-        for (const auto &url : urls) {
-            auto info = d->mainCache.take(url);
-            if (info)
-                infos.insert(url, d->mainCache.take(url));
-        }
+    for (const auto &url : urls) {
+        auto &shard = d->shard(url);
+        QMutexLocker lk(&shard.mutex);
+        auto node = shard.nodes.value(url);
+        if (node)
+            infos.insert(url, shard.take(node));
     }
     if (d->cacheWorkerStoped)
         return;
     // 断开监视器监视
     if (infos.size() > 0)
         emit cacheDisconnectWatcher(infos);
-
-    // 设置读取主缓存和插入到主缓存中
-    d->status = kCacheMain;
-    {
-        QWriteLocker wlk(&d->copyLock);
-        for (const auto &url : urls) {
-            d->copyCache.remove(url);
-        }
-    }
 }
 /*!
  * \brief getCacheInfo 获取文件
@@ -263,23 +305,35 @@ void InfoCache::removeCaches(const QList<QUrl> urls)
 FileInfoPointer InfoCache::getCacheInfo(const QUrl &url)
 {
     Q_D(InfoCache);
-    // 要异步线程重置计时器 todo 开辟一个可控制的线程来处理时间排序的问题
-    // 读取副缓存和临时缓存返回
-    FileInfoPointer info(nullptr);
-    if (d->status == kCacheMain) {   // 可以读取主缓存返回
-        QReadLocker wlk(&d->mianLock);
-        info = d->mainCache.value(url);
-    } else {
-        QReadLocker wlk(&d->copyLock);
-        info = d->copyCache.value(url);
+    // 命中时移到链表头，O(1)
+    auto &shard = d->shard(url);
+    QMutexLocker lk(&shard.mutex);
+    auto node = shard.nodes.value(url);
+    if (!node) {
+        d->missCount.fetchAndAddRelaxed(1);
+        return nullptr;
     }
-    // 异步线程或者信号更新时间
-    // 使用线程处理加入时间序列问题
-    if (info)
-        emit cacheUpdateInfoTime(url);
 
-    return info;
+    d->hitCount.fetchAndAddRelaxed(1);
+    shard.touch(node, QDateTime::currentMSecsSinceEpoch());
+    return node->info;
+}
+
+InfoCacheStatistics InfoCache::statistics()
+{
+    Q_D(InfoCache);
+    InfoCacheStatistics stat;
+    stat.hits = d->hitCount.loadRelaxed();
+    stat.misses = d->missCount.loadRelaxed();
+    stat.evictions = d->evictionCount.loadRelaxed();
+    for (auto &shard : d->shards) {
+        QMutexLocker lk(&shard.mutex);
+        stat.bytes += shard.bytes;
+        stat.count += shard.nodes.count();
+    }
+    return stat;
 }
+
 /*!
  * \brief refreshFileInfo 刷新缓存fileinfo
  *
@@ -344,41 +398,26 @@ void InfoCache::removeWatcherTimeInfo(const QList<QUrl> &urls)
 void InfoCache::timeRemoveCache()
 {
     Q_D(InfoCache);
-    // 取出哪些url的时间超出了u
-    qint64 delCount = d->urlTimeSortHash.size() < kCacheFileinfoCount ? 0 : d->urlTimeSortHash.size() - kCacheFileinfoCount;
-    QList<QUrl> delList;
-    foreach (const auto time, d->timeToUrlMap.keys()) {
+    // 链表尾是最久未使用的，从尾部移除超时的info
+    const qint64 expireTime = QDateTime::currentMSecsSinceEpoch() - kCacheRemoveTime;
+    QMap<QUrl, FileInfoPointer> delInfos;
+    for (auto &shard : d->shards) {
         if (d->cacheWorkerStoped)
             return;
 
-        if (time < QString::number(QDateTime::currentDateTime().toMSecsSinceEpoch() - kCacheRemoveTime)) {
-            delList.append(d->timeToUrlMap.value(time));
-            continue;
-        }
-
-        if (delList.size() >= delCount) {
-            break;
-        }
-
-        delList.append(d->timeToUrlMap.value(time));
-    }
-    for (auto url : delList) {
-        if (d->urlTimeSortHash.contains(url)) {
-            d->timeToUrlMap.remove(d->urlTimeSortHash.take(url));
+        QMutexLocker lk(&shard.mutex);
+        while (shard.tail && shard.tail->touchTime < expireTime) {
+            const QUrl url = shard.tail->url;
+            delInfos.insert(url, shard.take(shard.tail));
         }
     }
-    // 发送异步消息 告诉移除线程创建移除线程移除，考虑是否是使用线程一直还是使用临时线程（使用临时线程）
-    if (delList.size() > 0 && !d->cacheWorkerStoped)
-        emit cacheRemoveCaches(delList);
-}
 
-void InfoCache::removeInfosTimeWorker(const QList<QUrl> urls)
-{
-    for (auto url : urls) {
-        if (d->urlTimeSortHash.contains(url)) {
-            d->timeToUrlMap.remove(d->urlTimeSortHash.take(url));
-        }
-    }
+    const auto &stat = statistics();
+    qCDebug(logDFMBase) << "info cache count:" << stat.count << "bytes:" << stat.bytes << "hits:" << stat.hits
+                        << "misses:" << stat.misses << "evictions:" << stat.evictions << "expired:" << delInfos.size();
+
+    if (delInfos.size() > 0 && !d->cacheWorkerStoped)
+        emit cacheDisconnectWatcher(delInfos);
 }
 
 void InfoCache::updateSortTimeWatcherWorker(const QList<QUrl> &urls, const bool add)
@@ -389,7 +428,7 @@ void InfoCache::updateSortTimeWatcherWorker(const QList<QUrl> &urls, const bool
     if (add)
         return addWatcherTimeInfo(urls);
 
-    removeInfosTimeWorker(urls);
+    removeWatcherTimeInfo(urls);
 }
 
 void InfoCache::fileAttributeChanged(const QUrl url)
@@ -455,6 +494,11 @@ FileInfoPointer InfoCacheController::getCacheInfo(const QUrl &url)
     return InfoCache::instance().getCacheInfo(url);
 }
 
+InfoCacheStatistics InfoCacheController::statistics()
+{
+    return InfoCache::instance().statistics();
+}
+
 InfoCacheController::InfoCacheController(QObject *parent)
     : QObject(parent), thread(new QThread), worker(new CacheWorker), removeTimer(new QTimer)
     , threadUpdate(new QThread)
@@ -468,8 +512,6 @@ void InfoCacheController::init()
     removeTimer->moveToThread(qApp->thread());
     connect(removeTimer.data(), &QTimer::timeout, workerUpdate.data(),
             &TimeToUpdateCache::dealRemoveInfo, Qt::QueuedConnection);
-    connect(&InfoCache::instance(), &InfoCache::cacheUpdateInfoTime, workerUpdate.data(),
-            &TimeToUpdateCache::updateInfoTime, Qt::QueuedConnection);
     connect(this, &InfoCacheController::cacheFileInfo, worker.data(), &CacheWorker::cacheInfo, Qt::QueuedConnection);
     connect(this, &InfoCacheController::removeCacheFileInfo, worker.data(), &CacheWorker::removeCaches, Qt::QueuedConnection);
     connect(&InfoCache::instance(), &InfoCache::cacheRemoveCaches, worker.data(), &CacheWorker::removeCaches, Qt::QueuedConnection);
@@ -490,13 +532,6 @@ TimeToUpdateCache::~TimeToUpdateCache()
 
 }
 
-void TimeToUpdateCache::updateInfoTime(const QUrl url)
-{
-    Q_ASSERT(qApp->thread() != QThread::currentThread());
-    if (InfoCache::instance().updateSortTimeWorker(url))
-        InfoCache::instance().timeRemoveCache();
-}
-
 void TimeToUpdateCache::dealRemoveInfo()
 {
     Q_ASSERT(qApp->thread() != QThread::currentThread());
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "networkutils.h"
+#include "base/device/private/mounttable.h"
 
 #include <QtConcurrent>
 #include <QFutureWatcher>
@@ -12,8 +13,6 @@
 #include <netdb.h>
 #include <arpa/inet.h>
 #include <unistd.h>
-#include <sys/stat.h>
-#include <libmount.h>
 
 using namespace dfmbase;
 
@@ -183,49 +182,15 @@ bool NetworkUtils::checkFtpOrSmbBusy(const QUrl &url)
 
 QMap<QString, QString> NetworkUtils::cifsMountHostInfo()
 {
-    static QMutex mutex;
-    static QMap<QString, QString> table;
-    struct stat statInfo;
-    int result = stat("/proc/mounts", &statInfo);
-
-    QMutexLocker locker(&mutex);
-    if (0 == result) {
-        static quint32 lastModify = 0;
-        if (lastModify != statInfo.st_mtime) {
-            lastModify = static_cast<quint32>(statInfo.st_mtime);
-            table.clear();
-        } else {
-            return table;
-        }
-
-        libmnt_table *tab { mnt_new_table() };
-        libmnt_iter *iter { mnt_new_iter(MNT_ITER_BACKWARD) };
-
-        int ret = mnt_table_parse_mtab(tab, nullptr);
-        if (ret != 0) {
-            mnt_free_table(tab);
-            mnt_free_iter(iter);
-            qWarning() << "device: cannot parse mtab" << ret;
-            return table;
-        }
-
-        libmnt_fs *fs = nullptr;
-        while (mnt_table_next_fs(tab, iter, &fs) == 0) {
-            if (!fs)
-                continue;
-            // net work mount must start with //
-            QString srcHostAndPort = mnt_fs_get_source(fs);
-            if (!srcHostAndPort.contains(QRegularExpression("^//")))
-                continue;
-
-            const QString &mountPath = mnt_fs_get_target(fs);
-            srcHostAndPort = srcHostAndPort.replace(QRegularExpression("^//"), "");
-            srcHostAndPort = srcHostAndPort.left(srcHostAndPort.indexOf("/"));
-            table.insert(mountPath, srcHostAndPort);
-        }
-
-        mnt_free_table(tab);
-        mnt_free_iter(iter);
+    QMap<QString, QString> table;
+    const auto &mounts = MountTable::instance().entries();
+    for (const auto &entry : mounts) {
+        // net work mount must start with //
+        if (!entry.source.startsWith("//"))
+            continue;
+
+        const QString &srcHostAndPort = entry.source.mid(2);
+        table.insert(entry.target, srcHostAndPort.left(srcHostAndPort.indexOf("/")));
     }
     return table;
 }
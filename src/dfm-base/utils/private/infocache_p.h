@@ -7,16 +7,39 @@
 
 #include <dfm-base/utils/infocache.h>
 
-#include <QReadWriteLock>
 #include <QMutex>
+#include <QHash>
 #include <QTimer>
 #include <QMap>
 
 namespace dfmbase {
-enum CacheInfoStatus : uint8_t {
-    kCacheMain = 0,   // 1.正常状态 插入(同时插入主和副缓存hash)， 读取主缓存hash， 删除主缓存hash
-    kCacheCopy,
+static constexpr int kInfoCacheShardCount { 16 };
+
+// 一个分片的lru缓存，链表头是最近使用的，尾部是最久未使用的
+struct InfoCacheNode
+{
+    QUrl url;
+    FileInfoPointer info;
+    qint64 bytes { 0 };
+    qint64 touchTime { 0 };
+    InfoCacheNode *prev { nullptr };
+    InfoCacheNode *next { nullptr };
+};
+
+struct InfoCacheShard
+{
+    QMutex mutex;
+    QHash<QUrl, InfoCacheNode *> nodes;
+    InfoCacheNode *head { nullptr };
+    InfoCacheNode *tail { nullptr };
+    qint64 bytes { 0 };
+
+    void unlink(InfoCacheNode *node);
+    void pushFront(InfoCacheNode *node);
+    void touch(InfoCacheNode *node, const qint64 time);
+    FileInfoPointer take(InfoCacheNode *node);
 };
+
 class InfoCachePrivate
 {
     friend class InfoCache;
@@ -24,15 +47,10 @@ class InfoCachePrivate
     InfoCache *const q;
     DThreadList<QString> disableCahceSchemes;
 
-    QAtomicInt status { kCacheMain };   // 当前状态缓存的状态
-    QHash<QUrl, FileInfoPointer> mainCache;   // 主信息缓存
-    QHash<QUrl, FileInfoPointer> copyCache;   // 副信息缓存
-    QReadWriteLock mianLock;
-    QReadWriteLock copyLock;
-
-    // 时间排序url,利用map的有序性，来处理时间到了要移除的url
-    QHash<QUrl, QString> urlTimeSortHash;
-    QMap<QString, QUrl> timeToUrlMap;
+    InfoCacheShard shards[kInfoCacheShardCount];
+    QAtomicInteger<quint64> hitCount { 0 };
+    QAtomicInteger<quint64> missCount { 0 };
+    QAtomicInteger<quint64> evictionCount { 0 };
 
     // 时间排序url,利用map的有序性，来处理时间到了要移除的url
     QHash<QUrl, QString> urlTimeSortWatcherHash;
@@ -42,6 +60,8 @@ class InfoCachePrivate
 public:
     explicit InfoCachePrivate(InfoCache *qq);
     virtual ~InfoCachePrivate();
+
+    InfoCacheShard &shard(const QUrl &url);
 };
 }
 
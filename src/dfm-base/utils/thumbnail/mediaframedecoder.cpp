@@ -0,0 +1,244 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "mediaframedecoder.h"
+
+#include <QFile>
+#include <QDeadlineTimer>
+
+#ifdef DFM_THUMBNAIL_LIBAV
+extern "C" {
+#    include <libavformat/avformat.h>
+#    include <libavcodec/avcodec.h>
+#    include <libswscale/swscale.h>
+#    include <libavutil/imgutils.h>
+}
+
+#    include <memory>
+#    include <mutex>
+#endif
+
+using namespace dfmbase;
+
+#ifdef DFM_THUMBNAIL_LIBAV
+namespace {
+// same limit as QProcess::waitForFinished used by the ffmpeg creators
+static constexpr int kDecodeTimeout { 30000 };
+// a broken stream may never produce a picture, stop reading after this many packets
+static constexpr int kMaxReadPackets { 512 };
+// the first frames of a video are often black, start from here like ffmpegthumbnailer does
+static constexpr int kSeekPercentage { 10 };
+
+struct FormatDeleter
+{
+    void operator()(AVFormatContext *ctx) const { avformat_close_input(&ctx); }
+};
+struct CodecDeleter
+{
+    void operator()(AVCodecContext *ctx) const { avcodec_free_context(&ctx); }
+};
+struct PacketDeleter
+{
+    void operator()(AVPacket *pkt) const { av_packet_free(&pkt); }
+};
+struct FrameDeleter
+{
+    void operator()(AVFrame *frame) const { av_frame_free(&frame); }
+};
+using FormatPointer = std::unique_ptr<AVFormatContext, FormatDeleter>;
+using CodecPointer = std::unique_ptr<AVCodecContext, CodecDeleter>;
+using PacketPointer = std::unique_ptr<AVPacket, PacketDeleter>;
+using FramePointer = std::unique_ptr<AVFrame, FrameDeleter>;
+
+int interruptDecode(void *opaque)
+{
+    return static_cast<QDeadlineTimer *>(opaque)->hasExpired() ? 1 : 0;
+}
+
+FormatPointer openInput(const QString &filePath, QDeadlineTimer *deadline)
+{
+    static std::once_flag quietFlag;
+    std::call_once(quietFlag, [] { av_log_set_level(AV_LOG_QUIET); });
+
+    AVFormatContext *ctx = avformat_alloc_context();
+    if (!ctx)
+        return {};
+
+    ctx->interrupt_callback.callback = interruptDecode;
+    ctx->interrupt_callback.opaque = deadline;
+    // avformat_open_input frees the context on failure
+    if (avformat_open_input(&ctx, QFile::encodeName(filePath).constData(), nullptr, nullptr) < 0)
+        return {};
+
+    FormatPointer input(ctx);
+    if (avformat_find_stream_info(ctx, nullptr) < 0)
+        return {};
+    return input;
+}
+
+QImage scaledImage(const QImage &image, int width)
+{
+    if (image.isNull() || image.width() <= width)
+        return image;
+    return image.scaledToWidth(width, Qt::SmoothTransformation);
+}
+
+// the embedded cover is already an encoded picture, decoding the video stream is not needed
+QImage attachedPicture(AVFormatContext *ctx, int width)
+{
+    for (unsigned i = 0; i < ctx->nb_streams; ++i) {
+        const AVStream *stream = ctx->streams[i];
+        if (!(stream->disposition & AV_DISPOSITION_ATTACHED_PIC) || stream->attached_pic.size <= 0)
+            continue;
+
+        const QImage &img = QImage::fromData(stream->attached_pic.data, stream->attached_pic.size);
+        if (!img.isNull())
+            return scaledImage(img, width);
+    }
+    return {};
+}
+
+QImage convertFrame(const AVFrame *frame, const AVRational &sampleAspect, int width)
+{
+    if (frame->width <= 0 || frame->height <= 0)
+        return {};
+
+    // scale to the display size, anamorphic videos store narrower pixels
+    qreal displayWidth = frame->width;
+    if (sampleAspect.num > 0 && sampleAspect.den > 0)
+        displayWidth = displayWidth * sampleAspect.num / sampleAspect.den;
+
+    const int dstWidth = qMax(1, qMin(width, qRound(displayWidth)));
+    const int dstHeight = qMax(1, qRound(frame->height * dstWidth / displayWidth));
+
+    SwsContext *sws = sws_getContext(frame->width, frame->height, static_cast<AVPixelFormat>(frame->format),
+                                     dstWidth, dstHeight, AV_PIX_FMT_RGB32,
+                                     SWS_BILINEAR, nullptr, nullptr, nullptr);
+    if (!sws)
+        return {};
+
+    // AV_PIX_FMT_RGB32 is native endian 0xAARRGGBB, the layout of QImage::Format_RGB32
+    QImage img(dstWidth, dstHeight, QImage::Format_RGB32);
+    uint8_t *dstData[4] { img.bits(), nullptr, nullptr, nullptr };
+    int dstLinesize[4] { static_cast<int>(img.bytesPerLine()), 0, 0, 0 };
+    const int lines = sws_scale(sws, frame->data, frame->linesize, 0, frame->height, dstData, dstLinesize);
+    sws_freeContext(sws);
+
+    return lines > 0 ? img : QImage();
+}
+}   // namespace
+#endif
+
+bool MediaFrameDecoder::isAvailable()
+{
+#ifdef DFM_THUMBNAIL_LIBAV
+    return true;
+#else
+    return false;
+#endif
+}
+
+/*!
+ * \brief MediaFrameDecoder::videoFrame Decode the key frame near 10% of the video
+ * \param filePath the local path of the video
+ * \param width the maximum width of the image, smaller videos keep their size
+ * \return the frame, null when the file cannot be decoded
+ */
+QImage MediaFrameDecoder::videoFrame(const QString &filePath, int width)
+{
+#ifdef DFM_THUMBNAIL_LIBAV
+    QDeadlineTimer deadline(kDecodeTimeout);
+    FormatPointer input = openInput(filePath, &deadline);
+    if (!input)
+        return {};
+
+    AVFormatContext *ctx = input.get();
+    const int index = av_find_best_stream(ctx, AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0);
+    if (index < 0)
+        return {};
+
+    AVStream *stream = ctx->streams[index];
+    if (stream->disposition & AV_DISPOSITION_ATTACHED_PIC)
+        return attachedPicture(ctx, width);
+
+    const AVCodec *codec = avcodec_find_decoder(stream->codecpar->codec_id);
+    if (!codec)
+        return {};
+
+    CodecPointer decoder(avcodec_alloc_context3(codec));
+    if (!decoder || avcodec_parameters_to_context(decoder.get(), stream->codecpar) < 0)
+        return {};
+    // the thumbnail workers already run in parallel, one thread per decoder is enough
+    decoder->thread_count = 1;
+    if (avcodec_open2(decoder.get(), codec, nullptr) < 0)
+        return {};
+
+    // seek backward to the key frame, the first picture after it is good enough for a thumbnail
+    if (ctx->duration > 0) {
+        const int64_t target = ctx->duration * kSeekPercentage / 100;
+        if (av_seek_frame(ctx, -1, target, AVSEEK_FLAG_BACKWARD) >= 0)
+            avcodec_flush_buffers(decoder.get());
+    }
+
+    PacketPointer packet(av_packet_alloc());
+    FramePointer frame(av_frame_alloc());
+    if (!packet || !frame)
+        return {};
+
+    const AVRational sampleAspect = av_guess_sample_aspect_ratio(ctx, stream, nullptr);
+    bool draining = false;
+    for (int readCount = 0; readCount < kMaxReadPackets && !deadline.hasExpired(); ++readCount) {
+        if (!draining) {
+            const int ret = av_read_frame(ctx, packet.get());
+            if (ret < 0) {
+                // end of file, flush the frames left in the decoder
+                draining = true;
+                avcodec_send_packet(decoder.get(), nullptr);
+            } else if (packet->stream_index != index) {
+                av_packet_unref(packet.get());
+                continue;
+            } else {
+                const int sent = avcodec_send_packet(decoder.get(), packet.get());
+                av_packet_unref(packet.get());
+                if (sent < 0 && sent != AVERROR(EAGAIN))
+                    continue;
+            }
+        }
+
+        const int ret = avcodec_receive_frame(decoder.get(), frame.get());
+        if (ret == 0)
+            return convertFrame(frame.get(), sampleAspect, width);
+        if (ret != AVERROR(EAGAIN))
+            break;
+    }
+
+    return {};
+#else
+    Q_UNUSED(filePath)
+    Q_UNUSED(width)
+    return {};
+#endif
+}
+
+/*!
+ * \brief MediaFrameDecoder::coverImage Read the cover art embedded in an audio file
+ * \param filePath the local path of the audio
+ * \param width the maximum width of the image
+ * \return the cover, null when the file has none
+ */
+QImage MediaFrameDecoder::coverImage(const QString &filePath, int width)
+{
+#ifdef DFM_THUMBNAIL_LIBAV
+    QDeadlineTimer deadline(kDecodeTimeout);
+    FormatPointer input = openInput(filePath, &deadline);
+    if (!input)
+        return {};
+
+    return attachedPicture(input.get(), width);
+#else
+    Q_UNUSED(filePath)
+    Q_UNUSED(width)
+    return {};
+#endif
+}
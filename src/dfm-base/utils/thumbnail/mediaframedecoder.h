@@ -0,0 +1,29 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef MEDIAFRAMEDECODER_H
+#define MEDIAFRAMEDECODER_H
+
+#include <dfm-base/dfm_base_global.h>
+
+#include <QImage>
+
+namespace dfmbase {
+
+/*!
+ * \brief The MediaFrameDecoder class decodes thumbnails of media files in process with libav
+ * Every thumbnail worker calls it directly, so no ffmpeg process is started per file and the
+ * frame is scaled straight into the returned image instead of going through a png pipe.
+ */
+class MediaFrameDecoder
+{
+public:
+    static bool isAvailable();
+    static QImage videoFrame(const QString &filePath, int width);
+    static QImage coverImage(const QString &filePath, int width);
+};
+
+}
+
+#endif   // MEDIAFRAMEDECODER_H
@@ -4,6 +4,7 @@
 
 #include "thumbnailcreators.h"
 #include "thumbnailhelper.h"
+#include "mediaframedecoder.h"
 
 #include <dfm-base/utils/fileutils.h>
 #include <dfm-base/mimetype/dmimedatabase.h>
@@ -18,6 +19,9 @@
 #include <QPen>
 #include <QPainter>
 #include <QImageReader>
+#include <QTransform>
+#include <QFile>
+#include <QBuffer>
 #include <QDebug>
 
 // use original poppler api
@@ -26,11 +30,143 @@
 #include <poppler/cpp/poppler-page.h>
 #include <poppler/cpp/poppler-page-renderer.h>
 
+#include <cstring>
+
 static constexpr char kFormat[] { ".png" };
+// the exif block is in the first segments of a jpeg, it is limited to 64 KiB by the format
+static constexpr qint64 kExifReadSize { 64 * 1024 + 32 };
 
 using namespace dfmbase;
 DFMGLOBAL_USE_NAMESPACE
 
+namespace {
+quint32 readExifValue(const uchar *p, int bytes, bool bigEndian)
+{
+    quint32 value = 0;
+    for (int i = 0; i < bytes; ++i)
+        value |= static_cast<quint32>(p[bigEndian ? i : bytes - 1 - i]) << (8 * (bytes - 1 - i));
+    return value;
+}
+
+QImage applyExifOrientation(const QImage &img, int orientation)
+{
+    switch (orientation) {
+    case 2:
+        return img.mirrored(true, false);
+    case 3:
+        return img.transformed(QTransform().rotate(180));
+    case 4:
+        return img.mirrored(false, true);
+    case 5:
+        return img.transformed(QTransform().rotate(90)).mirrored(true, false);
+    case 6:
+        return img.transformed(QTransform().rotate(90));
+    case 7:
+        return img.transformed(QTransform().rotate(270)).mirrored(true, false);
+    case 8:
+        return img.transformed(QTransform().rotate(270));
+    default:
+        return img;
+    }
+}
+
+/*!
+ * \brief exifThumbnail Use the preview a camera embeds in the exif block of a jpeg
+ * The preview is only used when it covers the requested size, so the thumbnail is not blurred.
+ * Thumbnails are requested at kLarge, which the 640x480 previews of most recent cameras
+ * satisfy; the common 160x120 ones are rejected from their header and the image is decoded.
+ */
+QImage exifThumbnail(const QString &filePath, int size)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return {};
+
+    const QByteArray &head = file.read(kExifReadSize);
+    const uchar *data = reinterpret_cast<const uchar *>(head.constData());
+    const qint64 length = head.size();
+    if (length < 4 || data[0] != 0xFF || data[1] != 0xD8)
+        return {};
+
+    // walk the segments until the exif one, the image data starts at SOS
+    qint64 pos = 2;
+    bool found = false;
+    while (pos + 4 <= length && data[pos] == 0xFF) {
+        const uchar marker = data[pos + 1];
+        const qint64 segmentLength = readExifValue(data + pos + 2, 2, true);
+        if (marker == 0xDA || segmentLength < 2)
+            return {};
+        if (marker == 0xE1 && segmentLength > 14 && pos + 10 <= length
+            && memcmp(data + pos + 4, "Exif\0\0", 6) == 0) {
+            found = true;
+            break;
+        }
+        pos += 2 + segmentLength;
+    }
+    if (!found)
+        return {};
+
+    // every offset below comes from the file, compare in 64 bits so that none can wrap
+    const qint64 tiffStart = pos + 10;
+    const qint64 tiffLength = qMin(length, pos + 2 + static_cast<qint64>(readExifValue(data + pos + 2, 2, true))) - tiffStart;
+    if (tiffLength < 8)
+        return {};
+
+    const uchar *tiff = data + tiffStart;
+    const bool bigEndian = tiff[0] == 'M' && tiff[1] == 'M';
+    if (!bigEndian && !(tiff[0] == 'I' && tiff[1] == 'I'))
+        return {};
+
+    int orientation = 1;
+    qint64 previewOffset = 0;
+    qint64 previewLength = 0;
+    qint64 ifdOffset = readExifValue(tiff + 4, 4, bigEndian);
+    // IFD0 holds the orientation, IFD1 the preview
+    for (int ifd = 0; ifd < 2 && ifdOffset != 0; ++ifd) {
+        if (ifdOffset + 2 > tiffLength)
+            return {};
+        const qint64 count = readExifValue(tiff + ifdOffset, 2, bigEndian);
+        const qint64 entriesEnd = ifdOffset + 2 + count * 12;
+        if (entriesEnd + 4 > tiffLength)
+            return {};
+
+        for (qint64 i = 0; i < count; ++i) {
+            const uchar *entry = tiff + ifdOffset + 2 + i * 12;
+            const quint32 tag = readExifValue(entry, 2, bigEndian);
+            const quint32 type = readExifValue(entry + 2, 2, bigEndian);
+            // a SHORT value sits in the first two bytes of the value field
+            const quint32 value = type == 3 ? readExifValue(entry + 8, 2, bigEndian) : readExifValue(entry + 8, 4, bigEndian);
+            if (ifd == 0 && tag == 0x0112)
+                orientation = static_cast<int>(value);
+            else if (ifd == 1 && tag == 0x0201)
+                previewOffset = value;
+            else if (ifd == 1 && tag == 0x0202)
+                previewLength = value;
+        }
+        ifdOffset = readExifValue(tiff + entriesEnd, 4, bigEndian);
+    }
+
+    if (previewOffset == 0 || previewLength == 0 || previewOffset + previewLength > tiffLength)
+        return {};
+
+    const QByteArray &previewData = QByteArray::fromRawData(reinterpret_cast<const char *>(tiff + previewOffset),
+                                                            static_cast<int>(previewLength));
+    QBuffer buffer;
+    buffer.setData(previewData);
+    QImageReader reader(&buffer, "JPEG");
+    const QSize &previewSize = reader.size();
+    if (!previewSize.isValid() || qMax(previewSize.width(), previewSize.height()) < size)
+        return {};
+
+    reader.setScaledSize(previewSize.scaled(size, size, Qt::KeepAspectRatio));
+    const QImage &preview = reader.read();
+    if (preview.isNull())
+        return {};
+
+    return applyExifOrientation(preview, orientation);
+}
+}   // namespace
+
 QImage ThumbnailCreators::defaultThumbnailCreator(const QString &filePath, ThumbnailSize size)
 {
     QFileInfo qInf(filePath);
@@ -58,6 +194,14 @@ QImage ThumbnailCreators::videoThumbnailCreator(const QString &filePath, Thumbna
 
 QImage ThumbnailCreators::videoThumbnailCreatorFfmpeg(const QString &filePath, ThumbnailSize size)
 {
+    // decode in process, the ffmpeg tool is only the fallback for builds without libav
+    if (MediaFrameDecoder::isAvailable()) {
+        const QImage &frame = MediaFrameDecoder::videoFrame(filePath, size);
+        if (frame.isNull())
+            qCWarning(logDFMBase) << "thumbnail: cannot decode video frame." << filePath;
+        return frame;
+    }
+
     QProcess ffmpeg;
     QStringList args { "-nostats", "-loglevel", "0", "-i", filePath,
                        "-vf", QString("scale='min(%1, iw)':-1").arg(size), "-f",
@@ -154,6 +298,9 @@ QImage ThumbnailCreators::textThumbnailCreator(const QString &filePath, Thumbnai
 
 QImage ThumbnailCreators::audioThumbnailCreator(const QString &filePath, ThumbnailSize size)
 {
+    if (MediaFrameDecoder::isAvailable())
+        return MediaFrameDecoder::coverImage(filePath, size);
+
     QProcess ffmpeg;
     QStringList args { "-nostats", "-loglevel", "0", "-i", filePath,
                        "-an", "-vf", QString("scale='min(%1, iw)':-1").arg(size), "-f", "image2pipe", "-fs", "9000", "-" };
@@ -180,8 +327,15 @@ QImage ThumbnailCreators::imageThumbnailCreator(const QString &filePath, Thumbna
     //! QImageReader构造时不传format参数，让其自行判断
     //! fix bug #53200 QImageReader构造时不传format参数，会造成没有读取不了真实的文件 类型比如将png图标后缀修改为jpg，读取的类型不对
 
-    QString mimeType = DMimeDatabase().mimeTypeForFile(QUrl::fromLocalFile(filePath), QMimeDatabase::MatchContent).name();
-    const QString &suffix = mimeType.replace("image/", "");
+    DMimeDatabase mimeDatabase;
+    // the file is sniffed once, the type also decides the svg scaling below
+    const QString &mimeType = mimeDatabase.mimeTypeForFile(QUrl::fromLocalFile(filePath), QMimeDatabase::MatchContent).name();
+    if (mimeType == Mime::kTypeImageJpeg) {
+        const QImage &preview = exifThumbnail(filePath, size);
+        if (!preview.isNull())
+            return preview;
+    }
+    const QString &suffix = QString(mimeType).replace("image/", "");
 
     QImageReader reader(filePath, suffix.toLatin1());
     if (!reader.canRead()) {
@@ -200,8 +354,8 @@ QImage ThumbnailCreators::imageThumbnailCreator(const QString &filePath, Thumbna
         return {};
     }
 
-    const QString &defaultMime = DMimeDatabase().mimeTypeForFile(QUrl::fromLocalFile(filePath)).name();
-    if (imageSize.width() > size || imageSize.height() > size || defaultMime == DFMGLOBAL_NAMESPACE::Mime::kTypeImageSvgXml)
+    // scaled reading lets the jpeg decoder scale in the DCT domain instead of decoding every pixel
+    if (imageSize.width() > size || imageSize.height() > size || mimeType == DFMGLOBAL_NAMESPACE::Mime::kTypeImageSvgXml)
         reader.setScaledSize(reader.size().scaled(size, size, Qt::KeepAspectRatio));
 
     reader.setAutoTransform(true);
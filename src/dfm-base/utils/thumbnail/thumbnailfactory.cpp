@@ -12,17 +12,23 @@
 #include <dfm-base/base/device/deviceproxymanager.h>
 
 #include <QGuiApplication>
+#include <QMimeDatabase>
+#include <QDir>
+#include <QSet>
 
 using namespace dfmbase;
 DFMGLOBAL_USE_NAMESPACE
 
-static constexpr int kMaxCountLimit { 50 };
-static constexpr int kPushInterval { 100 };   // ms
+// heavy creators decode documents and media, one of each kind runs at a time so they cannot
+// occupy every worker and hold back the images behind them
+static constexpr char kCategoryVideo[] { "video" };
+static constexpr char kCategoryAudio[] { "audio" };
+static constexpr char kCategoryDocument[] { "document" };
+static constexpr char kCategoryDefault[] { "default" };
+static constexpr int kHeavyTaskLimit { 1 };
 
 ThumbnailFactory::ThumbnailFactory(QObject *parent)
-    : QObject(parent),
-      thread(new QThread),
-      worker(new ThumbnailWorker)
+    : QObject(parent)
 {
     registerThumbnailCreator(Mime::kTypeImageVDjvu, ThumbnailCreators::djvuThumbnailCreator);
     registerThumbnailCreator(Mime::kTypeImageVDMultipage, ThumbnailCreators::djvuThumbnailCreator);
@@ -38,26 +44,40 @@ ThumbnailFactory::ThumbnailFactory(QObject *parent)
 
 ThumbnailFactory::~ThumbnailFactory()
 {
-    if (thread->isRunning())
-        onAboutToQuit();
+    for (const auto &thread : threads) {
+        if (thread->isRunning()) {
+            onAboutToQuit();
+            break;
+        }
+    }
 }
 
 void ThumbnailFactory::init()
 {
     Q_ASSERT(qApp->thread() == QThread::currentThread());
 
-    taskPushTimer.setSingleShot(true);
-    taskPushTimer.setInterval(kPushInterval);
-    connect(&taskPushTimer, &QTimer::timeout, this, &ThumbnailFactory::pushTask);
     connect(this, &ThumbnailFactory::thumbnailJob, this, &ThumbnailFactory::doJoinThumbnailJob, Qt::QueuedConnection);
     connect(qApp, &QGuiApplication::aboutToQuit, this, &ThumbnailFactory::onAboutToQuit);
 
-    connect(this, &ThumbnailFactory::addTask, worker.data(), &ThumbnailWorker::onTaskAdded, Qt::QueuedConnection);
-    connect(worker.data(), &ThumbnailWorker::thumbnailCreateFinished, this, &ThumbnailFactory::produceFinished, Qt::QueuedConnection);
-    connect(worker.data(), &ThumbnailWorker::thumbnailCreateFailed, this, &ThumbnailFactory::produceFailed, Qt::QueuedConnection);
-
-    worker->moveToThread(thread.data());
-    thread->start();
+    const int workerCount = qBound(2, QThread::idealThreadCount() / 2, 4);
+    for (int i = 0; i < workerCount; ++i) {
+        QSharedPointer<QThread> thread(new QThread);
+        QSharedPointer<ThumbnailWorker> worker(new ThumbnailWorker);
+        for (auto it = creators.cbegin(); it != creators.cend(); ++it)
+            worker->registerCreator(it.key(), it.value());
+
+        ThumbnailWorker *ptr = worker.data();
+        connect(ptr, &ThumbnailWorker::thumbnailCreateFinished, this, &ThumbnailFactory::produceFinished, Qt::QueuedConnection);
+        connect(ptr, &ThumbnailWorker::thumbnailCreateFailed, this, &ThumbnailFactory::produceFailed, Qt::QueuedConnection);
+        connect(
+                ptr, &ThumbnailWorker::taskDispatchFinished, this, [this, ptr](const QUrl &url) { onTaskFinished(ptr, url); }, Qt::QueuedConnection);
+
+        worker->moveToThread(thread.data());
+        thread->start();
+        threads.append(thread);
+        workers.append(worker);
+        idleWorkers.append(ptr);
+    }
 }
 
 void ThumbnailFactory::joinThumbnailJob(const QUrl &url, ThumbnailSize size)
@@ -69,23 +89,103 @@ void ThumbnailFactory::joinThumbnailJob(const QUrl &url, ThumbnailSize size)
     doJoinThumbnailJob(url, size);
 }
 
+/*!
+ * \brief ThumbnailFactory::raiseThumbnailJobs Run the pending jobs of the urls before the others
+ * \param urls the urls on the screen
+ */
+void ThumbnailFactory::raiseThumbnailJobs(const QList<QUrl> &urls)
+{
+    Q_ASSERT(qApp->thread() == QThread::currentThread());
+
+    for (const auto &url : urls) {
+        auto it = pendingTasks.find(url);
+        if (it == pendingTasks.end())
+            continue;
+        taskQueue.remove(it->order);
+        it->order = ++taskOrder;
+        taskQueue.insert(it->order, url);
+    }
+}
+
+/*!
+ * \brief ThumbnailFactory::cancelThumbnailJobs Drop the pending jobs of the files below the parent
+ * Running jobs are not interrupted. Every dropped job is reported by produceCanceled.
+ * \param parent the directory shown by the view
+ * \param keepUrls the urls still on the screen
+ */
+void ThumbnailFactory::cancelThumbnailJobs(const QUrl &parent, const QList<QUrl> &keepUrls)
+{
+    Q_ASSERT(qApp->thread() == QThread::currentThread());
+
+    QString parentPath = parent.path();
+    if (!parentPath.endsWith(QDir::separator()))
+        parentPath.append(QDir::separator());
+    const QSet<QUrl> keeps(keepUrls.cbegin(), keepUrls.cend());
+
+    QList<QUrl> canceledUrls;
+    for (auto it = pendingTasks.begin(); it != pendingTasks.end();) {
+        const QUrl &url = it.key();
+        if (url.scheme() != parent.scheme() || !url.path().startsWith(parentPath) || keeps.contains(url)) {
+            ++it;
+            continue;
+        }
+        taskQueue.remove(it->order);
+        canceledUrls.append(url);
+        it = pendingTasks.erase(it);
+    }
+
+    for (const auto &url : canceledUrls)
+        emit produceCanceled(url);
+}
+
 bool ThumbnailFactory::registerThumbnailCreator(const QString &mimeType, ThumbnailCreator creator)
 {
     Q_ASSERT(creator);
-    return worker->registerCreator(mimeType, creator);
+    if (creators.contains(mimeType)) {
+        qCWarning(logDFMBase) << "register failed, the mime type has already been registered." << mimeType;
+        return false;
+    }
+
+    creators.insert(mimeType, creator);
+    for (const auto &worker : workers)
+        worker->registerCreator(mimeType, creator);
+    return true;
 }
 
 void ThumbnailFactory::onAboutToQuit()
 {
-    worker->stop();
-    thread->quit();
-    thread->wait(3000);
+    for (const auto &worker : workers)
+        worker->stop();
+    for (const auto &thread : threads) {
+        thread->quit();
+        thread->wait(3000);
+    }
 }
 
-void ThumbnailFactory::pushTask()
+void ThumbnailFactory::dispatchTasks()
 {
-    auto map = std::move(taskMap);
-    emit addTask(map);
+    if (idleWorkers.isEmpty() || taskQueue.isEmpty())
+        return;
+
+    // newest first, the jobs of a busy category stay queued and the older ones get their turn
+    auto it = taskQueue.end();
+    while (it != taskQueue.begin() && !idleWorkers.isEmpty()) {
+        --it;
+        const QUrl url = it.value();
+        const ThumbnailTask task = pendingTasks.value(url);
+        if (runningPerCategory.value(task.category) >= categoryLimit(task.category))
+            continue;
+
+        it = taskQueue.erase(it);
+        pendingTasks.remove(url);
+        runningTasks.insert(url, task.category);
+        ++runningPerCategory[task.category];
+
+        ThumbnailWorker *worker = idleWorkers.takeLast();
+        const ThumbnailSize size = task.size;
+        QMetaObject::invokeMethod(
+                worker, [worker, url, size] { worker->onTaskDispatched(url, size); }, Qt::QueuedConnection);
+    }
 }
 
 void ThumbnailFactory::doJoinThumbnailJob(const QUrl &url, ThumbnailSize size)
@@ -93,16 +193,51 @@ void ThumbnailFactory::doJoinThumbnailJob(const QUrl &url, ThumbnailSize size)
     if (FileUtils::containsCopyingFileUrl(url))
         return;
 
-    if (taskMap.contains(url))
+    // the same file is produced once, a repeated request only raises it
+    if (runningTasks.contains(url))
         return;
 
-    if (taskMap.isEmpty())
-        taskPushTimer.start();
+    auto it = pendingTasks.find(url);
+    if (it != pendingTasks.end()) {
+        taskQueue.remove(it->order);
+    } else {
+        it = pendingTasks.insert(url, ThumbnailTask());
+        it->category = taskCategory(url);
+    }
+    it->size = size;
+    it->order = ++taskOrder;
+    taskQueue.insert(it->order, url);
+
+    dispatchTasks();
+}
 
+void ThumbnailFactory::onTaskFinished(ThumbnailWorker *worker, const QUrl &url)
+{
+    const QString &category = runningTasks.take(url);
+    if (--runningPerCategory[category] <= 0)
+        runningPerCategory.remove(category);
+    idleWorkers.append(worker);
 
-    taskMap.insert(url, size);
-    if (taskMap.size() < kMaxCountLimit)
-        return;
+    dispatchTasks();
+}
 
-    pushTask();
+// the category only schedules the job, so the cheap suffix match is enough here
+QString ThumbnailFactory::taskCategory(const QUrl &url)
+{
+    static const QMimeDatabase db;
+    const QString &name = db.mimeTypeForFile(url.path(), QMimeDatabase::MatchExtension).name();
+    if (name.startsWith("video/") || name == Mime::kTypeAppVRRMedia)
+        return kCategoryVideo;
+    if (name.startsWith("audio/"))
+        return kCategoryAudio;
+    if (name == Mime::kTypeAppPdf || name == Mime::kTypeImageVDjvu || name == Mime::kTypeImageVDMultipage)
+        return kCategoryDocument;
+    return kCategoryDefault;
+}
+
+int ThumbnailFactory::categoryLimit(const QString &category) const
+{
+    if (category == kCategoryDefault)
+        return workers.count();
+    return kHeavyTaskLimit;
 }
@@ -11,7 +11,8 @@
 #include <dfm-base/dfm_global_defines.h>
 #include <dfm-base/interfaces/fileinfo.h>
 
-#include <QTimer>
+#include <QHash>
+#include <QMap>
 
 namespace dfmbase {
 
@@ -26,18 +27,21 @@ public:
     }
 
     void joinThumbnailJob(const QUrl &url, DFMGLOBAL_NAMESPACE::ThumbnailSize size);
+    void raiseThumbnailJobs(const QList<QUrl> &urls);
+    void cancelThumbnailJobs(const QUrl &parent, const QList<QUrl> &keepUrls);
     using ThumbnailCreator = std::function<QImage(const QString &, DFMGLOBAL_NAMESPACE::ThumbnailSize)>;
     bool registerThumbnailCreator(const QString &mimeType, ThumbnailCreator creator);
 
 Q_SIGNALS:
     void produceFinished(const QUrl &src, const QString &thumb);
     void produceFailed(const QUrl &src);
+    // the job was dropped before it ran, join it again to get the thumbnail
+    void produceCanceled(const QUrl &src);
 
-    void addTask(const ThumbnailWorker::ThumbnailTaskMap &taskMap);
     void thumbnailJob(const QUrl &url, DFMGLOBAL_NAMESPACE::ThumbnailSize size);
 private Q_SLOTS:
     void onAboutToQuit();
-    void pushTask();
+    void dispatchTasks();
     void doJoinThumbnailJob(const QUrl &url, DFMGLOBAL_NAMESPACE::ThumbnailSize size);
 
 protected:
@@ -46,10 +50,29 @@ protected:
     void init();
 
 private:
-    ThumbnailWorker::ThumbnailTaskMap taskMap;
-    QSharedPointer<QThread> thread { nullptr };
-    QSharedPointer<ThumbnailWorker> worker { nullptr };
-    QTimer taskPushTimer;
+    struct ThumbnailTask
+    {
+        DFMGLOBAL_NAMESPACE::ThumbnailSize size { DFMGLOBAL_NAMESPACE::kLarge };
+        QString category;
+        quint64 order { 0 };
+    };
+
+    void onTaskFinished(ThumbnailWorker *worker, const QUrl &url);
+    static QString taskCategory(const QUrl &url);
+    int categoryLimit(const QString &category) const;
+
+private:
+    // the pending jobs, the last requested one is most likely on the screen and runs first
+    QHash<QUrl, ThumbnailTask> pendingTasks;
+    QMap<quint64, QUrl> taskQueue;
+    quint64 taskOrder { 0 };
+    QHash<QUrl, QString> runningTasks;
+    QHash<QString, int> runningPerCategory;
+
+    QMap<QString, ThumbnailCreator> creators;
+    QList<QSharedPointer<QThread>> threads;
+    QList<QSharedPointer<ThumbnailWorker>> workers;
+    QList<ThumbnailWorker *> idleWorkers;
 };
 }   // namespace dfmbase
 
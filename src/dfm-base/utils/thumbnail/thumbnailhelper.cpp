@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "thumbnailhelper.h"
+#include "thumbnailindex.h"
 
 #include <dfm-base/base/standardpaths.h>
 #include <dfm-base/base/schemefactory.h>
@@ -20,8 +21,6 @@
 
 #include <sys/stat.h>
 
-#include <sys/stat.h>
-
 static constexpr qint64 kDefaultSizeLimit = 1024 * 1024 * 20;   // 20MB
 static constexpr char kFormat[] { ".png" };
 
@@ -131,21 +130,24 @@ QString ThumbnailHelper::saveThumbnail(const QUrl &url, const QImage &img, Thumb
         return "";
 
     const QString &fileUrl = url.toString(QUrl::FullyEncoded);
-    const QString &thumbnailName = ThumbnailHelper::dataToMd5Hex(fileUrl.toLocal8Bit()) + kFormat;
+    const QByteArray &urlMd5 = ThumbnailHelper::dataToMd5Hex(fileUrl.toLocal8Bit());
+    const QString &thumbnailName = urlMd5 + kFormat;
     const QString &thumbnailPath = ThumbnailHelper::sizeToFilePath(size);
     const QString &thumbnailFilePath = DFMIO::DFMUtils::buildFilePath(thumbnailPath.toStdString().c_str(), thumbnailName.toStdString().c_str(), nullptr);
     const qint64 fileModify = info->timeOf(TimeInfoType::kLastModifiedSecond).toLongLong();
 
     makePath(thumbnailPath);
 
-    QMetaObject::invokeMethod(QCoreApplication::instance(), [img, thumbnailFilePath, fileUrl, fileModify]() {
+    QMetaObject::invokeMethod(QCoreApplication::instance(), [img, thumbnailFilePath, fileUrl, fileModify, urlMd5, size]() {
         Q_ASSERT(QThread::currentThread() == qApp->thread());
         QImage tmpImg = img;
         tmpImg.setText(QT_STRINGIFY(Thumb::URL), fileUrl);
         tmpImg.setText(QT_STRINGIFY(Thumb::MTime), QString::number(fileModify));
         if (!tmpImg.save(thumbnailFilePath, Q_NULLPTR, 50)) {
             qCWarning(logDFMBase) << "thumbnail: save failed." << fileUrl;
+            return;
         }
+        ThumbnailIndex::instance()->insert(urlMd5, size, fileModify, thumbnailFilePath);
     },
                               Qt::QueuedConnection);
 
@@ -153,6 +155,23 @@ QString ThumbnailHelper::saveThumbnail(const QUrl &url, const QImage &img, Thumb
 }
 
 QImage ThumbnailHelper::thumbnailImage(const QUrl &fileUrl, ThumbnailSize size)
+{
+    const QString &thumbnail = thumbnailFilePath(fileUrl, size);
+    if (thumbnail.isEmpty())
+        return {};
+
+    QImage image(thumbnail);
+    image.setText(QT_STRINGIFY(Thumb::Path), thumbnail);
+    return image;
+}
+
+/*!
+ * \brief ThumbnailHelper::thumbnailFilePath Find the valid thumbnail of the file without decoding it
+ * The ThumbnailIndex answers for the thumbnails saved before, the others are checked by the
+ * text chunks of the png header and added to the index.
+ * \return the path of the thumbnail, empty when it does not exist or is out of date
+ */
+QString ThumbnailHelper::thumbnailFilePath(const QUrl &fileUrl, ThumbnailSize size)
 {
     FileInfoPointer fileInfo = InfoFactory::create<FileInfo>(fileUrl);
     if (!fileInfo)
@@ -163,33 +182,36 @@ QImage ThumbnailHelper::thumbnailImage(const QUrl &fileUrl, ThumbnailSize size)
     if (dirPath.isEmpty() || filePath.isEmpty())
         return {};
 
-    if (defaultThumbnailDirs().contains(dirPath)) {
-        QImage img(filePath);
-        img.setText(QT_STRINGIFY(Thumb::Path), filePath);
-        return img;
-    }
+    if (defaultThumbnailDirs().contains(dirPath))
+        return filePath;
 
-    const QString thumbnailName = dataToMd5Hex((QUrl::fromLocalFile(filePath).toString(QUrl::FullyEncoded)).toLocal8Bit()) + kFormat;
+    const QByteArray &urlMd5 = dataToMd5Hex((QUrl::fromLocalFile(filePath).toString(QUrl::FullyEncoded)).toLocal8Bit());
+    const QString thumbnailName = urlMd5 + kFormat;
     QString thumbnail = DFMIO::DFMUtils::buildFilePath(sizeToFilePath(size).toStdString().c_str(), thumbnailName.toStdString().c_str(), nullptr);
+    const qint64 fileModify = fileInfo->timeOf(TimeInfoType::kLastModifiedSecond).toLongLong();
+    if (ThumbnailIndex::instance()->contains(urlMd5, size, fileModify, thumbnail))
+        return thumbnail;
+
     if (!DFMIO::DFile(thumbnail).exists())
         return {};
 
     QImageReader ir(thumbnail, QByteArray(kFormat).mid(1));
     if (!ir.canRead()) {
         LocalFileHandler().deleteFileRecursive(QUrl::fromLocalFile(thumbnail));
+        ThumbnailIndex::instance()->remove(urlMd5, size);
         return {};
     }
     ir.setAutoDetectImageFormat(false);
 
-    QImage image = ir.read();
-    const qint64 fileModify = fileInfo->timeOf(TimeInfoType::kLastModifiedSecond).toLongLong();
-    if (!image.isNull() && image.text(QT_STRINGIFY(Thumb::MTime)).toInt() != static_cast<int>(fileModify)) {
+    // the text chunks are written before the image data, reading them does not decode the png
+    if (ir.text(QT_STRINGIFY(Thumb::MTime)).toLongLong() != fileModify) {
         LocalFileHandler().deleteFileRecursive(QUrl::fromLocalFile(thumbnail));
+        ThumbnailIndex::instance()->remove(urlMd5, size);
         return {};
     }
 
-    image.setText(QT_STRINGIFY(Thumb::Path), thumbnail);
-    return image;
+    ThumbnailIndex::instance()->insert(urlMd5, size, fileModify, thumbnail);
+    return thumbnail;
 }
 
 void ThumbnailHelper::setSizeLimit(const QMimeType &mime, qint64 size)
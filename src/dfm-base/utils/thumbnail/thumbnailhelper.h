@@ -29,6 +29,7 @@ public:
 
     QString saveThumbnail(const QUrl &url, const QImage &img, DFMGLOBAL_NAMESPACE::ThumbnailSize size);
     static QImage thumbnailImage(const QUrl &fileUrl, DFMGLOBAL_NAMESPACE::ThumbnailSize size);
+    static QString thumbnailFilePath(const QUrl &fileUrl, DFMGLOBAL_NAMESPACE::ThumbnailSize size);
 
     static const QStringList &defaultThumbnailDirs();
     static QString sizeToFilePath(DFMGLOBAL_NAMESPACE::ThumbnailSize size);
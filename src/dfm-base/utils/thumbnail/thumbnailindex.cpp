@@ -0,0 +1,233 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "thumbnailindex.h"
+
+#include <dfm-base/base/standardpaths.h>
+
+#include <QDir>
+#include <QSaveFile>
+
+#include <sys/stat.h>
+
+#include <cstring>
+
+using namespace dfmbase;
+DFMGLOBAL_USE_NAMESPACE
+
+namespace {
+constexpr char kIndexMagic[8] { 'D', 'F', 'M', 'T', 'H', 'M', 'B', '\0' };
+constexpr quint32 kIndexVersion { 1 };
+// 32768 entries take 1.25 MiB, enough for the thumbnails of a few large photo folders
+constexpr quint32 kSlotCount { 1u << 15 };
+constexpr int kMaxProbe { 8 };
+
+struct IndexHeader
+{
+    char magic[8];
+    quint32 version;
+    quint32 slotCount;
+};
+}   // namespace
+
+struct ThumbnailIndex::Entry
+{
+    quint64 key;
+    qint64 fileModify;
+    qint64 thumbModify;   // nanoseconds
+    qint64 thumbSize;
+    quint64 check;
+
+    quint64 checkValue() const
+    {
+        return key ^ static_cast<quint64>(fileModify) ^ static_cast<quint64>(thumbModify)
+                ^ (static_cast<quint64>(thumbSize) << 1) ^ 0x9e3779b97f4a7c15ull;
+    }
+};
+
+static constexpr qint64 kIndexFileSize { static_cast<qint64>(sizeof(IndexHeader)) + static_cast<qint64>(kSlotCount) * 40 };
+
+ThumbnailIndex *ThumbnailIndex::instance()
+{
+    static ThumbnailIndex ins;
+    return &ins;
+}
+
+ThumbnailIndex::ThumbnailIndex()
+{
+    static_assert(sizeof(Entry) == 40, "the index file layout depends on the entry size");
+}
+
+ThumbnailIndex::~ThumbnailIndex()
+{
+    if (data)
+        indexFile.unmap(data);
+}
+
+/*!
+ * \brief ThumbnailIndex::contains Check the thumbnail against the index
+ * \param urlMd5Hex the md5 of the url, the name of the thumbnail file
+ * \param size the size of the thumbnail
+ * \param fileModify the mtime of the source file in seconds
+ * \param thumbnailFilePath the png to stat
+ * \return true when the png was saved for this mtime of the file and has not changed since
+ */
+bool ThumbnailIndex::contains(const QByteArray &urlMd5Hex, ThumbnailSize size, qint64 fileModify, const QString &thumbnailFilePath)
+{
+    const quint64 key = entryKey(urlMd5Hex, size);
+    Entry entry;
+    {
+        QMutexLocker lk(&mutex);
+        if (!ensureMapped())
+            return false;
+
+        Entry *found = findEntry(key, false);
+        if (!found)
+            return false;
+        memcpy(&entry, found, sizeof(Entry));
+    }
+
+    if (entry.key != key || entry.check != entry.checkValue() || entry.fileModify != fileModify)
+        return false;
+
+    struct stat st;
+    if (::stat(QFile::encodeName(thumbnailFilePath).constData(), &st) != 0)
+        return false;
+
+    const qint64 thumbModify = static_cast<qint64>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+    return entry.thumbModify == thumbModify && entry.thumbSize == st.st_size;
+}
+
+void ThumbnailIndex::insert(const QByteArray &urlMd5Hex, ThumbnailSize size, qint64 fileModify, const QString &thumbnailFilePath)
+{
+    struct stat st;
+    if (::stat(QFile::encodeName(thumbnailFilePath).constData(), &st) != 0)
+        return;
+
+    Entry entry;
+    entry.key = entryKey(urlMd5Hex, size);
+    entry.fileModify = fileModify;
+    entry.thumbModify = static_cast<qint64>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+    entry.thumbSize = st.st_size;
+    entry.check = entry.checkValue();
+
+    QMutexLocker lk(&mutex);
+    if (!ensureMapped())
+        return;
+
+    Entry *slot = findEntry(entry.key, true);
+    memcpy(slot, &entry, sizeof(Entry));
+}
+
+void ThumbnailIndex::remove(const QByteArray &urlMd5Hex, ThumbnailSize size)
+{
+    const quint64 key = entryKey(urlMd5Hex, size);
+
+    QMutexLocker lk(&mutex);
+    if (!ensureMapped())
+        return;
+
+    // keep the key so the probe chain behind it is not cut, only the check value is broken
+    Entry *found = findEntry(key, false);
+    if (found)
+        found->check = 0;
+}
+
+bool ThumbnailIndex::ensureMapped()
+{
+    if (data)
+        return true;
+    if (mapFailed)
+        return false;
+
+    // do not try again and again when the cache directory is not writable
+    mapFailed = true;
+    const QString &dirPath = StandardPaths::location(StandardPaths::kCachePath);
+    QDir().mkpath(dirPath);
+    indexFile.setFileName(dirPath + "/thumbnail.index");
+    if (!indexFile.open(QIODevice::ReadWrite)) {
+        qCWarning(logDFMBase) << "thumbnail: cannot open the index." << indexFile.fileName();
+        return false;
+    }
+
+    if (!isValidIndex(&indexFile)) {
+        // a new or outdated index, start empty. other processes may still map the old file,
+        // truncating it in place would fault them, a complete index replaces it by rename
+        indexFile.close();
+        if (!createIndex(indexFile.fileName()) || !indexFile.open(QIODevice::ReadWrite) || !isValidIndex(&indexFile)) {
+            qCWarning(logDFMBase) << "thumbnail: cannot create the index." << indexFile.fileName();
+            indexFile.close();
+            return false;
+        }
+    }
+
+    data = indexFile.map(0, kIndexFileSize);
+    if (!data) {
+        indexFile.close();
+        return false;
+    }
+
+    mapFailed = false;
+    return true;
+}
+
+bool ThumbnailIndex::isValidIndex(QFile *file)
+{
+    IndexHeader header;
+    return file->size() == kIndexFileSize && file->seek(0)
+            && file->read(reinterpret_cast<char *>(&header), sizeof(header)) == sizeof(header)
+            && memcmp(header.magic, kIndexMagic, sizeof(kIndexMagic)) == 0
+            && header.version == kIndexVersion && header.slotCount == kSlotCount;
+}
+
+/*!
+ * \brief ThumbnailIndex::createIndex Write an empty index next to the old one and rename it over
+ * The rename leaves the old file to the processes that have it mapped.
+ * \param filePath the index file
+ * \return true when the new index is in place
+ */
+bool ThumbnailIndex::createIndex(const QString &filePath)
+{
+    IndexHeader header;
+    memcpy(header.magic, kIndexMagic, sizeof(kIndexMagic));
+    header.version = kIndexVersion;
+    header.slotCount = kSlotCount;
+
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)
+        || file.write(reinterpret_cast<const char *>(&header), sizeof(header)) != sizeof(header)
+        || !file.resize(kIndexFileSize)) {
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+}
+
+ThumbnailIndex::Entry *ThumbnailIndex::findEntry(quint64 key, bool forInsert)
+{
+    Entry *slots = reinterpret_cast<Entry *>(data + sizeof(IndexHeader));
+    const quint32 start = static_cast<quint32>(key) & (kSlotCount - 1);
+    Entry *reusable = nullptr;
+    for (int i = 0; i < kMaxProbe; ++i) {
+        Entry *slot = &slots[(start + static_cast<quint32>(i)) & (kSlotCount - 1)];
+        if (slot->key == key)
+            return slot;
+        if (slot->key == 0)
+            return forInsert ? slot : nullptr;
+        if (!reusable && slot->check != slot->checkValue())
+            reusable = slot;
+    }
+
+    if (!forInsert)
+        return nullptr;
+    // the chain is full, overwrite a broken entry or the first one, an index miss only costs a decode
+    return reusable ? reusable : &slots[start];
+}
+
+quint64 ThumbnailIndex::entryKey(const QByteArray &urlMd5Hex, ThumbnailSize size)
+{
+    quint64 key = urlMd5Hex.left(16).toULongLong(nullptr, 16) ^ (static_cast<quint64>(size) << 56);
+    // 0 marks an empty slot
+    return key ? key : 1;
+}
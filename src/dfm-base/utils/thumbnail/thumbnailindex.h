@@ -0,0 +1,54 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef THUMBNAILINDEX_H
+#define THUMBNAILINDEX_H
+
+#include <dfm-base/dfm_base_global.h>
+#include <dfm-base/dfm_global_defines.h>
+
+#include <QFile>
+#include <QMutex>
+
+namespace dfmbase {
+
+/*!
+ * \brief The ThumbnailIndex class remembers which thumbnail files are valid
+ * The thumbnails stay freedesktop pngs shared with other applications, the index maps
+ * the url hash and size to the mtime of the source file and the mtime and size of the png.
+ * A hit only costs a stat of the png, the png is neither opened nor decoded. The table is
+ * a fixed size open addressing hash in a mapped file, shared by every process of the
+ * file manager, a torn entry fails its check value and is treated as a miss.
+ */
+class ThumbnailIndex
+{
+public:
+    static ThumbnailIndex *instance();
+
+    bool contains(const QByteArray &urlMd5Hex, DFMGLOBAL_NAMESPACE::ThumbnailSize size, qint64 fileModify, const QString &thumbnailFilePath);
+    void insert(const QByteArray &urlMd5Hex, DFMGLOBAL_NAMESPACE::ThumbnailSize size, qint64 fileModify, const QString &thumbnailFilePath);
+    void remove(const QByteArray &urlMd5Hex, DFMGLOBAL_NAMESPACE::ThumbnailSize size);
+
+private:
+    ThumbnailIndex();
+    ~ThumbnailIndex();
+    Q_DISABLE_COPY(ThumbnailIndex)
+
+    struct Entry;
+    bool ensureMapped();
+    Entry *findEntry(quint64 key, bool forInsert);
+    static bool isValidIndex(QFile *file);
+    static bool createIndex(const QString &filePath);
+    static quint64 entryKey(const QByteArray &urlMd5Hex, DFMGLOBAL_NAMESPACE::ThumbnailSize size);
+
+private:
+    QMutex mutex;
+    QFile indexFile;
+    uchar *data { nullptr };
+    bool mapFailed { false };
+};
+
+}
+
+#endif   // THUMBNAILINDEX_H
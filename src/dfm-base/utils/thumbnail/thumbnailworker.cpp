@@ -171,9 +171,10 @@ void ThumbnailWorker::onTaskAdded(const ThumbnailTaskMap &taskMap)
         if (!d->thumbHelper.checkThumbEnable(fileUrl))
             continue;
 
-        const auto &img = d->thumbHelper.thumbnailImage(fileUrl, iter.value());
-        if (!img.isNull()) {
-            Q_EMIT thumbnailCreateFinished(iter.key(), img.text(QT_STRINGIFY(Thumb::Path)));
+        // only the path is handed on, the view loads the image itself
+        const QString &thumbnail = d->thumbHelper.thumbnailFilePath(fileUrl, iter.value());
+        if (!thumbnail.isEmpty()) {
+            Q_EMIT thumbnailCreateFinished(iter.key(), thumbnail);
             continue;
         }
 
@@ -181,6 +182,19 @@ void ThumbnailWorker::onTaskAdded(const ThumbnailTaskMap &taskMap)
     }
 }
 
+/*!
+ * \brief ThumbnailWorker::onTaskDispatched Produce one job handed out by the ThumbnailFactory
+ * The factory is told when the job is done, so it can give the worker the next one.
+ */
+void ThumbnailWorker::onTaskDispatched(const QUrl &url, Global::ThumbnailSize size)
+{
+    ThumbnailTaskMap taskMap;
+    taskMap.insert(url, size);
+    onTaskAdded(taskMap);
+
+    Q_EMIT taskDispatchFinished(url);
+}
+
 void ThumbnailWorker::createThumbnail(const QUrl &url, Global::ThumbnailSize size)
 {
     // check whether the file is stable
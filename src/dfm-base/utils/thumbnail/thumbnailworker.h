@@ -30,10 +30,12 @@ public:
 
 public Q_SLOTS:
     void onTaskAdded(const ThumbnailTaskMap &taskMap);
+    void onTaskDispatched(const QUrl &url, DFMGLOBAL_NAMESPACE::ThumbnailSize size);
 
 Q_SIGNALS:
     void thumbnailCreateFinished(const QUrl &url, const QString &thumbnail);
     void thumbnailCreateFailed(const QUrl &url);
+    void taskDispatchFinished(const QUrl &url);
 
 private:
     void createThumbnail(const QUrl &url, Global::ThumbnailSize size);
@@ -4,27 +4,50 @@
 
 #include <dfm-framework/event/event.h>
 
+#include <QHash>
+
 DPF_BEGIN_NAMESPACE
 class EventPrivate
 {
 public:
-    using EventMap = QMap<QString, EventType>;
-
-    const QMap<QString, EventStratege> prefixMap { 
-        { kSignalStrategePrefix, EventStratege::kSignal },
-        { kSlotStrategePrefix, EventStratege::kSlot },
-        { kHookStrategePrefix, EventStratege::kHook } 
+    struct EventEntry
+    {
+        EventStratege stratege;
+        EventType type;
     };
-    const QStringList prefixKeys { prefixMap.keys() };
+    // space -> topic -> event, looked up without building the "space:topic" key
+    using TopicHash = QHash<QString, EventEntry>;
+
+    static bool matchStratege(const QString &topic, EventStratege stratege);
 
     QReadWriteLock rwLock;
-    QMap<EventStratege, EventMap> eventsMap {
-        { EventStratege::kSignal, {} },
-        { EventStratege::kSlot, {} },
-        { EventStratege::kHook, {} }
-    };
+    QHash<QString, TopicHash> eventsHash;
 };
 
+/*!
+ * \brief EventPrivate::matchStratege the topic must start with the prefix of its stratege,
+ * such as "slot_" for EventStratege::kSlot, the prefix is case-insensitive
+ */
+bool EventPrivate::matchStratege(const QString &topic, EventStratege stratege)
+{
+    QLatin1String prefix;
+    switch (stratege) {
+    case EventStratege::kSignal:
+        prefix = QLatin1String(kSignalStrategePrefix);
+        break;
+    case EventStratege::kSlot:
+        prefix = QLatin1String(kSlotStrategePrefix);
+        break;
+    case EventStratege::kHook:
+        prefix = QLatin1String(kHookStrategePrefix);
+        break;
+    }
+
+    if (!topic.startsWith(prefix, Qt::CaseInsensitive))
+        return false;
+    return topic.size() == prefix.size() || topic.at(prefix.size()) == '_';
+}
+
 DPF_END_NAMESPACE
 
 DPF_USE_NAMESPACE
@@ -55,28 +78,29 @@ EventChannelManager *Event::channel()
 
 void Event::registerEventType(EventStratege stratege, const QString &space, const QString &topic)
 {
-    QString key { space + ":" + topic };
-    if (Q_UNLIKELY(d->eventsMap[stratege].contains(key))) {
-        qCWarning(logDPF) << "Register repeat event: " << key;
+    QWriteLocker guard(&d->rwLock);
+    auto &topics { d->eventsHash[space] };
+    auto iter { topics.constFind(topic) };
+    if (Q_UNLIKELY(iter != topics.constEnd())) {
+        qCWarning(logDPF) << "Register repeat event: " << space + ":" + topic;
         return;
     }
 
-    QWriteLocker guard(&d->rwLock);
-    d->eventsMap[stratege].insert(key, genCustomEventId());
+    topics.insert(topic, { stratege, genCustomEventId() });
 }
 
 EventType Event::eventType(const QString &space, const QString &topic)
 {
-    QStringList splits { topic.split("_") };
-    Q_ASSERT(splits.size() > 0);
-    QString prefix { splits.first().toLower() };
-    if (!d->prefixKeys.contains(prefix))
+    QReadLocker guard(&d->rwLock);
+    auto spaceIter { d->eventsHash.constFind(space) };
+    if (spaceIter == d->eventsHash.constEnd())
         return EventTypeScope::kInValid;
-    EventStratege stratege { d->prefixMap.value(prefix) };
-    QString key { space + ":" + topic };
 
-    QReadLocker guard(&d->rwLock);
-    return d->eventsMap[stratege].contains(key) ? d->eventsMap[stratege].value(key) : EventTypeScope::kInValid;
+    auto topicIter { spaceIter->constFind(topic) };
+    if (topicIter == spaceIter->constEnd() || !EventPrivate::matchStratege(topic, topicIter->stratege))
+        return EventTypeScope::kInValid;
+
+    return topicIter->type;
 }
 
 QStringList Event::pluginTopics(const QString &space)
@@ -92,12 +116,24 @@ QStringList Event::pluginTopics(const QString &space)
 
 QStringList Event::pluginTopics(const QString &space, EventStratege stratege)
 {
-    QStringList topics;
-    auto &&spaces { d->eventsMap.value(stratege).keys() };
-    for (QString name : spaces) {
-        if (name.startsWith(space))
-            topics.append(name.remove(space + ":"));
+    // spaces are matched by prefix, topics of other spaces keep their "space:" part
+    QStringList names;
+    {
+        QReadLocker guard(&d->rwLock);
+        for (auto spaceIter = d->eventsHash.cbegin(); spaceIter != d->eventsHash.cend(); ++spaceIter) {
+            if (!spaceIter.key().startsWith(space))
+                continue;
+            for (auto iter = spaceIter->cbegin(); iter != spaceIter->cend(); ++iter) {
+                if (iter->stratege == stratege)
+                    names.append(spaceIter.key() + ":" + iter.key());
+            }
+        }
     }
+    names.sort();
+
+    QStringList topics;
+    for (QString name : names)
+        topics.append(name.remove(space + ":"));
 
     return topics;
 }
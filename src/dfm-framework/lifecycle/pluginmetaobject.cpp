@@ -121,7 +121,9 @@ bool PluginMetaObject::isVirtual() const
  */
 QString PluginMetaObject::fileName() const
 {
-    return d->loader->fileName();
+    if (!d->loader->fileName().isEmpty())
+        return d->loader->fileName();
+    return d->fileName;
 }
 
 /*!
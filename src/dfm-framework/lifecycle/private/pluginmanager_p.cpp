@@ -10,8 +10,21 @@
 #include <dfm-framework/lifecycle/plugin.h>
 #include <dfm-framework/lifecycle/plugincreator.h>
 
+#include <QStandardPaths>
+#include <QSaveFile>
+#include <QJsonDocument>
+#include <QElapsedTimer>
+
+#include <fcntl.h>
+#include <unistd.h>
+
 DPF_BEGIN_NAMESPACE
 
+static constexpr char kManifestFileName[] { "dpf-plugins.json" };
+static constexpr char kManifestModified[] { "Modified" };
+static constexpr char kManifestSize[] { "Size" };
+static constexpr char kManifestMetaData[] { "MetaData" };
+
 PluginManagerPrivate::PluginManagerPrivate(PluginManager *qq)
     : q(qq)
 {
@@ -85,7 +98,9 @@ bool PluginManagerPrivate::stopPlugin(PluginMetaObjectPointer &pluginMetaObj)
  */
 bool PluginManagerPrivate::readPlugins()
 {
+    readManifest();
     scanfAllPlugin();
+    writeManifest();
     std::for_each(readQueue.begin(), readQueue.end(), [this](PluginMetaObjectPointer obj) {
         readJsonToMeta(obj);
         const QString &pluginName { obj->name() };
@@ -132,21 +147,23 @@ void PluginManagerPrivate::scanfAllPlugin()
 
         while (dirItera.hasNext()) {
             dirItera.next();
-            PluginMetaObjectPointer metaObj(new PluginMetaObject);
             const QString &fileName { dirItera.path() + "/" + dirItera.fileName() };
             qCDebug(logDPF) << "scan plugin:" << fileName;
-            metaObj->d->loader->setFileName(fileName);
-            QJsonObject &&metaJson = metaObj->d->loader->metaData();
+            const QJsonObject &metaJson = libraryMetaData(fileName);
             QJsonObject &&dataJson = metaJson.value("MetaData").toObject();
             QString &&iid = metaJson.value("IID").toString();
             if (!pluginLoadIIDs.contains(iid))
                 continue;
 
             bool isVirtual = dataJson.contains(kVirtualPluginMeta) && dataJson.contains(kVirtualPluginList);
-            if (isVirtual)
-                scanfVirtualPlugin(fileName, dataJson);
-            else
+            if (isVirtual) {
+                scanfVirtualPlugin(fileName, metaJson, dataJson);
+            } else {
+                PluginMetaObjectPointer metaObj(new PluginMetaObject);
+                metaObj->d->fileName = fileName;
+                metaObj->d->metaData = metaJson;
                 scanfRealPlugin(metaObj, dataJson);
+            }
         }
     }
 }
@@ -167,6 +184,7 @@ void PluginManagerPrivate::scanfRealPlugin(PluginMetaObjectPointer metaObj,
 }
 
 void PluginManagerPrivate::scanfVirtualPlugin(const QString &fileName,
+                                              const QJsonObject &metaJson,
                                               const QJsonObject &dataJson)
 {
     QJsonObject &&metaDataJson { dataJson.value(kVirtualPluginMeta).toObject() };
@@ -182,7 +200,8 @@ void PluginManagerPrivate::scanfVirtualPlugin(const QString &fileName,
             return;
 
         PluginMetaObjectPointer metaObj(new PluginMetaObject);
-        metaObj->d->loader->setFileName(fileName);
+        metaObj->d->fileName = fileName;
+        metaObj->d->metaData = metaJson;
         metaObj->d->isVirtual = true;
         metaObj->d->realName = realName;
         metaObj->d->name = name;
@@ -191,6 +210,112 @@ void PluginManagerPrivate::scanfVirtualPlugin(const QString &fileName,
     }
 }
 
+/*!
+ * \brief 获取插件库的元数据，库文件未变化时使用清单中缓存的数据，
+ * 避免启动时为每个插件解析 ELF 文件
+ * \param fileName
+ * \return IID 与 MetaData
+ */
+QJsonObject PluginManagerPrivate::libraryMetaData(const QString &fileName)
+{
+    const QFileInfo info(fileName);
+    const qint64 modified { info.lastModified().toMSecsSinceEpoch() };
+    const qint64 size { info.size() };
+
+    const QJsonObject &cached { manifest.value(fileName).toObject() };
+    if (!cached.isEmpty()
+        && cached.value(kManifestModified).toVariant().toLongLong() == modified
+        && cached.value(kManifestSize).toVariant().toLongLong() == size)
+        return cached.value(kManifestMetaData).toObject();
+
+    QPluginLoader loader(fileName);
+    const QJsonObject &metaJson { loader.metaData() };
+    QJsonObject entry;
+    entry.insert(kManifestModified, QString::number(modified));
+    entry.insert(kManifestSize, QString::number(size));
+    entry.insert(kManifestMetaData, metaJson);
+    manifest.insert(fileName, entry);
+    manifestChanged = true;
+
+    return metaJson;
+}
+
+QString PluginManagerPrivate::manifestFile() const
+{
+    const QString &cacheDir { QStandardPaths::writableLocation(QStandardPaths::CacheLocation) };
+    if (cacheDir.isEmpty())
+        return {};
+    return cacheDir + "/" + kManifestFileName;
+}
+
+void PluginManagerPrivate::readManifest()
+{
+    manifest = {};
+    manifestChanged = false;
+
+    QFile file(manifestFile());
+    if (file.fileName().isEmpty() || !file.open(QIODevice::ReadOnly))
+        return;
+
+    manifest = QJsonDocument::fromJson(file.readAll()).object();
+}
+
+/*!
+ * \brief 写回插件清单，已删除的插件库不再保留
+ */
+void PluginManagerPrivate::writeManifest()
+{
+    const QStringList &keys { manifest.keys() };
+    for (const QString &key : keys) {
+        if (!QFileInfo::exists(key)) {
+            manifest.remove(key);
+            manifestChanged = true;
+        }
+    }
+
+    if (!manifestChanged)
+        return;
+
+    const QString &fileName { manifestFile() };
+    if (fileName.isEmpty() || !QDir().mkpath(QFileInfo(fileName).absolutePath()))
+        return;
+
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(logDPF) << "Failed write plugin manifest: " << fileName << file.errorString();
+        return;
+    }
+    file.write(QJsonDocument(manifest).toJson(QJsonDocument::Compact));
+    if (file.commit())
+        manifestChanged = false;
+}
+
+/*!
+ * \brief 预读插件库文件，插件按依赖顺序逐个加载时，后续插件已经在页缓存中
+ * \param queue
+ */
+void PluginManagerPrivate::prefetchPlugins(const QQueue<PluginMetaObjectPointer> &queue)
+{
+    QStringList files;
+    for (const auto &pointer : queue) {
+        if (!pointer->d->fileName.isEmpty() && !files.contains(pointer->d->fileName))
+            files.append(pointer->d->fileName);
+    }
+
+    if (files.isEmpty())
+        return;
+
+    QtConcurrent::run([files]() {
+        for (const QString &file : files) {
+            int fd = ::open(QFile::encodeName(file).constData(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0)
+                continue;
+            ::posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+            ::close(fd);
+        }
+    });
+}
+
 bool PluginManagerPrivate::isBlackListed(const QString &name)
 {
     if (blackPluginNames.contains(name)) {
@@ -214,7 +339,7 @@ void PluginManagerPrivate::readJsonToMeta(PluginMetaObjectPointer metaObject)
 {
     metaObject->d->state = PluginMetaObject::kReading;
 
-    QJsonObject &&jsonObj = metaObject->d->loader->metaData();
+    const QJsonObject &jsonObj = metaObject->d->metaData;
     if (jsonObj.isEmpty())
         return;
 
@@ -313,6 +438,7 @@ bool PluginManagerPrivate::loadPlugins()
 {
     qCInfo(logDPF) << "Start loading all plugins: ";
     dependsSort(&loadQueue, &pluginsToLoad);
+    prefetchPlugins(loadQueue);
 
     bool ret = true;
     std::for_each(loadQueue.begin(), loadQueue.end(), [&ret, this](PluginMetaObjectPointer pointer) {
@@ -435,6 +561,13 @@ bool PluginManagerPrivate::doLoadPlugin(PluginMetaObjectPointer pointer)
 
     pointer->d->state = PluginMetaObject::State::kLoading;
 
+    // 扫描时不再打开插件库，加载前才设置文件
+    if (!pointer->d->fileName.isEmpty() && pointer->d->loader->fileName().isEmpty())
+        pointer->d->loader->setFileName(pointer->d->fileName);
+
+    QElapsedTimer timer;
+    timer.start();
+
     if (pointer->isVirtual() && loadedVirtualPlugins.contains(pointer->d->realName)) {
         auto creator = qobject_cast<PluginCreator *>(pointer->d->loader->instance());
         if (creator)
@@ -472,7 +605,8 @@ bool PluginManagerPrivate::doLoadPlugin(PluginMetaObjectPointer pointer)
 
     // load success
     pointer->d->state = PluginMetaObject::State::kLoaded;
-    qCInfo(logDPF) << "Loaded plugin: " << pointer->d->name << pointer->d->loader->fileName();
+    qCInfo(logDPF) << "Loaded plugin: " << pointer->d->name << pointer->d->loader->fileName()
+                   << "elapsed:" << timer.elapsed() << "ms";
     if (pointer->isVirtual())
         loadedVirtualPlugins.push_back(pointer->d->realName);
 
@@ -504,8 +638,10 @@ bool PluginManagerPrivate::doInitPlugin(PluginMetaObjectPointer pointer)
     }
 
     pointer->d->state = PluginMetaObject::State::kInitialized;
+    QElapsedTimer timer;
+    timer.start();
     pointer->d->plugin->initialize();
-    qCInfo(logDPF) << "Initialized plugin: " << pointer->d->name;
+    qCInfo(logDPF) << "Initialized plugin: " << pointer->d->name << "elapsed:" << timer.elapsed() << "ms";
     emit Listener::instance()->pluginInitialized(pointer->d->iid, pointer->d->name);
 
     return true;
@@ -535,8 +671,10 @@ bool PluginManagerPrivate::doStartPlugin(PluginMetaObjectPointer pointer)
         return false;
     }
 
+    QElapsedTimer timer;
+    timer.start();
     if (pointer->d->plugin->start()) {
-        qCInfo(logDPF) << "Started plugin: " << pointer->d->name;
+        qCInfo(logDPF) << "Started plugin: " << pointer->d->name << "elapsed:" << timer.elapsed() << "ms";
         pointer->d->state = PluginMetaObject::State::kStarted;
         emit Listener::instance()->pluginStarted(pointer->d->iid, pointer->d->name);
         return true;
@@ -40,6 +40,8 @@ class PluginManagerPrivate : public QSharedData
     QQueue<PluginMetaObjectPointer> loadQueue;
     bool allPluginsInitialized { false };
     bool allPluginsStarted { false };
+    QJsonObject manifest;   // key: library file, value: mtime, size and meta data of the library
+    bool manifestChanged { false };
     std::function<bool(const QString &)> lazyPluginFilter;
     std::function<bool(const QString &)> blackListFilter;
 
@@ -69,7 +71,13 @@ private:
     void scanfRealPlugin(PluginMetaObjectPointer metaObj,
                          const QJsonObject &dataJson);
     void scanfVirtualPlugin(const QString &fileName,
+                            const QJsonObject &metaJson,
                             const QJsonObject &dataJson);
+    QJsonObject libraryMetaData(const QString &fileName);
+    QString manifestFile() const;
+    void readManifest();
+    void writeManifest();
+    void prefetchPlugins(const QQueue<PluginMetaObjectPointer> &queue);
     bool isBlackListed(const QString &name);
 
     void readJsonToMeta(PluginMetaObjectPointer metaObject);
@@ -14,6 +14,7 @@
 #include <QStringList>
 #include <QSharedPointer>
 #include <QVariantMap>
+#include <QJsonObject>
 
 DPF_BEGIN_NAMESPACE
 
@@ -71,6 +72,8 @@ public:
     QList<PluginDepend> depends;
     QSharedPointer<Plugin> plugin;
     QSharedPointer<QPluginLoader> loader;
+    QString fileName;   // the loader is pointed to it right before loading
+    QJsonObject metaData;   // IID and MetaData of the library, read from the manifest or the library
     QVariantMap customData;
     QList<PluginQuickMetaPtr> quickMetaList;
 
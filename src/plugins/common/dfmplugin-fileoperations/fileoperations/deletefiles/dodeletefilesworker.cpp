@@ -3,12 +3,24 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "dodeletefilesworker.h"
+#include "localdeleteengine.h"
+
 #include <dfm-base/base/schemefactory.h>
 
+#include <dfm-io/dfmio_utils.h>
+
 #include <QUrl>
 #include <QDebug>
+#include <QThread>
+#include <QFile>
+
+#include <sys/stat.h>
+#include <errno.h>
+#include <string.h>
 
 DPFILEOPERATIONS_USE_NAMESPACE
+
+static constexpr ulong kPausePollInterval { 100 };
 DoDeleteFilesWorker::DoDeleteFilesWorker(QObject *parent)
     : AbstractWorker(parent)
 {
@@ -43,6 +55,46 @@ void DoDeleteFilesWorker::onUpdateProgress()
 {
     emitProgressChangedNotify(deleteFilesCount);
 }
+/*!
+ * \brief DoDeleteFilesWorker::statisticsFilesSize The local delete engine counts the trees while
+ * removing them, so local sources are not walked beforehand
+ * \return
+ */
+bool DoDeleteFilesWorker::statisticsFilesSize()
+{
+    if (sourceUrls.isEmpty()) {
+        fmWarning() << "sources files list is empty!";
+        return false;
+    }
+
+    const QUrl &firstUrl = sourceUrls.first();
+    isSourceFileLocal = FileOperationsUtils::isFileOnDisk(firstUrl)
+            && DFMIO::DFMUtils::fsTypeFromUrl(firstUrl).startsWith("ext");
+    if (!isSourceFileLocal)
+        return AbstractWorker::statisticsFilesSize();
+
+    sourceFilesCount = sourceUrls.count();
+    return true;
+}
+/*!
+ * \brief DoDeleteFilesWorker::emitProgressChangedNotify The total of a local delete grows while
+ * the engine walks the trees, it is reported as still being counted
+ * \param writSize removed entries
+ */
+void DoDeleteFilesWorker::emitProgressChangedNotify(const qint64 &writSize)
+{
+    if (!isSourceFileLocal)
+        return AbstractWorker::emitProgressChangedNotify(writSize);
+
+    JobInfoPointer info(new QMap<quint8, QVariant>);
+    info->insert(AbstractJobHandler::NotifyInfoKey::kJobtypeKey, QVariant::fromValue(jobType));
+    info->insert(AbstractJobHandler::NotifyInfoKey::kTotalSizeKey, QVariant::fromValue(qint64(foundFilesCount.loadAcquire())));
+    info->insert(AbstractJobHandler::NotifyInfoKey::kStatisticStateKey,
+                 QVariant::fromValue(AbstractJobHandler::StatisticState::kRunningState));
+    info->insert(AbstractJobHandler::NotifyInfoKey::kCurrentProgressKey, QVariant::fromValue(writSize));
+
+    emit progressChangedNotify(info);
+}
 
 /*!
  * \brief DoDeleteFilesWorker::deleteAllFiles delete All files
@@ -63,46 +115,61 @@ bool DoDeleteFilesWorker::deleteAllFiles()
  */
 bool DoDeleteFilesWorker::deleteFilesOnCanNotRemoveDevice()
 {
-    if (allFilesList.count() == 1 && isConvert) {
-        auto info = InfoFactory::create<FileInfo>(allFilesList.first(), Global::CreateFileInfoType::kCreateFileInfoSync);
+    if (sourceUrls.count() == 1 && isConvert) {
+        auto info = InfoFactory::create<FileInfo>(sourceUrls.first(), Global::CreateFileInfoType::kCreateFileInfoSync);
         if (info)
             deleteFirstFileSize = info->size();
     }
 
-    AbstractJobHandler::SupportAction action { AbstractJobHandler::SupportAction::kNoAction };
-    for (QList<QUrl>::iterator it = --allFilesList.end(); it != --allFilesList.begin(); --it) {
+    LocalDeleteEngine engine(&deleteFilesCount, [this]() { return waitWhilePaused(); }, &foundFilesCount);
+    // every removed entry is published, as the search results drop deleted files one by one
+    engine.setRemovedNotifier([](const QStringList &paths) {
+        for (const QString &path : paths)
+            dpfSignalDispatcher->publish("dfmplugin_fileoperations", "signal_File_Delete", QUrl::fromLocalFile(path));
+    });
+    for (const QUrl &url : sourceUrls) {
         if (!stateCheck())
             return false;
-        const QUrl &url = *it;
-        auto info = InfoFactory::create<FileInfo>(url, Global::CreateFileInfoType::kCreateFileInfoSync);
-        emitCurrentTaskNotify(url, QUrl());
-        do {
-            action = AbstractJobHandler::SupportAction::kNoAction;
-            if (!localFileHandler->deleteFile(url)) {
-                action = doHandleErrorAndWait(url, AbstractJobHandler::JobErrorType::kDeleteFileError,
-                                              localFileHandler->errorString());
-            }
-        } while (!isStopped() && action == AbstractJobHandler::SupportAction::kRetryAction);
-
-        if (sourceUrls.contains(url)) {
-            if (action == AbstractJobHandler::SupportAction::kNoAction) {
-                completeSourceFiles.append(url);
-                completeTargetFiles.append(url);
-            }
-        }
-
-        deleteFilesCount++;
-
-        if (action == AbstractJobHandler::SupportAction::kSkipAction)
-            continue;
 
-        if (action != AbstractJobHandler::SupportAction::kNoAction)
+        emitCurrentTaskNotify(url, QUrl());
+        bool removed = engine.remove(url.path());
+        if (isStopped())
             return false;
 
-        dpfSignalDispatcher->publish("dfmplugin_fileoperations", "signal_File_Delete", url);
+        // what the engine left on disk goes the slow way, which asks the user about every error
+        if (!removed) {
+            const auto &info = InfoFactory::create<FileInfo>(url, Global::CreateFileInfoType::kCreateFileInfoSync);
+            if (!info)
+                return false;
+            if (info->isAttributes(OptInfoType::kIsSymLink) || info->isAttributes(OptInfoType::kIsFile))
+                removed = deleteFileOnOtherDevice(url);
+            else
+                removed = deleteDirOnOtherDevice(info);
+            if (!removed)
+                return false;
+            // skipped
+            struct stat st;
+            if (::lstat(QFile::encodeName(url.path()).constData(), &st) == 0)
+                continue;
+        }
+
+        completeSourceFiles.append(url);
+        completeTargetFiles.append(url);
     }
     return true;
 }
+/*!
+ * \brief DoDeleteFilesWorker::waitWhilePaused Called by the delete engine from its pool threads,
+ * the worker mutex belongs to the worker thread so the pause is polled here
+ * \return false if the task is stopped
+ */
+bool DoDeleteFilesWorker::waitWhilePaused()
+{
+    while (currentState == AbstractJobHandler::JobState::kPauseState)
+        QThread::msleep(kPausePollInterval);
+
+    return !isStopped();
+}
 /*!
  * \brief DoDeleteFilesWorker::deleteFilesOnOtherDevice Delete files on removable devices and other
  * \return delete file success
@@ -163,20 +230,47 @@ bool DoDeleteFilesWorker::deleteFileOnOtherDevice(const QUrl &url)
     if (action == AbstractJobHandler::SupportAction::kSkipAction)
         return true;
 
+    // what the local engine left on disk is removed here, publish it like the engine does
+    if (action == AbstractJobHandler::SupportAction::kNoAction && isSourceFileLocal)
+        dpfSignalDispatcher->publish("dfmplugin_fileoperations", "signal_File_Delete", url);
+
     return action == AbstractJobHandler::SupportAction::kNoAction;
 }
 /*!
  * \brief DoDeleteFilesWorker::deleteDirOnOtherDevice Delete dir on removable devices and other
+ * File systems mounted inside the dir are not entered, the user is asked about each of them.
  * \param dir delete dir
+ * \param rootDevice device of the dir the delete started from, 0 for the dir itself
  * \return delete success
  */
-bool DoDeleteFilesWorker::deleteDirOnOtherDevice(const FileInfoPointer &dir)
+bool DoDeleteFilesWorker::deleteDirOnOtherDevice(const FileInfoPointer &dir, dev_t rootDevice)
 {
     if (!stateCheck())
         return false;
 
+    const QUrl &dirUrl = dir->urlOf(UrlInfoType::kUrl);
+    dev_t device = deviceOf(dirUrl);
+    if (rootDevice == 0) {
+        rootDevice = device;
+    } else if (device != 0 && device != rootDevice) {
+        AbstractJobHandler::SupportAction action { AbstractJobHandler::SupportAction::kNoAction };
+        do {
+            fmWarning() << "Delete: not entering a mount point" << dirUrl;
+            action = doHandleErrorAndWait(dirUrl, AbstractJobHandler::JobErrorType::kDeleteFileError,
+                                          QString::fromLocal8Bit(strerror(EBUSY)));
+            device = deviceOf(dirUrl);
+        } while (!isStopped() && action == AbstractJobHandler::SupportAction::kRetryAction
+                 && device != 0 && device != rootDevice);
+
+        if (action == AbstractJobHandler::SupportAction::kSkipAction)
+            return true;
+        if (action != AbstractJobHandler::SupportAction::kRetryAction || isStopped())
+            return false;
+        // unmounted in the meantime, delete it as a plain dir
+    }
+
     if (dir->countChildFile() < 0)
-        return deleteFileOnOtherDevice(dir->urlOf(UrlInfoType::kUrl));
+        return deleteFileOnOtherDevice(dirUrl);
 
     AbstractJobHandler::SupportAction action { AbstractJobHandler::SupportAction::kNoAction };
     AbstractDirIteratorPointer iterator(nullptr);
@@ -209,7 +303,7 @@ bool DoDeleteFilesWorker::deleteDirOnOtherDevice(const FileInfoPointer &dir)
         if (info->isAttributes(OptInfoType::kIsSymLink) || info->isAttributes(OptInfoType::kIsFile)) {
             ok = deleteFileOnOtherDevice(url);
         } else {
-            ok = deleteDirOnOtherDevice(info);
+            ok = deleteDirOnOtherDevice(info, rootDevice);
         }
 
         if (!ok)
@@ -219,6 +313,20 @@ bool DoDeleteFilesWorker::deleteDirOnOtherDevice(const FileInfoPointer &dir)
     // delete self dir
     return deleteFileOnOtherDevice(dir->urlOf(UrlInfoType::kUrl));
 }
+/*!
+ * \brief DoDeleteFilesWorker::deviceOf The device a local url lives on
+ * \return 0 if the url is not local or can not be stated
+ */
+dev_t DoDeleteFilesWorker::deviceOf(const QUrl &url)
+{
+    if (!url.isLocalFile())
+        return 0;
+
+    struct stat st;
+    if (::lstat(QFile::encodeName(url.path()).constData(), &st) != 0)
+        return 0;
+    return st.st_dev;
+}
 /*!
  * \brief DoCopyFilesWorker::doHandleErrorAndWait Blocking handles errors and returns
  * actions supported by the operation
@@ -13,6 +13,8 @@
 
 #include <QObject>
 
+#include <sys/types.h>
+
 DPFILEOPERATIONS_BEGIN_NAMESPACE
 DFMBASE_USE_NAMESPACE
 class DoDeleteFilesWorker : public AbstractWorker
@@ -28,19 +30,24 @@ protected:
     bool doWork() override;
     void stop() override;
     void onUpdateProgress() override;
+    bool statisticsFilesSize() override;
+    void emitProgressChangedNotify(const qint64 &writSize) override;
 
 protected:
     bool deleteAllFiles();
     bool deleteFilesOnCanNotRemoveDevice();
     bool deleteFilesOnOtherDevice();
     bool deleteFileOnOtherDevice(const QUrl &url);
-    bool deleteDirOnOtherDevice(const FileInfoPointer &dir);
+    bool deleteDirOnOtherDevice(const FileInfoPointer &dir, dev_t rootDevice = 0);
+    static dev_t deviceOf(const QUrl &url);
+    bool waitWhilePaused();
     AbstractJobHandler::SupportAction doHandleErrorAndWait(const QUrl &from,
                                                            const AbstractJobHandler::JobErrorType &error,
                                                            const QString &errorMsg = QString());
 
 private:
     QAtomicInteger<qint64> deleteFilesCount { 0 };
+    QAtomicInteger<qint64> foundFilesCount { 0 };   // entries met by the local delete engine so far
 };
 DPFILEOPERATIONS_END_NAMESPACE
 
@@ -0,0 +1,316 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "localdeleteengine.h"
+
+#include <dfm-base/utils/fileutils.h>
+
+#include <QFile>
+#include <QtConcurrent>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <errno.h>
+#include <string.h>
+
+DPFILEOPERATIONS_USE_NAMESPACE
+DFMBASE_USE_NAMESPACE
+
+static constexpr int kMinDeleteThreadCount { 2 };
+static constexpr int kMaxDeleteThreadCount { 16 };
+static constexpr int kOpenDirFlags { O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC };
+static constexpr int kRemovedBatchSize { 256 };
+
+LocalDeleteEngine::LocalDeleteEngine(QAtomicInteger<qint64> *removedCount, StateChecker canContinue,
+                                     QAtomicInteger<qint64> *foundCount)
+    : removedCount(removedCount),
+      foundCount(foundCount),
+      canContinue(std::move(canContinue))
+{
+    pool.setMaxThreadCount(qBound(kMinDeleteThreadCount, FileUtils::getCpuProcessCount(), kMaxDeleteThreadCount));
+}
+
+LocalDeleteEngine::~LocalDeleteEngine()
+{
+    pool.waitForDone();
+}
+
+/*!
+ * \brief LocalDeleteEngine::remove Remove a local file or a whole directory tree
+ * Directories on other devices (mount points inside the tree) are never entered.
+ * \param path absolute local path
+ * \return true if the path does not exist anymore
+ */
+bool LocalDeleteEngine::remove(const QString &path)
+{
+    const QByteArray &nativePath = QFile::encodeName(path);
+    struct stat st;
+    if (::lstat(nativePath.constData(), &st) != 0) {
+        if (errno == ENOENT)
+            return true;
+        markFailed(nullptr, nativePath, errno);
+        return false;
+    }
+
+    if (foundCount)
+        foundCount->fetchAndAddOrdered(1);
+    if (!S_ISDIR(st.st_mode)) {
+        if (::unlink(nativePath.constData()) != 0) {
+            markFailed(nullptr, nativePath, errno);
+            return false;
+        }
+        markRemoved(nativePath);
+        flushRemoved();
+        return true;
+    }
+
+    const int fd = ::open(nativePath.constData(), kOpenDirFlags);
+    if (fd < 0) {
+        markFailed(nullptr, nativePath, errno);
+        return false;
+    }
+
+    rootDevice = st.st_dev;
+    {
+        QMutexLocker lk(&mutex);
+        rootDone = false;
+    }
+
+    DirNode *root = new DirNode;
+    root->path = nativePath;
+    walkDir(root, fd);
+
+    {
+        QMutexLocker lk(&mutex);
+        while (!rootDone)
+            rootFinished.wait(&mutex);
+    }
+    flushRemoved();
+
+    QMutexLocker lk(&mutex);
+    return rootRemoved;
+}
+
+/*!
+ * \brief LocalDeleteEngine::failedPaths Entries that could not be removed
+ * Only the first failing entry of a branch is listed, its ancestors are left in place silently.
+ */
+QStringList LocalDeleteEngine::failedPaths() const
+{
+    QMutexLocker lk(&mutex);
+    return failed;
+}
+
+void LocalDeleteEngine::setRemovedNotifier(RemovedNotifier notifier)
+{
+    removedNotifier = std::move(notifier);
+}
+
+/*!
+ * \brief LocalDeleteEngine::walkDir Walk a directory and the sub directories no pool thread took
+ * The sub directories walked by this thread are queued and opened again by path once their
+ * parent is closed, so a deep tree holds one directory fd per thread instead of one per level.
+ * \param node the directory, owned by the engine until finishDir removes it
+ * \param dirFd opened fd of the directory, taken over by this call
+ */
+void LocalDeleteEngine::walkDir(DirNode *node, int dirFd)
+{
+    QList<DirNode *> inlineDirs;
+    walkOneDir(node, dirFd, &inlineDirs);
+    while (!inlineDirs.isEmpty()) {
+        DirNode *child = inlineDirs.takeLast();
+        const int childFd = openInlineDir(child);
+        if (childFd >= 0)
+            walkOneDir(child, childFd, &inlineDirs);
+    }
+}
+
+/*!
+ * \brief LocalDeleteEngine::openInlineDir Open a queued sub directory by its path
+ * The device is checked again, the directory may have become a mount point meanwhile.
+ * \return the fd, -1 if the directory is finished already
+ */
+int LocalDeleteEngine::openInlineDir(DirNode *node)
+{
+    const int fd = ::open(node->path.constData(), kOpenDirFlags);
+    if (fd < 0) {
+        if (errno == ENOENT) {
+            DirNode *parent = node->parent;
+            delete node;
+            finishDir(parent);
+        } else {
+            markFailed(node, node->path, errno);
+            finishDir(node);
+        }
+        return -1;
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_dev != rootDevice) {
+        markFailed(node, node->path, EXDEV);
+        ::close(fd);
+        finishDir(node);
+        return -1;
+    }
+    return fd;
+}
+
+/*!
+ * \brief LocalDeleteEngine::walkOneDir Unlink the leaves of one directory and dispatch its sub directories
+ * Sub directories are handed to the pool while it has idle threads, the others are queued in inlineDirs.
+ * \param node the directory, owned by the engine until finishDir removes it
+ * \param dirFd opened fd of the directory, taken over by this call
+ */
+void LocalDeleteEngine::walkOneDir(DirNode *node, int dirFd, QList<DirNode *> *inlineDirs)
+{
+    DIR *dir = ::fdopendir(dirFd);
+    if (!dir) {
+        markFailed(node, node->path, errno);
+        ::close(dirFd);
+        finishDir(node);
+        return;
+    }
+
+    while (struct dirent *entry = ::readdir(dir)) {
+        if (!canContinue()) {
+            // stopped, leave the rest on disk without reporting it
+            node->failed = true;
+            break;
+        }
+
+        const char *name = entry->d_name;
+        if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')))
+            continue;
+
+        if (foundCount)
+            foundCount->fetchAndAddOrdered(1);
+        bool isDir = entry->d_type == DT_DIR;
+        if (entry->d_type == DT_UNKNOWN) {
+            struct stat st;
+            if (::fstatat(dirFd, name, &st, AT_SYMLINK_NOFOLLOW) != 0) {
+                if (errno != ENOENT)
+                    markFailed(node, node->path + '/' + name, errno);
+                continue;
+            }
+            isDir = S_ISDIR(st.st_mode);
+        }
+
+        if (!isDir) {
+            if (::unlinkat(dirFd, name, 0) == 0)
+                markRemoved(node->path + '/' + name);
+            else if (errno != ENOENT)
+                markFailed(node, node->path + '/' + name, errno);
+            continue;
+        }
+
+        const int childFd = ::openat(dirFd, name, kOpenDirFlags);
+        if (childFd < 0) {
+            if (errno != ENOENT)
+                markFailed(node, node->path + '/' + name, errno);
+            continue;
+        }
+
+        struct stat st;
+        if (::fstat(childFd, &st) != 0 || st.st_dev != rootDevice) {
+            markFailed(node, node->path + '/' + name, EXDEV);
+            ::close(childFd);
+            continue;
+        }
+
+        DirNode *child = new DirNode;
+        child->parent = node;
+        child->path = node->path + '/' + name;
+        ++node->pending;
+
+        if (pool.activeThreadCount() < pool.maxThreadCount()) {
+            QtConcurrent::run(&pool, [this, child, childFd]() { walkDir(child, childFd); });
+        } else {
+            ::close(childFd);
+            inlineDirs->append(child);
+        }
+    }
+
+    ::closedir(dir);
+    finishDir(node);
+}
+
+/*!
+ * \brief LocalDeleteEngine::finishDir Drop one pending reference of the directory
+ * The thread dropping the last one removes the directory and continues with the parent,
+ * so no thread ever blocks waiting for a sub tree.
+ */
+void LocalDeleteEngine::finishDir(DirNode *node)
+{
+    while (node) {
+        if (node->pending.fetch_sub(1) != 1)
+            return;
+
+        bool removed = !node->failed;
+        if (removed) {
+            if (::rmdir(node->path.constData()) == 0) {
+                markRemoved(node->path);
+            } else {
+                markFailed(node, node->path, errno);
+                removed = false;
+            }
+        }
+
+        DirNode *parent = node->parent;
+        delete node;
+        if (!parent) {
+            QMutexLocker lk(&mutex);
+            rootRemoved = removed;
+            rootDone = true;
+            rootFinished.wakeAll();
+            return;
+        }
+
+        if (!removed)
+            parent->failed = true;
+        node = parent;
+    }
+}
+
+void LocalDeleteEngine::markFailed(DirNode *node, const QByteArray &path, int error)
+{
+    if (node)
+        node->failed = true;
+
+    fmWarning() << "Delete failed:" << QFile::decodeName(path) << strerror(error);
+    QMutexLocker lk(&mutex);
+    failed.append(QFile::decodeName(path));
+}
+
+void LocalDeleteEngine::markRemoved(const QByteArray &path)
+{
+    removedCount->fetchAndAddOrdered(1);
+    if (!removedNotifier)
+        return;
+
+    QStringList batch;
+    {
+        QMutexLocker lk(&mutex);
+        removed.append(QFile::decodeName(path));
+        if (removed.size() < kRemovedBatchSize)
+            return;
+        batch.swap(removed);
+    }
+    removedNotifier(batch);
+}
+
+void LocalDeleteEngine::flushRemoved()
+{
+    if (!removedNotifier)
+        return;
+
+    QStringList batch;
+    {
+        QMutexLocker lk(&mutex);
+        batch.swap(removed);
+    }
+    if (!batch.isEmpty())
+        removedNotifier(batch);
+}
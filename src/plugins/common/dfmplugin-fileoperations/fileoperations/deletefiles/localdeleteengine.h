@@ -0,0 +1,82 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef LOCALDELETEENGINE_H
+#define LOCALDELETEENGINE_H
+
+#include "dfmplugin_fileoperations_global.h"
+
+#include <QAtomicInteger>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QThreadPool>
+#include <QStringList>
+
+#include <functional>
+#include <atomic>
+
+#include <sys/types.h>
+
+DPFILEOPERATIONS_BEGIN_NAMESPACE
+
+/*!
+ * \brief The LocalDeleteEngine class removes local trees with the *at() syscalls.
+ * Leaves are unlinked relative to the fd of their directory, no file info is created for
+ * them. Sub directories are handed to a thread pool while it has idle threads and walked
+ * inline otherwise, a directory is removed by whichever thread finishes its last child.
+ * Entries that can not be removed stay on disk and are reported by failedPaths(), the
+ * caller decides how to tell the user. Every entry met by the walk is counted into
+ * foundCount, so no separate pass is needed to know the size of the tree. The removed paths
+ * are handed to the removed notifier in batches, from the thread that fills the batch.
+ */
+class LocalDeleteEngine
+{
+public:
+    using StateChecker = std::function<bool()>;
+    using RemovedNotifier = std::function<void(const QStringList &paths)>;
+
+    explicit LocalDeleteEngine(QAtomicInteger<qint64> *removedCount, StateChecker canContinue,
+                               QAtomicInteger<qint64> *foundCount = nullptr);
+    ~LocalDeleteEngine();
+
+    bool remove(const QString &path);
+    QStringList failedPaths() const;
+    void setRemovedNotifier(RemovedNotifier notifier);
+
+private:
+    struct DirNode
+    {
+        DirNode *parent { nullptr };
+        QByteArray path;
+        std::atomic_int pending { 1 };   // the walk of the dir itself plus every unfinished sub dir
+        std::atomic_bool failed { false };
+    };
+
+    void walkDir(DirNode *node, int dirFd);
+    void walkOneDir(DirNode *node, int dirFd, QList<DirNode *> *inlineDirs);
+    int openInlineDir(DirNode *node);
+    void finishDir(DirNode *node);
+    void markFailed(DirNode *node, const QByteArray &path, int error);
+    void markRemoved(const QByteArray &path);
+    void flushRemoved();
+
+private:
+    QAtomicInteger<qint64> *removedCount { nullptr };
+    QAtomicInteger<qint64> *foundCount { nullptr };
+    StateChecker canContinue;
+    RemovedNotifier removedNotifier;
+    QThreadPool pool;
+    dev_t rootDevice { 0 };
+
+    mutable QMutex mutex;
+    QWaitCondition rootFinished;
+    bool rootDone { false };
+    bool rootRemoved { false };
+    QStringList failed;
+    QStringList removed;   // removed paths not handed to the notifier yet
+};
+
+DPFILEOPERATIONS_END_NAMESPACE
+
+#endif   // LOCALDELETEENGINE_H
@@ -5,6 +5,8 @@
 #include "abstractworker.h"
 #include "workerdata.h"
 #include "errormessageandaction.h"
+#include "devicecopyadmission.h"
+#include "fileclonehelper.h"
 
 #include <dfm-base/utils/fileutils.h>
 #include <dfm-base/base/schemefactory.h>
@@ -29,8 +31,6 @@
 
 DPFILEOPERATIONS_USE_NAMESPACE
 
-std::atomic_bool AbstractWorker::bigFileCopy { false };
-
 /*!
  * \brief setWorkArgs 设置当前任务的参数
  * \param args 参数
@@ -247,6 +247,10 @@ bool AbstractWorker::statisticsFilesSize()
     if (isSourceFileLocal) {
         const QString &fsType = DFMIO::DFMUtils::fsTypeFromUrl(firstUrl);
         isSourceFileLocal = fsType.startsWith("ext");
+        // reflink filesystems are not "local" for the range copy, but their files can still be cloned
+        supportFileClone = FileCloneHelper::isCloneFsType(fsType) && this->targetUrl.isValid()
+                && FileOperationsUtils::isFileOnDisk(this->targetUrl)
+                && FileCloneHelper::isCloneFsType(DFMIO::DFMUtils::fsTypeFromUrl(this->targetUrl));
     }
 
     if (isSourceFileLocal) {
@@ -323,6 +327,12 @@ void AbstractWorker::endWork()
     info->insert(AbstractJobHandler::NotifyInfoKey::kCompleteTargetFilesKey, QVariant::fromValue(completeTargetFiles));
     info->insert(AbstractJobHandler::NotifyInfoKey::kCompleteCustomInfosKey, QVariant::fromValue(completeCustomInfos));
     info->insert(AbstractJobHandler::NotifyInfoKey::kJobHandlePointer, QVariant::fromValue(handle));
+    if (workData) {
+        QVariantMap copyWays;
+        copyWays.insert("cloned", workData->clonedFileCount.loadAcquire());
+        copyWays.insert("rangeCopied", workData->rangeCopiedFileCount.loadAcquire());
+        info->insert(AbstractJobHandler::NotifyInfoKey::kCopyWayStatisticsKey, copyWays);
+    }
 
     saveOperations();
 
@@ -333,6 +343,8 @@ void AbstractWorker::endWork()
              << "\n sources count: " << sourceUrls.count()
              << "\n target: " << targetUrl
              << "\n time elapsed: " << timeElapsed.elapsed()
+             << "\n cloned files: " << (workData ? workData->clonedFileCount.loadAcquire() : 0)
+             << "\n range copied files: " << (workData ? workData->rangeCopiedFileCount.loadAcquire() : 0)
              << "\n";
     fmDebug() << "\n sources urls: " << sourceUrls;
     if (statisticsFilesSizeJob) {
@@ -484,12 +496,16 @@ void AbstractWorker::pauseAllThread()
 
 void AbstractWorker::stopAllThread()
 {
+    if (copyScheduler)
+        copyScheduler->stop();
     if (copyOtherFileWorker)
         copyOtherFileWorker->stop();
     for (auto worker : threadCopyWorker) {
         worker->stop();
     }
     stop();
+    // let this job leave the big file copy queue
+    DeviceCopyAdmission::instance()->wakeWaiters();
 }
 
 void AbstractWorker::checkRetry()
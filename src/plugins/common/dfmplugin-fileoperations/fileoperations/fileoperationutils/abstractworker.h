@@ -9,6 +9,7 @@
 #include "fileoperationsutils.h"
 #include "workerdata.h"
 #include "docopyfileworker.h"
+#include "copytaskscheduler.h"
 
 #include <dfm-base/interfaces/abstractjobhandler.h>
 #include <dfm-base/file/local/localfilehandler.h>
@@ -175,6 +176,7 @@ public:
     bool isTargetFileLocal { false };   // target file on local device
     bool supportSetPermission { true };   // source file on mtp
     bool supportDfmioCopy { true };   // source file on mtp
+    bool supportFileClone { false };   // source and target on filesystems that can share extents
     bool isTargetFileExBlock { false };   // target file on extra block device
     bool isConvert { false };   // is convert operation
     QSharedPointer<WorkerData> workData { nullptr };
@@ -187,8 +189,7 @@ public:
     QVector<QSharedPointer<DoCopyFileWorker>> threadCopyWorker;
     int threadCount { 8 };
     std::atomic_bool retry { false };
-    QSharedPointer<QThreadPool> threadPool { nullptr };
-    static std::atomic_bool bigFileCopy;
+    QSharedPointer<CopyTaskScheduler> copyScheduler { nullptr };   // dispatch small files to threadCopyWorker
     QAtomicInteger<qint64> bigFileSize { 0 };   // bigger than this is big file
     QElapsedTimer *speedtimer { nullptr };   // time eslape
     std::atomic_int64_t elapsed { 0 };
@@ -0,0 +1,198 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "copybufferpipeline.h"
+
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include <atomic>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+DPFILEOPERATIONS_USE_NAMESPACE
+
+static constexpr int kMaxReaderThreadCount { 64 };
+// buffers of all pipelines in the process, copies beyond it use a single buffer
+static constexpr qint64 kMaxPipelineMemory { 64 * 1024 * 1024 };
+static std::atomic<qint64> pipelineMemory { 0 };
+
+static QThreadPool *readerPool()
+{
+    // readers block on io, keep them away from the global pool
+    static QThreadPool pool;
+    static const bool inited = []() {
+        pool.setMaxThreadCount(kMaxReaderThreadCount);
+        return true;
+    }();
+    Q_UNUSED(inited)
+    return &pool;
+}
+
+CopyBufferPipeline::CopyBufferPipeline(const int blockCount, const qint64 blockSize)
+    : bufferSize(blockSize)
+{
+    // fall back to fewer blocks, then to no pipeline at all when the budget is used up
+    int count = qMax(2, blockCount);
+    while (count >= 2 && (reservedMemory = reserveMemory(count, blockSize)) == 0)
+        --count;
+    if (reservedMemory == 0) {
+        allocated = false;
+        return;
+    }
+
+    const long pageSize = sysconf(_SC_PAGESIZE);
+    const size_t alignment = static_cast<size_t>(pageSize > 0 ? pageSize : 4096);
+    blocks.resize(count);
+    for (auto &block : blocks) {
+        void *data = nullptr;
+        if (posix_memalign(&data, alignment, static_cast<size_t>(blockSize)) != 0) {
+            fmWarning() << "alloc copy buffer failed, size: " << blockSize;
+            allocated = false;
+            break;
+        }
+        block.data = static_cast<char *>(data);
+        freeBlocks.enqueue(&block);
+    }
+}
+
+CopyBufferPipeline::~CopyBufferPipeline()
+{
+    cancel();
+    for (auto &block : blocks)
+        free(block.data);
+    pipelineMemory -= reservedMemory;
+}
+
+qint64 CopyBufferPipeline::maxTotalMemory()
+{
+    return kMaxPipelineMemory;
+}
+
+/*!
+ * \brief CopyBufferPipeline::reserveMemory Take the buffer memory of a pipeline from the process wide budget
+ * \return the reserved bytes, 0 if the budget can not hold them
+ */
+qint64 CopyBufferPipeline::reserveMemory(const int blockCount, const qint64 blockSize)
+{
+    const qint64 size = blockCount * blockSize;
+    qint64 used = pipelineMemory.load();
+    do {
+        if (size <= 0 || used + size > kMaxPipelineMemory)
+            return 0;
+    } while (!pipelineMemory.compare_exchange_weak(used, used + size));
+    return size;
+}
+
+bool CopyBufferPipeline::isValid() const
+{
+    return allocated;
+}
+
+qint64 CopyBufferPipeline::blockSize() const
+{
+    return bufferSize;
+}
+
+/*!
+ * \brief CopyBufferPipeline::start Start the reader stage
+ * \param read reads the next chunk of the source, called on the reader thread only
+ * \param startOffset current position of the source
+ * \param totalSize size of the source, the reader stops there
+ */
+void CopyBufferPipeline::start(ReadFunc read, const qint64 startOffset, const qint64 totalSize)
+{
+    {
+        QMutexLocker lk(&mutex);
+        readerFinished = false;
+        canceled = false;
+    }
+    readerFuture = QtConcurrent::run(readerPool(), [this, read, startOffset, totalSize]() {
+        readLoop(read, startOffset, totalSize);
+    });
+}
+
+/*!
+ * \brief CopyBufferPipeline::takeFilled Wait for the next block in source order
+ * \return nullptr when the reader reached the end of the source or was canceled
+ */
+CopyBufferPipeline::Block *CopyBufferPipeline::takeFilled()
+{
+    QMutexLocker lk(&mutex);
+    while (filledBlocks.isEmpty() && !readerFinished && !canceled)
+        filledAvailable.wait(&mutex);
+    if (filledBlocks.isEmpty())
+        return nullptr;
+    return filledBlocks.dequeue();
+}
+
+void CopyBufferPipeline::recycle(Block *block)
+{
+    if (!block)
+        return;
+    {
+        QMutexLocker lk(&mutex);
+        block->size = 0;
+        freeBlocks.enqueue(block);
+    }
+    freeAvailable.wakeOne();
+}
+
+/*!
+ * \brief CopyBufferPipeline::cancel Stop the reader and wait for it, the read in flight is finished first
+ */
+void CopyBufferPipeline::cancel()
+{
+    {
+        QMutexLocker lk(&mutex);
+        canceled = true;
+    }
+    freeAvailable.wakeAll();
+    filledAvailable.wakeAll();
+    readerFuture.waitForFinished();
+
+    QMutexLocker lk(&mutex);
+    while (!filledBlocks.isEmpty()) {
+        auto block = filledBlocks.dequeue();
+        block->size = 0;
+        freeBlocks.enqueue(block);
+    }
+}
+
+void CopyBufferPipeline::readLoop(ReadFunc read, qint64 offset, const qint64 totalSize)
+{
+    Q_FOREVER {
+        Block *block = nullptr;
+        {
+            QMutexLocker lk(&mutex);
+            while (freeBlocks.isEmpty() && !canceled)
+                freeAvailable.wait(&mutex);
+            if (canceled)
+                break;
+            block = freeBlocks.dequeue();
+        }
+
+        const qint64 size = read(block->data, qMin(bufferSize, totalSize - offset));
+        block->size = size;
+        block->offset = offset;
+        if (size > 0)
+            offset += size;
+
+        bool stop = size <= 0 || offset >= totalSize;
+        {
+            QMutexLocker lk(&mutex);
+            filledBlocks.enqueue(block);
+            if (stop)
+                readerFinished = true;
+        }
+        filledAvailable.wakeOne();
+        if (stop)
+            break;
+    }
+
+    QMutexLocker lk(&mutex);
+    readerFinished = true;
+    filledAvailable.wakeAll();
+}
@@ -0,0 +1,75 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef COPYBUFFERPIPELINE_H
+#define COPYBUFFERPIPELINE_H
+
+#include "dfmplugin_fileoperations_global.h"
+
+#include <QFuture>
+#include <QMutex>
+#include <QQueue>
+#include <QVector>
+#include <QWaitCondition>
+
+#include <functional>
+
+DPFILEOPERATIONS_BEGIN_NAMESPACE
+
+/*!
+ * \brief The CopyBufferPipeline class overlaps reading the source with writing the target.
+ * A reader stage fills a ring of page aligned buffers on a pool thread while the copy thread
+ * takes the filled buffers in order, writes them and hands them back. The reader stops on
+ * the first short or failed read, the consumer gets that block and decides what to do, so
+ * all error handling stays in the copy thread.
+ */
+class CopyBufferPipeline
+{
+    Q_DISABLE_COPY(CopyBufferPipeline)
+
+public:
+    using ReadFunc = std::function<qint64(char *data, const qint64 maxSize)>;
+
+    struct Block
+    {
+        char *data { nullptr };
+        qint64 size { 0 };   // bytes read, <= 0 when the read failed or hit an early end of file
+        qint64 offset { 0 };   // source offset of data
+    };
+
+    CopyBufferPipeline(const int blockCount, const qint64 blockSize);
+    ~CopyBufferPipeline();
+
+    static qint64 maxTotalMemory();
+
+    bool isValid() const;
+    qint64 blockSize() const;
+
+    void start(ReadFunc read, const qint64 startOffset, const qint64 totalSize);
+    Block *takeFilled();
+    void recycle(Block *block);
+    void cancel();
+
+private:
+    static qint64 reserveMemory(const int blockCount, const qint64 blockSize);
+    void readLoop(ReadFunc read, qint64 offset, const qint64 totalSize);
+
+private:
+    QVector<Block> blocks;
+    QQueue<Block *> freeBlocks;
+    QQueue<Block *> filledBlocks;
+    QMutex mutex;
+    QWaitCondition freeAvailable;
+    QWaitCondition filledAvailable;
+    QFuture<void> readerFuture;
+    qint64 bufferSize { 0 };
+    qint64 reservedMemory { 0 };
+    bool allocated { true };
+    bool readerFinished { true };
+    bool canceled { false };
+};
+
+DPFILEOPERATIONS_END_NAMESPACE
+
+#endif   // COPYBUFFERPIPELINE_H
@@ -0,0 +1,189 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "copytaskscheduler.h"
+
+#include <dfm-base/utils/fileutils.h>
+
+#include <QtConcurrent>
+
+DPFILEOPERATIONS_USE_NAMESPACE
+DFMBASE_USE_NAMESPACE
+
+static constexpr int kMinCopyWorkerCount { 2 };
+static constexpr int kMaxCopyWorkerCount { 32 };
+static constexpr qint64 kSmallFileAverageSize { 1024 * 1024 };
+static constexpr qint64 kBytesPerWorker { 64 * 1024 * 1024 };
+
+CopyTaskScheduler::CopyTaskScheduler(const int workerCount, Executor executor)
+    : executor(std::move(executor))
+{
+    const int count = qMax(1, workerCount);
+    queues.resize(count);
+    pool.setMaxThreadCount(count);
+    for (int i = 0; i < count; ++i)
+        QtConcurrent::run(&pool, [this, i]() { workerLoop(i); });
+}
+
+CopyTaskScheduler::~CopyTaskScheduler()
+{
+    {
+        QMutexLocker lk(&mutex);
+        quit = true;
+    }
+    taskAvailable.wakeAll();
+    pool.waitForDone();
+}
+
+/*!
+ * \brief CopyTaskScheduler::suggestedWorkerCount Size the worker set by the job volume
+ * Many small files are bound by metadata latency and profit from more workers than cores,
+ * few large files are bound by the device bandwidth and only need enough workers to keep
+ * it busy.
+ * \param fileCount count of all files in the job
+ * \param totalSize size of all files in the job
+ * \return worker count
+ */
+int CopyTaskScheduler::suggestedWorkerCount(const qint64 fileCount, const qint64 totalSize)
+{
+    if (fileCount <= 1)
+        return 1;
+
+    const int cores = qMax(1, FileUtils::getCpuProcessCount());
+    const qint64 averageSize = totalSize / fileCount;
+    qint64 count = 0;
+    if (averageSize <= kSmallFileAverageSize)
+        count = cores * 2;
+    else
+        count = qMin<qint64>(cores, totalSize / kBytesPerWorker + 1);
+
+    count = qBound<qint64>(kMinCopyWorkerCount, count, kMaxCopyWorkerCount);
+    return static_cast<int>(qMin(count, fileCount));
+}
+
+void CopyTaskScheduler::submit(const CopyTask &task)
+{
+    {
+        QMutexLocker lk(&mutex);
+        if (quit)
+            return;
+        auto &queue = queues[leastLoadedQueue()];
+        queue.tasks.append(task);
+        queue.pendingBytes += task.size;
+        ++pendingTasks;
+    }
+    taskAvailable.wakeOne();
+}
+
+/*!
+ * \brief CopyTaskScheduler::waitForIdle Block until every submitted task has finished
+ */
+void CopyTaskScheduler::waitForIdle()
+{
+    QMutexLocker lk(&mutex);
+    while (pendingTasks > 0 || runningTasks > 0)
+        allIdle.wait(&mutex);
+}
+
+/*!
+ * \brief CopyTaskScheduler::stop Drop the tasks not started yet, running tasks finish by themselves
+ */
+void CopyTaskScheduler::stop()
+{
+    {
+        QMutexLocker lk(&mutex);
+        for (auto &queue : queues) {
+            queue.tasks.clear();
+            queue.pendingBytes = 0;
+        }
+        pendingTasks = 0;
+        if (runningTasks == 0)
+            allIdle.wakeAll();
+    }
+    taskAvailable.wakeAll();
+}
+
+int CopyTaskScheduler::workerCount() const
+{
+    return queues.count();
+}
+
+qint64 CopyTaskScheduler::pendingCount()
+{
+    QMutexLocker lk(&mutex);
+    return pendingTasks;
+}
+
+void CopyTaskScheduler::workerLoop(const int index)
+{
+    CopyTask task;
+    Q_FOREVER {
+        {
+            QMutexLocker lk(&mutex);
+            while (!quit && !takeTask(index, &task))
+                taskAvailable.wait(&mutex);
+            if (quit)
+                return;
+            ++runningTasks;
+        }
+
+        executor(index, task);
+        task = CopyTask();
+
+        QMutexLocker lk(&mutex);
+        --runningTasks;
+        if (pendingTasks == 0 && runningTasks == 0)
+            allIdle.wakeAll();
+    }
+}
+
+// call with mutex held
+bool CopyTaskScheduler::takeTask(const int index, CopyTask *task)
+{
+    auto &own = queues[index];
+    if (!own.tasks.isEmpty()) {
+        *task = own.tasks.takeFirst();
+        own.pendingBytes -= task->size;
+        --pendingTasks;
+        return true;
+    }
+
+    // steal the most recently queued task of the busiest worker
+    const int victim = mostLoadedQueue(index);
+    if (victim < 0)
+        return false;
+
+    auto &other = queues[victim];
+    *task = other.tasks.takeLast();
+    other.pendingBytes -= task->size;
+    --pendingTasks;
+    return true;
+}
+
+// call with mutex held
+int CopyTaskScheduler::leastLoadedQueue() const
+{
+    int index = 0;
+    for (int i = 1; i < queues.count(); ++i) {
+        const auto &queue = queues.at(i);
+        const auto &least = queues.at(index);
+        if (queue.pendingBytes < least.pendingBytes
+            || (queue.pendingBytes == least.pendingBytes && queue.tasks.count() < least.tasks.count()))
+            index = i;
+    }
+    return index;
+}
+
+// call with mutex held
+int CopyTaskScheduler::mostLoadedQueue(const int except) const
+{
+    int index = -1;
+    for (int i = 0; i < queues.count(); ++i) {
+        if (i == except || queues.at(i).tasks.isEmpty())
+            continue;
+        if (index < 0 || queues.at(i).pendingBytes > queues.at(index).pendingBytes)
+            index = i;
+    }
+    return index;
+}
@@ -0,0 +1,78 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef COPYTASKSCHEDULER_H
+#define COPYTASKSCHEDULER_H
+
+#include "dfmplugin_fileoperations_global.h"
+#include "workerdata.h"
+
+#include <QList>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QThreadPool>
+
+#include <functional>
+
+DPFILEOPERATIONS_BEGIN_NAMESPACE
+
+struct CopyTask
+{
+    DFileInfoPointer fromInfo { nullptr };
+    DFileInfoPointer toInfo { nullptr };
+    qint64 size { 0 };
+};
+
+/*!
+ * \brief The CopyTaskScheduler class dispatches small file copies to a fixed set of workers.
+ * Every worker owns a deque, it takes tasks from the front of its own deque and, when that
+ * is empty, steals from the back of the deque holding the most pending bytes. One worker
+ * stuck on a slow file therefore never blocks the files queued behind it.
+ * The executor is always called with the same worker index from the same pool thread, so
+ * per worker state (error waiting, pause) stays bound to one thread.
+ */
+class CopyTaskScheduler
+{
+public:
+    using Executor = std::function<void(const int worker, const CopyTask &task)>;
+
+    explicit CopyTaskScheduler(const int workerCount, Executor executor);
+    ~CopyTaskScheduler();
+
+    static int suggestedWorkerCount(const qint64 fileCount, const qint64 totalSize);
+
+    void submit(const CopyTask &task);
+    void waitForIdle();
+    void stop();
+
+    int workerCount() const;
+    qint64 pendingCount();
+
+private:
+    struct WorkerQueue
+    {
+        QList<CopyTask> tasks;
+        qint64 pendingBytes { 0 };
+    };
+
+    void workerLoop(const int index);
+    bool takeTask(const int index, CopyTask *task);
+    int leastLoadedQueue() const;
+    int mostLoadedQueue(const int except) const;
+
+private:
+    Executor executor;
+    QThreadPool pool;
+    QVector<WorkerQueue> queues;
+    QMutex mutex;   // guards queues and the counters below, tasks are tiny so one lock is enough
+    QWaitCondition taskAvailable;
+    QWaitCondition allIdle;
+    qint64 pendingTasks { 0 };
+    int runningTasks { 0 };
+    bool quit { false };
+};
+
+DPFILEOPERATIONS_END_NAMESPACE
+
+#endif   // COPYTASKSCHEDULER_H
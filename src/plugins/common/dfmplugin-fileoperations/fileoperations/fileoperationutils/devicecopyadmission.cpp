@@ -0,0 +1,99 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "devicecopyadmission.h"
+
+#include <QFile>
+#include <QFileInfo>
+
+#include <sys/stat.h>
+
+DPFILEOPERATIONS_USE_NAMESPACE
+
+// one big file copy per device, interleaving several of them makes rotational disks seek back and forth
+static constexpr int kMaxCopiesPerDevice { 1 };
+
+DeviceCopyAdmission *DeviceCopyAdmission::instance()
+{
+    static DeviceCopyAdmission ins;
+    return &ins;
+}
+
+/*!
+ * \brief DeviceCopyAdmission::devicesOf Get the block devices a copy reads from and writes to
+ * The target file may not exist yet, so its parent directory is used.
+ * \param from source file url
+ * \param to target file url
+ * \return distinct device ids, empty when none of them can be resolved
+ */
+DeviceCopyAdmission::Devices DeviceCopyAdmission::devicesOf(const QUrl &from, const QUrl &to)
+{
+    Devices devices;
+    struct stat st;
+    if (::stat(QFile::encodeName(from.path()).constData(), &st) == 0)
+        devices.append(st.st_dev);
+
+    const QString &targetDir = QFileInfo(to.path()).absolutePath();
+    if (::stat(QFile::encodeName(targetDir).constData(), &st) == 0 && !devices.contains(st.st_dev))
+        devices.append(st.st_dev);
+
+    return devices;
+}
+
+/*!
+ * \brief DeviceCopyAdmission::acquire Block until all devices have a free big file copy slot
+ * All slots are taken at once, so two copies in opposite directions can not deadlock.
+ * \param devices devices from devicesOf
+ * \param isCanceled checked every time the waiter wakes up
+ * \return false if canceled while waiting
+ */
+bool DeviceCopyAdmission::acquire(const Devices &devices, const std::function<bool()> &isCanceled)
+{
+    QMutexLocker lk(&mutex);
+    while (!canAdmit(devices)) {
+        if (isCanceled && isCanceled())
+            return false;
+        released.wait(&mutex);
+    }
+    if (isCanceled && isCanceled())
+        return false;
+
+    for (const auto dev : devices)
+        ++activeCopies[dev];
+    return true;
+}
+
+void DeviceCopyAdmission::release(const Devices &devices)
+{
+    {
+        QMutexLocker lk(&mutex);
+        for (const auto dev : devices) {
+            auto it = activeCopies.find(dev);
+            if (it == activeCopies.end())
+                continue;
+            if (--it.value() <= 0)
+                activeCopies.erase(it);
+        }
+    }
+    released.wakeAll();
+}
+
+/*!
+ * \brief DeviceCopyAdmission::wakeWaiters Let waiters re-check their cancel state, used when a job stops
+ */
+void DeviceCopyAdmission::wakeWaiters()
+{
+    QMutexLocker lk(&mutex);
+    released.wakeAll();
+}
+
+// call with mutex held
+bool DeviceCopyAdmission::canAdmit(const Devices &devices) const
+{
+    for (const auto dev : devices) {
+        if (activeCopies.value(dev, 0) >= kMaxCopiesPerDevice)
+            return false;
+    }
+    return true;
+}
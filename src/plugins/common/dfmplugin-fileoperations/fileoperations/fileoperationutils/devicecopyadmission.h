@@ -0,0 +1,54 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DEVICECOPYADMISSION_H
+#define DEVICECOPYADMISSION_H
+
+#include "dfmplugin_fileoperations_global.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QUrl>
+#include <QVector>
+#include <QWaitCondition>
+
+#include <functional>
+
+#include <sys/types.h>
+
+DPFILEOPERATIONS_BEGIN_NAMESPACE
+
+/*!
+ * \brief The DeviceCopyAdmission class limits concurrent big file copies per block device.
+ * A big file copy holds the devices of its source and its target. Copies between independent
+ * devices run in parallel, copies sharing a device wait until the device is released.
+ * It is shared by all copy jobs of the process.
+ */
+class DeviceCopyAdmission
+{
+    Q_DISABLE_COPY(DeviceCopyAdmission)
+
+public:
+    using Devices = QVector<dev_t>;
+
+    static DeviceCopyAdmission *instance();
+    static Devices devicesOf(const QUrl &from, const QUrl &to);
+
+    bool acquire(const Devices &devices, const std::function<bool()> &isCanceled);
+    void release(const Devices &devices);
+    void wakeWaiters();
+
+private:
+    DeviceCopyAdmission() = default;
+    bool canAdmit(const Devices &devices) const;
+
+private:
+    QMutex mutex;
+    QWaitCondition released;
+    QHash<dev_t, int> activeCopies;
+};
+
+DPFILEOPERATIONS_END_NAMESPACE
+
+#endif   // DEVICECOPYADMISSION_H
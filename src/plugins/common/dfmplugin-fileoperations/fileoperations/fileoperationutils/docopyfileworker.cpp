@@ -3,6 +3,8 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "docopyfileworker.h"
+#include "copybufferpipeline.h"
+#include "fileclonehelper.h"
 
 #include <dfm-base/utils/fileutils.h>
 #include <dfm-base/base/device/deviceutils.h>
@@ -19,10 +21,16 @@
 #include <QThread>
 
 #include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
 #include <zlib.h>
 #include <sys/mman.h>
 
 static const quint32 kMaxBufferLength { 1024 * 1024 * 1 };
+static const quint32 kLocalBufferLength { 1024 * 1024 * 4 };
+static const qint64 kRangeCopyChunkLength { 1024 * 1024 * 32 };
+static const int kPipelineBlockCount { 4 };
+static const int kPipelineMinBlocks { 2 };
 
 DPFILEOPERATIONS_USE_NAMESPACE
 USING_IO_NAMESPACE
@@ -238,41 +246,79 @@ DoCopyFileWorker::NextDo DoCopyFileWorker::doCopyFilePractically(const DFileInfo
     auto toIsSmb = DeviceUtils::isSamba(toInfo->uri());
     if (workData->exBlockSyncEveryWrite || toIsSmb)
         toFd = open(toInfo->uri().path().toUtf8().toStdString().data(), O_RDONLY);
-    qint64 blockSize = fromSize > kMaxBufferLength ? kMaxBufferLength : fromSize;
-    char *data = new char[static_cast<uint>(blockSize + 1)];
+    const qint64 bufferSize = copyBufferSize(toInfo);
+    qint64 blockSize = fromSize > bufferSize ? bufferSize : fromSize;
     uLong sourceCheckSum = adler32(0L, nullptr, 0);
-    qint64 sizeRead = 0;
-
-    do {
-        auto nextReadDo = doReadFile(fromInfo, toInfo, fromDevice, data, blockSize, sizeRead, skip);
-        if (nextReadDo != NextDo::kDoCopyCurrentFile) {
-            delete[] data;
-            data = nullptr;
-            if (toFd > 0)
-                close(toFd);
-            return nextReadDo;
-        }
-        auto nextDo = doWriteFile(fromInfo, toInfo, toDevice, fromDevice, data, sizeRead, skip);
-        if (nextDo != NextDo::kDoCopyCurrentFile) {
-            delete[] data;
-            data = nullptr;
-            if (toFd > 0)
-                close(toFd);
-            return nextDo;
-        }
+    writtenCheckSum = adler32(0L, nullptr, 0);
+    writtenSize = fromDevice->pos();
+    const bool checkIntegrity = workData->jobFlags.testFlag(AbstractJobHandler::JobFlag::kCopyIntegrityChecking);
+    const bool syncEveryWrite = (workData->exBlockSyncEveryWrite || toIsSmb) && toFd > 0;
+
+    // read the next blocks while the current one is written, a file of one or two blocks
+    // gains nothing from the overlap and is copied with a single buffer
+    QScopedPointer<CopyBufferPipeline> pipeline;
+    if (fromSize > kPipelineMinBlocks * blockSize)
+        pipeline.reset(new CopyBufferPipeline(kPipelineBlockCount, blockSize));
+    NextDo nextDo { NextDo::kDoCopyCurrentFile };
+    if (pipeline && pipeline->isValid()) {
+        pipeline->start([fromDevice](char *data, const qint64 maxSize) { return fromDevice->read(data, maxSize); },
+                       fromDevice->pos(), fromSize);
+        qint64 copiedSize = fromDevice->pos();
+        while (copiedSize != fromSize && nextDo == NextDo::kDoCopyCurrentFile) {
+            if (Q_UNLIKELY(!stateCheck())) {
+                nextDo = NextDo::kDoCopyErrorAddCancel;
+                break;
+            }
+            auto block = pipeline->takeFilled();
+            if (!block) {
+                // the reader stopped before the file info size, report it as an empty read
+                nextDo = checkReadResult(fromInfo, toInfo, fromDevice, 0, copiedSize, skip);
+                break;
+            }
+            nextDo = checkReadResult(fromInfo, toInfo, fromDevice, block->size, block->offset, skip);
+            if (nextDo == NextDo::kDoCopyCurrentFile && block->size > 0) {
+                nextDo = doWriteBlock(fromInfo, toInfo, toDevice, block->data, block->size, block->offset, skip);
+                if (nextDo == NextDo::kDoCopyCurrentFile && Q_LIKELY(checkIntegrity))
+                    sourceCheckSum = adler32(sourceCheckSum, reinterpret_cast<Bytef *>(block->data), static_cast<uInt>(block->size));
+                copiedSize = block->offset + block->size;
+            } else if (nextDo == NextDo::kDoCopyCurrentFile) {
+                // a short file ends here, same as an empty read at the end of file
+                copiedSize = fromSize;
+            }
+            pipeline->recycle(block);
 
-        if (Q_LIKELY(workData->jobFlags.testFlag(AbstractJobHandler::JobFlag::kCopyIntegrityChecking))) {
-            sourceCheckSum = adler32(sourceCheckSum, reinterpret_cast<Bytef *>(data), static_cast<uInt>(sizeRead));
+            // 执行同步策略
+            if (syncEveryWrite)
+                syncfs(toFd);
         }
+        pipeline->cancel();
+    } else {
+        char *data = new char[static_cast<uint>(blockSize + 1)];
+        qint64 sizeRead = 0;
+        do {
+            nextDo = doReadFile(fromInfo, toInfo, fromDevice, data, blockSize, sizeRead, skip);
+            if (nextDo != NextDo::kDoCopyCurrentFile)
+                break;
+            nextDo = doWriteFile(fromInfo, toInfo, toDevice, fromDevice, data, sizeRead, skip);
+            if (nextDo != NextDo::kDoCopyCurrentFile)
+                break;
 
-        // 执行同步策略
-        if ((workData->exBlockSyncEveryWrite || toIsSmb) && toFd > 0)
-            syncfs(toFd);
+            if (Q_LIKELY(checkIntegrity))
+                sourceCheckSum = adler32(sourceCheckSum, reinterpret_cast<Bytef *>(data), static_cast<uInt>(sizeRead));
 
-    } while (fromDevice->pos() != fromSize);
+            // 执行同步策略
+            if (syncEveryWrite)
+                syncfs(toFd);
+        } while (fromDevice->pos() != fromSize);
+        delete[] data;
+        data = nullptr;
+    }
 
-    delete[] data;
-    data = nullptr;
+    if (nextDo != NextDo::kDoCopyCurrentFile) {
+        if (toFd > 0)
+            close(toFd);
+        return nextDo;
+    }
 
     // 执行同步策略
     if ((workData->exBlockSyncEveryWrite  || toIsSmb) && toFd > 0)
@@ -297,6 +343,63 @@ DoCopyFileWorker::NextDo DoCopyFileWorker::doCopyFilePractically(const DFileInfo
     return NextDo::kDoCopyNext;
 }
 
+/*!
+ * \brief DoCopyFileWorker::doCloneFile Make the target share the data blocks of the source
+ * Errors are not reported here, the caller falls back to a normal copy which reports them.
+ * \param fromInfo
+ * \param toInfo
+ * \return true if the file is cloned and nothing is left to copy
+ */
+bool DoCopyFileWorker::doCloneFile(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo)
+{
+    if (isStopped())
+        return false;
+    auto fromSize = fromInfo->attribute(DFileInfo::AttributeID::kStandardSize).toLongLong();
+    if (fromSize <= 0)
+        return false;
+
+    int sourceFd = open(QFile::encodeName(fromInfo->uri().path()).constData(), O_RDONLY | O_CLOEXEC);
+    if (sourceFd < 0)
+        return false;
+    FinallyUtil releaseSc([&] {
+        close(sourceFd);
+    });
+
+    // the target lives on the device of its parent, do not create it for a pair that can not clone
+    const QByteArray &targetPath = QFile::encodeName(toInfo->uri().path());
+    const QByteArray &targetDir = QFile::encodeName(UrlRoute::urlParent(toInfo->uri()).path());
+    struct stat sourceStat;
+    struct stat targetDirStat;
+    if (fstat(sourceFd, &sourceStat) != 0 || stat(targetDir.constData(), &targetDirStat) != 0
+        || FileCloneHelper::isKnownUnsupported(sourceStat.st_dev, targetDirStat.st_dev))
+        return false;
+
+    bool created = true;
+    int targetFd = open(targetPath.constData(), O_CREAT | O_EXCL | O_WRONLY | O_CLOEXEC, 0666);
+    if (targetFd < 0 && errno == EEXIST) {
+        created = false;
+        targetFd = open(targetPath.constData(), O_WRONLY | O_TRUNC | O_CLOEXEC);
+    }
+    if (targetFd < 0)
+        return false;
+
+    const bool cloned = FileCloneHelper::cloneFile(sourceFd, targetFd) == FileCloneHelper::CloneResult::kCloned;
+    close(targetFd);
+    if (!cloned) {
+        // the fallback copy creates the target again, do not leave an empty file if it is skipped
+        if (created)
+            unlink(targetPath.constData());
+        return false;
+    }
+
+    emit currentTask(fromInfo->uri(), toInfo->uri());
+    workData->currentWriteSize += fromSize;
+    workData->clonedFileCount++;
+    setTargetPermissions(fromInfo->uri(), toInfo->uri());
+    FileUtils::notifyFileChangeManual(DFMBASE_NAMESPACE::Global::FileNotifyType::kFileAdded, toInfo->uri());
+    return true;
+}
+
 /*!
  * \brief DoCopyFileWorker::doCopyFileByRange
  * \param fromInfo
@@ -335,9 +438,11 @@ DoCopyFileWorker::NextDo DoCopyFileWorker::doCopyFileByRange(const DFileInfoPoin
             syncfs(targetFd);
         return NextDo::kDoCopyNext;
     }
-    // 循环读取和写入文件，拷贝
     auto toIsSmb = DeviceUtils::isSamba(toInfo->uri());
-    size_t blockSize = static_cast<size_t>(fromSize > kMaxBufferLength ? kMaxBufferLength : fromSize);
+    const bool syncEveryWrite = workData->exBlockSyncEveryWrite || toIsSmb;
+    // 循环读取和写入文件，拷贝
+    const qint64 chunkSize = syncEveryWrite ? kMaxBufferLength : kRangeCopyChunkLength;
+    size_t blockSize = static_cast<size_t>(fromSize > chunkSize ? chunkSize : fromSize);
     off_t offset_in = 0;
     off_t offset_out = 0;
     ssize_t result = -1;
@@ -366,12 +471,13 @@ DoCopyFileWorker::NextDo DoCopyFileWorker::doCopyFileByRange(const DFileInfoPoin
         if (!actionOperating(action, fromSize - offset_out, skip))
             return  NextDo::kDoCopyErrorAddCancel;
         // 执行同步策略
-        if (workData->exBlockSyncEveryWrite || toIsSmb)
+        if (syncEveryWrite)
             syncfs(targetFd);
     } while (offset_out != fromSize);
     // 执行同步策略
-    if (workData->exBlockSyncEveryWrite  || toIsSmb)
+    if (syncEveryWrite)
         syncfs(targetFd);
+    workData->rangeCopiedFileCount++;
     // 对文件加权
     setTargetPermissions(fromInfo->uri(), toInfo->uri());
     if (!stateCheck())
@@ -381,6 +487,20 @@ DoCopyFileWorker::NextDo DoCopyFileWorker::doCopyFileByRange(const DFileInfoPoin
     return NextDo::kDoCopyNext;
 }
 
+/*!
+ * \brief DoCopyFileWorker::copyBufferSize Size of one read/write block for the target device
+ * Targets synced on every write or reached over the network keep small blocks, the sync
+ * latency and the progress updates depend on them. Local disks stream bigger blocks.
+ */
+qint64 DoCopyFileWorker::copyBufferSize(const DFileInfoPointer &toInfo) const
+{
+    const QUrl &toUrl = toInfo->uri();
+    if (workData->exBlockSyncEveryWrite || workData->needSyncEveryRW
+        || DeviceUtils::isSamba(toUrl) || DeviceUtils::isFtp(toUrl))
+        return kMaxBufferLength;
+    return kLocalBufferLength;
+}
+
 bool DoCopyFileWorker::stateCheck()
 {
     if (state == kPasued)
@@ -626,61 +746,75 @@ DoCopyFileWorker::NextDo DoCopyFileWorker::doReadFile(const DFileInfoPointer &fr
 {
     readSize = 0;
     qint64 currentPos = fromDevice->pos();
-    AbstractJobHandler::SupportAction actionForRead = AbstractJobHandler::SupportAction::kNoAction;
-    auto fromSize = fromInfo->attribute(DFileInfo::AttributeID::kStandardSize).toLongLong();
 
     if (Q_UNLIKELY(!stateCheck())) {
         return NextDo::kDoCopyErrorAddCancel;
     }
-    do {
-        actionForRead = AbstractJobHandler::SupportAction::kNoAction;
-        readSize = fromDevice->read(data, blockSize);
-        if (Q_UNLIKELY(!stateCheck())) {
-            return NextDo::kDoCopyErrorAddCancel;
-        }
+    readSize = fromDevice->read(data, blockSize);
+    if (Q_UNLIKELY(!stateCheck())) {
+        return NextDo::kDoCopyErrorAddCancel;
+    }
 
-        if (Q_UNLIKELY(readSize <= 0)) {
+    return checkReadResult(fromInfo, toInfo, fromDevice, readSize, currentPos, skip);
+}
 
-            const qint64 fromFilePos = fromDevice->pos();
-            const qint64 fromFileInfoSize = fromSize;
-            if (readSize == 0 && fromFilePos == fromFileInfoSize) {
-                return NextDo::kDoCopyCurrentFile;
-            }
+/*!
+ * \brief DoCopyFileWorker::checkReadResult Check the result of one read of the source file
+ * \param fromInfo File information of source file
+ * \param toInfo File information of target file
+ * \param fromDevice file device, its last error is reported
+ * \param readSize Read size
+ * \param currentPos source offset the read started at
+ * \param skip Output parameter: whether skip
+ * \return kDoCopyCurrentFile if the data can be written
+ */
+DoCopyFileWorker::NextDo DoCopyFileWorker::checkReadResult(const DFileInfoPointer &fromInfo,
+                                                           const DFileInfoPointer &toInfo,
+                                                           const QSharedPointer<DFMIO::DFile> &fromDevice,
+                                                           const qint64 readSize, const qint64 currentPos,
+                                                           bool *skip)
+{
+    if (Q_LIKELY(readSize > 0))
+        return NextDo::kDoCopyCurrentFile;
 
-            fmWarning() << "read size <=0, size: " << readSize << " from file pos: " << fromFilePos << " from file info size: " << fromFileInfoSize;
-            fromInfo->initQuerier();
-            const bool fromInfoExist = fromInfo->exists();
-            AbstractJobHandler::JobErrorType errortype = fromInfoExist ? AbstractJobHandler::JobErrorType::kReadError : AbstractJobHandler::JobErrorType::kNonexistenceError;
-            QString errorstr = fromInfoExist ? fromDevice->lastError().errorMsg() : QString();
-
-            actionForRead = doHandleErrorAndWait(fromInfo->uri(),
-                                                 toInfo->uri(), errortype, false, errorstr);
-            if (actionForRead == AbstractJobHandler::SupportAction::kRetryAction && !isStopped()) {
-                // 检查当前文件是否可以访问
-                AbstractJobHandler::SupportAction actionForCheck = AbstractJobHandler::SupportAction::kNoAction;
-                do {
-                    actionForCheck = AbstractJobHandler::SupportAction::kNoAction;
-                    if (!NetworkUtils::instance()->checkFtpOrSmbBusy(fromInfo->uri())) {
-                        break;
-                    }
-                    actionForCheck = doHandleErrorAndWait(
-                            fromInfo->uri(),
-                            toInfo->uri(),
-                            AbstractJobHandler::JobErrorType::kCanNotAccessFile,
-                            true,
-                            "Can't access file!");
-                } while (actionForCheck == AbstractJobHandler::SupportAction::kRetryAction && !isStopped());
-                if (actionForCheck != AbstractJobHandler::SupportAction::kNoAction) {
-                    if (skip)
-                        *skip = actionForCheck == AbstractJobHandler::SupportAction::kSkipAction;
-                    return NextDo::kDoCopyErrorAddCancel;
-                }
-                checkRetry();
-                workData->currentWriteSize -= currentPos;
-                return NextDo::kDoCopyReDoCurrentFile;
+    auto fromSize = fromInfo->attribute(DFileInfo::AttributeID::kStandardSize).toLongLong();
+    const qint64 fromFilePos = currentPos + qMax<qint64>(readSize, 0);
+    if (readSize == 0 && fromFilePos == fromSize) {
+        return NextDo::kDoCopyCurrentFile;
+    }
+
+    fmWarning() << "read size <=0, size: " << readSize << " from file pos: " << fromFilePos << " from file info size: " << fromSize;
+    fromInfo->initQuerier();
+    const bool fromInfoExist = fromInfo->exists();
+    AbstractJobHandler::JobErrorType errortype = fromInfoExist ? AbstractJobHandler::JobErrorType::kReadError : AbstractJobHandler::JobErrorType::kNonexistenceError;
+    QString errorstr = fromInfoExist ? fromDevice->lastError().errorMsg() : QString();
+
+    AbstractJobHandler::SupportAction actionForRead = doHandleErrorAndWait(fromInfo->uri(),
+                                                                           toInfo->uri(), errortype, false, errorstr);
+    if (actionForRead == AbstractJobHandler::SupportAction::kRetryAction && !isStopped()) {
+        // 检查当前文件是否可以访问
+        AbstractJobHandler::SupportAction actionForCheck = AbstractJobHandler::SupportAction::kNoAction;
+        do {
+            actionForCheck = AbstractJobHandler::SupportAction::kNoAction;
+            if (!NetworkUtils::instance()->checkFtpOrSmbBusy(fromInfo->uri())) {
+                break;
             }
+            actionForCheck = doHandleErrorAndWait(
+                    fromInfo->uri(),
+                    toInfo->uri(),
+                    AbstractJobHandler::JobErrorType::kCanNotAccessFile,
+                    true,
+                    "Can't access file!");
+        } while (actionForCheck == AbstractJobHandler::SupportAction::kRetryAction && !isStopped());
+        if (actionForCheck != AbstractJobHandler::SupportAction::kNoAction) {
+            if (skip)
+                *skip = actionForCheck == AbstractJobHandler::SupportAction::kSkipAction;
+            return NextDo::kDoCopyErrorAddCancel;
         }
-    } while (actionForRead == AbstractJobHandler::SupportAction::kRetryAction && !isStopped());
+        checkRetry();
+        workData->currentWriteSize -= currentPos;
+        return NextDo::kDoCopyReDoCurrentFile;
+    }
     checkRetry();
 
     if (!actionOperating(actionForRead, fromSize - currentPos, skip))
@@ -706,7 +840,19 @@ DoCopyFileWorker::NextDo DoCopyFileWorker::doWriteFile(const DFileInfoPointer &f
                                                        const QSharedPointer<DFile> &fromDevice,
                                                        const char *data, const qint64 readSize, bool *skip)
 {
-    qint64 currentPos = fromDevice->pos() - readSize;
+    return doWriteBlock(fromInfo, toInfo, toDevice, data, readSize, fromDevice->pos() - readSize, skip);
+}
+
+/*!
+ * \brief DoCopyFileWorker::doWriteBlock Write one block of the source file
+ * \param currentPos source offset of data, the source device may already be read ahead
+ */
+DoCopyFileWorker::NextDo DoCopyFileWorker::doWriteBlock(const DFileInfoPointer &fromInfo, const DFileInfoPointer &toInfo,
+                                                        const QSharedPointer<DFMIO::DFile> &toDevice,
+                                                        const char *data, const qint64 readSize, const qint64 currentPos,
+                                                        bool *skip)
+{
+    const bool checkIntegrity = workData->jobFlags.testFlag(AbstractJobHandler::JobFlag::kCopyIntegrityChecking);
     AbstractJobHandler::SupportAction actionForWrite { AbstractJobHandler::SupportAction::kNoAction };
     qint64 sizeWrite = 0;
     qint64 surplusSize = readSize;
@@ -718,8 +864,12 @@ DoCopyFileWorker::NextDo DoCopyFileWorker::doWriteFile(const DFileInfoPointer &f
             surplusData += sizeWrite;
             surplusSize -= sizeWrite;
             sizeWrite = toDevice->write(surplusData, surplusSize);
-            if (sizeWrite > 0)
+            if (sizeWrite > 0) {
                 workData->currentWriteSize += sizeWrite;
+                writtenSize += sizeWrite;
+                if (checkIntegrity)
+                    writtenCheckSum = adler32(writtenCheckSum, reinterpret_cast<const Bytef *>(surplusData), static_cast<uInt>(sizeWrite));
+            }
             if (Q_UNLIKELY(!stateCheck()))
                 return NextDo::kDoCopyErrorAddCancel;
         } while (sizeWrite > 0 && sizeWrite < surplusSize);
@@ -740,7 +890,7 @@ DoCopyFileWorker::NextDo DoCopyFileWorker::doWriteFile(const DFileInfoPointer &f
                                               toDevice->lastError().errorMsg());
         if (actionForWrite == AbstractJobHandler::SupportAction::kRetryAction && !isStopped()) {
             qint64 curWrite = 0;
-            auto nextDo = doWriteFileErrorRetry(fromInfo, toInfo, toDevice, fromDevice, readSize, skip, currentPos, surplusSize, curWrite);
+            auto nextDo = doWriteFileErrorRetry(fromInfo, toInfo, toDevice, nullptr, readSize, skip, currentPos, surplusSize, curWrite);
             checkRetry();
             return nextDo;
         }
@@ -793,55 +943,111 @@ DoCopyFileWorker::NextDo DoCopyFileWorker::doWriteFileErrorRetry(const DFileInfo
     return NextDo::kDoCopyReDoCurrentFile;
 }
 
+/*!
+ * \brief DoCopyFileWorker::verifyFileIntegrity Compare the checksum of the source with the target
+ * By default the target checksum is accumulated on the bytes accepted by the target device while
+ * they are written, which catches short, lost and misplaced writes without a second pass. The
+ * paranoid kCopyIntegrityReread flag also catches media errors: the target is synced, dropped
+ * from the page cache and read back from the device, at the cost of reading every file twice.
+ * \param blockSize buffer size used to read back the target
+ * \param sourceCheckSum checksum of all bytes read from the source
+ * \return true if the target is valid or the user skipped the error
+ */
 bool DoCopyFileWorker::verifyFileIntegrity(const qint64 &blockSize, const ulong &sourceCheckSum,
                                            const DFileInfoPointer &fromInfo, const DFileInfoPointer &toInfo,
                                            QSharedPointer<DFMIO::DFile> &toDevice)
 {
     if (!workData->jobFlags.testFlag(AbstractJobHandler::JobFlag::kCopyIntegrityChecking))
         return true;
-    char *data = new char[static_cast<uint>(blockSize + 1)];
+
     QElapsedTimer t;
-    ulong targetCheckSum = adler32(0L, nullptr, 0);
+    t.start();
+    ulong targetCheckSum = writtenCheckSum;
+    if (workData->jobFlags.testFlag(AbstractJobHandler::JobFlag::kCopyIntegrityReread)) {
+        toDevice->flush();
+        bool skip = false;
+        if (!rereadTargetCheckSum(blockSize, fromInfo, toInfo, &targetCheckSum, &skip))
+            return skip;
+    } else {
+        const auto fromSize = fromInfo->attribute(DFileInfo::AttributeID::kStandardSize).toLongLong();
+        if (writtenSize != fromSize) {
+            fmWarning() << "Failed on file integrity checking, written size: " << writtenSize << " source size: " << fromSize;
+            targetCheckSum = ~sourceCheckSum;
+        }
+    }
+
+    fmDebug("Time spent of integrity check of the file: %lld", t.elapsed());
+
+    if (sourceCheckSum != targetCheckSum) {
+        fmWarning("Failed on file integrity checking, source file: 0x%lx, target file: 0x%lx", sourceCheckSum, targetCheckSum);
+        AbstractJobHandler::SupportAction actionForCheck = doHandleErrorAndWait(fromInfo->uri(),
+                                                                                toInfo->uri(),
+                                                                                AbstractJobHandler::JobErrorType::kIntegrityCheckingError,
+                                                                                true);
+        return actionForCheck == AbstractJobHandler::SupportAction::kSkipAction;
+    }
+
+    return true;
+}
+
+/*!
+ * \brief DoCopyFileWorker::rereadTargetCheckSum Read the target back from the device
+ * Local targets are synced and their pages dropped first, so the data really comes from the disk.
+ * \param checkSum Output parameter: checksum of the target
+ * \param skip Output parameter: whether the user skipped a read error
+ * \return false if the target can not be read
+ */
+bool DoCopyFileWorker::rereadTargetCheckSum(const qint64 &blockSize, const DFileInfoPointer &fromInfo,
+                                            const DFileInfoPointer &toInfo, ulong *checkSum, bool *skip)
+{
+    const QUrl &toUrl = toInfo->uri();
+    if (toUrl.isLocalFile()) {
+        int fd = open(QFile::encodeName(toUrl.path()).constData(), O_RDONLY);
+        if (fd >= 0) {
+            fdatasync(fd);
+            posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+            close(fd);
+        }
+    }
+
+    QSharedPointer<DFMIO::DFile> readDevice { new DFile(toUrl) };
+    if (!readDevice->open(DFMIO::DFile::OpenFlag::kReadOnly)) {
+        AbstractJobHandler::SupportAction action = doHandleErrorAndWait(fromInfo->uri(), toUrl,
+                                                                        AbstractJobHandler::JobErrorType::kIntegrityCheckingError,
+                                                                        true, readDevice->lastError().errorMsg());
+        checkRetry();
+        *skip = action == AbstractJobHandler::SupportAction::kSkipAction;
+        return false;
+    }
+
+    char *data = new char[static_cast<uint>(blockSize + 1)];
+    FinallyUtil release([&data]() { delete[] data; });
+    const auto fromSize = fromInfo->attribute(DFileInfo::AttributeID::kStandardSize).toLongLong();
+    *checkSum = adler32(0L, nullptr, 0);
     Q_FOREVER {
-        qint64 size = toDevice->read(data, blockSize);
+        qint64 size = readDevice->read(data, blockSize);
 
         if (Q_UNLIKELY(size <= 0)) {
-            if (size == 0 && toInfo->attribute(DFileInfo::AttributeID::kStandardSize).toLongLong() == toDevice->pos()) {
+            if (size == 0 && fromSize == readDevice->pos())
                 break;
-            }
 
             AbstractJobHandler::SupportAction actionForCheckRead = doHandleErrorAndWait(fromInfo->uri(),
-                                                                                        toInfo->uri(),
+                                                                                        toUrl,
                                                                                         AbstractJobHandler::JobErrorType::kIntegrityCheckingError,
                                                                                         true,
-                                                                                        toDevice->lastError().errorMsg());
-            if (!isStopped() && AbstractJobHandler::SupportAction::kRetryAction == actionForCheckRead) {
+                                                                                        readDevice->lastError().errorMsg());
+            if (!isStopped() && AbstractJobHandler::SupportAction::kRetryAction == actionForCheckRead)
                 continue;
-            } else {
-                checkRetry();
-                return actionForCheckRead == AbstractJobHandler::SupportAction::kSkipAction;
-            }
-        }
 
-        targetCheckSum = adler32(targetCheckSum, reinterpret_cast<Bytef *>(data), static_cast<uInt>(size));
-
-        if (Q_UNLIKELY(!stateCheck())) {
-            delete[] data;
-            data = nullptr;
+            checkRetry();
+            *skip = actionForCheckRead == AbstractJobHandler::SupportAction::kSkipAction;
             return false;
         }
-    }
-    delete[] data;
 
-    fmDebug("Time spent of integrity check of the file: %d", t.elapsed());
+        *checkSum = adler32(*checkSum, reinterpret_cast<Bytef *>(data), static_cast<uInt>(size));
 
-    if (sourceCheckSum != targetCheckSum) {
-        fmWarning("Failed on file integrity checking, source file: 0x%lx, target file: 0x%lx", sourceCheckSum, targetCheckSum);
-        AbstractJobHandler::SupportAction actionForCheck = doHandleErrorAndWait(fromInfo->uri(),
-                                                                                toInfo->uri(),
-                                                                                AbstractJobHandler::JobErrorType::kIntegrityCheckingError,
-                                                                                true);
-        return actionForCheck == AbstractJobHandler::SupportAction::kSkipAction;
+        if (Q_UNLIKELY(!stateCheck()))
+            return false;
     }
 
     return true;
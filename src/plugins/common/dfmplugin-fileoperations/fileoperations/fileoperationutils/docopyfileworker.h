@@ -62,6 +62,8 @@ public:
     // normal copy
     NextDo doCopyFileByRange(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo,
                              bool *skip);
+    // share the extents of the source on reflink filesystems
+    bool doCloneFile(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo);
     // small file copy
     void doFileCopy(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo);
     // copy file by dfmio
@@ -103,9 +105,16 @@ private:   // file copy
     NextDo doReadFile(const DFileInfoPointer &fromInfo, const DFileInfoPointer &toInfo,
                       const QSharedPointer<DFMIO::DFile> &fromDevice,
                       char *data, const qint64 &blockSize, qint64 &readSize, bool *skip);
+    NextDo checkReadResult(const DFileInfoPointer &fromInfo, const DFileInfoPointer &toInfo,
+                           const QSharedPointer<DFMIO::DFile> &fromDevice,
+                           const qint64 readSize, const qint64 currentPos, bool *skip);
     NextDo doWriteFile(const DFileInfoPointer &fromInfo, const DFileInfoPointer &toInfo,
                        const QSharedPointer<DFMIO::DFile> &toDevice, const QSharedPointer<DFMIO::DFile> &fromDevice,
                        const char *data, const qint64 readSize, bool *skip);
+    NextDo doWriteBlock(const DFileInfoPointer &fromInfo, const DFileInfoPointer &toInfo,
+                        const QSharedPointer<DFMIO::DFile> &toDevice,
+                        const char *data, const qint64 readSize, const qint64 currentPos, bool *skip);
+    qint64 copyBufferSize(const DFileInfoPointer &toInfo) const;
     NextDo doWriteFileErrorRetry(const DFileInfoPointer &fromInfo, const DFileInfoPointer &toInfo,
                                  const QSharedPointer<DFMIO::DFile> &toDevice, const QSharedPointer<DFMIO::DFile> &fromDevice, const qint64 readSize, bool *skip,
                                  const qint64 currentPos,
@@ -115,6 +124,8 @@ private:   // file copy
     bool verifyFileIntegrity(const qint64 &blockSize, const ulong &sourceCheckSum,
                              const DFileInfoPointer &fromInfo, const DFileInfoPointer &toInfo,
                              QSharedPointer<DFMIO::DFile> &toFile);
+    bool rereadTargetCheckSum(const qint64 &blockSize, const DFileInfoPointer &fromInfo,
+                              const DFileInfoPointer &toInfo, ulong *checkSum, bool *skip);
     void checkRetry();
     bool isStopped();
     void syncBlockFile(const DFileInfoPointer toInfo);
@@ -132,6 +143,8 @@ private:
     QSharedPointer<WorkerData> workData { nullptr };
     std::atomic_bool retry { false };
     int blockFileFd { -1 };
+    ulong writtenCheckSum { 0 };   // checksum of the bytes accepted by the target of the current file
+    qint64 writtenSize { 0 };   // bytes accepted by the target of the current file
     QList<QUrl> skipUrls;
     QUrl memcpySkipUrl;
     DThreadList<QSharedPointer<dfmio::DOperator>> fileOps;
@@ -0,0 +1,97 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "fileclonehelper.h"
+
+#include <QStringList>
+
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <linux/fs.h>
+#include <errno.h>
+
+DPFILEOPERATIONS_USE_NAMESPACE
+
+QHash<FileCloneHelper::DevicePair, FileCloneHelper::CloneSupport> FileCloneHelper::supportCache;
+QMutex FileCloneHelper::mutex;
+
+/*!
+ * \brief FileCloneHelper::cloneFile Make the target share all extents of the source
+ * The target must be opened for writing and is expected to be empty.
+ * \param sourceFd opened source file
+ * \param targetFd opened target file
+ * \return kCloned if no data has to be copied
+ */
+FileCloneHelper::CloneResult FileCloneHelper::cloneFile(const int sourceFd, const int targetFd)
+{
+#ifdef FICLONE
+    struct stat sourceStat;
+    struct stat targetStat;
+    if (fstat(sourceFd, &sourceStat) != 0 || fstat(targetFd, &targetStat) != 0)
+        return CloneResult::kFailed;
+
+    const DevicePair devices { sourceStat.st_dev, targetStat.st_dev };
+    if (support(devices) == CloneSupport::kUnsupported)
+        return CloneResult::kNotSupported;
+
+    if (ioctl(targetFd, FICLONE, sourceFd) == 0) {
+        setSupport(devices, CloneSupport::kSupported);
+        return CloneResult::kCloned;
+    }
+
+    const int err = errno;
+    switch (err) {
+    case EOPNOTSUPP:
+    case ENOTTY:
+    case EXDEV:
+    case EINVAL:
+        // EINVAL is also returned for files with unaligned tails on some filesystems,
+        // only remember it as unsupported if the pair never cloned before
+        if (err != EINVAL || support(devices) == CloneSupport::kUnknown) {
+            fmInfo() << "file clone is not supported between devices" << devices.first << devices.second << "errno:" << err;
+            setSupport(devices, CloneSupport::kUnsupported);
+            return CloneResult::kNotSupported;
+        }
+        return CloneResult::kFailed;
+    default:
+        fmDebug() << "file clone failed, errno:" << err;
+        return CloneResult::kFailed;
+    }
+#else
+    Q_UNUSED(sourceFd)
+    Q_UNUSED(targetFd)
+    return CloneResult::kNotSupported;
+#endif
+}
+
+/*!
+ * \brief FileCloneHelper::isCloneFsType Whether files on `fsType` can share extents
+ * Only used to decide if a clone is worth trying, the ioctl result is what counts.
+ */
+bool FileCloneHelper::isCloneFsType(const QString &fsType)
+{
+    static const QStringList kCloneFsTypes { "btrfs", "xfs", "bcachefs" };
+    return kCloneFsTypes.contains(fsType);
+}
+
+/*!
+ * \brief FileCloneHelper::isKnownUnsupported Whether a clone between the devices already failed
+ * Lets the caller skip creating the target when the clone can not succeed anyway.
+ */
+bool FileCloneHelper::isKnownUnsupported(const dev_t sourceDevice, const dev_t targetDevice)
+{
+    return support({ sourceDevice, targetDevice }) == CloneSupport::kUnsupported;
+}
+
+FileCloneHelper::CloneSupport FileCloneHelper::support(const DevicePair &devices)
+{
+    QMutexLocker lk(&mutex);
+    return supportCache.value(devices, CloneSupport::kUnknown);
+}
+
+void FileCloneHelper::setSupport(const DevicePair &devices, const CloneSupport value)
+{
+    QMutexLocker lk(&mutex);
+    supportCache.insert(devices, value);
+}
@@ -0,0 +1,55 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef FILECLONEHELPER_H
+#define FILECLONEHELPER_H
+
+#include "dfmplugin_fileoperations_global.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QPair>
+
+#include <sys/types.h>
+
+DPFILEOPERATIONS_BEGIN_NAMESPACE
+
+/*!
+ * \brief The FileCloneHelper class shares file extents instead of copying data when the
+ * filesystem supports it (btrfs, xfs, bcachefs...). Whether a source/target device pair
+ * can clone is probed by the first clone attempt and remembered for the process, so later
+ * copies on unsupported filesystems do not pay for the failing ioctl again.
+ */
+class FileCloneHelper
+{
+public:
+    enum class CloneResult : quint8 {
+        kCloned,   // the target shares the extents of the source
+        kNotSupported,   // the filesystem can not clone, copy the data
+        kFailed,   // cloning is supported but failed for this file, copy the data
+    };
+
+    static CloneResult cloneFile(const int sourceFd, const int targetFd);
+    static bool isCloneFsType(const QString &fsType);
+    static bool isKnownUnsupported(const dev_t sourceDevice, const dev_t targetDevice);
+
+private:
+    enum class CloneSupport : quint8 {
+        kUnknown,
+        kSupported,
+        kUnsupported,
+    };
+
+    using DevicePair = QPair<dev_t, dev_t>;
+
+    static CloneSupport support(const DevicePair &devices);
+    static void setSupport(const DevicePair &devices, const CloneSupport value);
+
+    static QHash<DevicePair, CloneSupport> supportCache;
+    static QMutex mutex;
+};
+
+DPFILEOPERATIONS_END_NAMESPACE
+
+#endif   // FILECLONEHELPER_H
@@ -5,11 +5,13 @@
 #include "fileoperatebaseworker.h"
 #include "fileoperations/fileoperationutils/fileoperationsutils.h"
 #include "workerdata.h"
+#include "devicecopyadmission.h"
 
 #include <dfm-base/interfaces/abstractdiriterator.h>
 #include <dfm-base/base/schemefactory.h>
 #include <dfm-base/base/device/deviceutils.h>
 #include <dfm-base/file/local/localfilehandler.h>
+#include <dfm-base/utils/finallyutil.h>
 
 #include <dfm-io/dfmio_utils.h>
 #include <dfm-io/denumerator.h>
@@ -646,15 +648,21 @@ bool FileOperateBaseWorker::checkAndCopyFile(const DFileInfoPointer fromInfo, co
     if (jobType == AbstractJobHandler::JobType::kCutType)
         return doCopyOtherFile(fromInfo, toInfo, skip);
 
+    // 支持reflink的文件系统优先共享数据块，不支持时再按原有方式拷贝
+    if (supportFileClone && !workData->exBlockSyncEveryWrite) {
+        initSignalCopyWorker();
+        if (copyOtherFileWorker->doCloneFile(fromInfo, toInfo))
+            return true;
+    }
+
     if (isSourceFileLocal && isTargetFileLocal && !workData->signalThread) {
-        while (bigFileCopy && !isStopped()) {
-            QThread::msleep(10);
-        }
         if (fromSize > bigFileSize) {
-            bigFileCopy = true;
-            auto result = doCopyLocalByRange(fromInfo, toInfo, skip);
-            bigFileCopy = false;
-            return result;
+            // big files sharing a device with another big file copy wait, independent devices stream in parallel
+            const auto &devices = DeviceCopyAdmission::devicesOf(fromInfo->uri(), toInfo->uri());
+            if (!DeviceCopyAdmission::instance()->acquire(devices, [this]() { return isStopped(); }))
+                return false;
+            FinallyUtil release([&devices]() { DeviceCopyAdmission::instance()->release(devices); });
+            return doCopyLocalByRange(fromInfo, toInfo, skip);
         }
         return doCopyLocalFile(fromInfo, toInfo);
     }
@@ -766,26 +774,22 @@ bool FileOperateBaseWorker::checkAndCopyDir(const DFileInfoPointer &fromInfo, co
 
 void FileOperateBaseWorker::waitThreadPoolOver()
 {
-    // wait all thread start
-    if (!isStopped() && threadPool) {
-        QThread::msleep(10);
-    }
-    // wait thread pool copy local file or copy big file over
-    while (threadPool && threadPool->activeThreadCount() > 0) {
-        QThread::msleep(10);
-    }
+    // wait all queued local files copied
+    if (copyScheduler)
+        copyScheduler->waitForIdle();
 }
 
 void FileOperateBaseWorker::initCopyWay()
 {
-    // local file useing least 8 thread
+    // local to local copies of several or big files go through the copy scheduler, its worker count
+    // follows the job volume, see CopyTaskScheduler::suggestedWorkerCount
     if (isSourceFileLocal && isTargetFileLocal) {
         countWriteType = CountWriteSizeType::kCustomizeType;
         workData->signalThread = (sourceFilesCount > 1 || sourceFilesTotalSize > FileOperationsUtils::bigFileSize()) && FileUtils::getCpuProcessCount() > 4
                 ? false
                 : true;
         if (!workData->signalThread)
-            threadCount = FileUtils::getCpuProcessCount() >= 8 ? FileUtils::getCpuProcessCount() : 8;
+            threadCount = CopyTaskScheduler::suggestedWorkerCount(sourceFilesCount, sourceFilesTotalSize);
     }
 
     if (DeviceUtils::isSamba(targetUrl)
@@ -858,8 +862,9 @@ void FileOperateBaseWorker::initThreadCopy()
         threadCopyWorker.append(copy);
     }
 
-    threadPool.reset(new QThreadPool);
-    threadPool->setMaxThreadCount(threadCount);
+    copyScheduler.reset(new CopyTaskScheduler(threadCount, [this](const int worker, const CopyTask &task) {
+        threadCopyWorker.at(worker)->doFileCopy(task.fromInfo, task.toInfo);
+    }));
 }
 
 void FileOperateBaseWorker::initSignalCopyWorker()
@@ -887,15 +892,11 @@ bool FileOperateBaseWorker::doCopyLocalFile(const DFileInfoPointer fromInfo, con
     if (!stateCheck())
         return false;
 
-#if (QT_VERSION < QT_VERSION_CHECK(6, 0, 0))
-    QtConcurrent::run(threadPool.data(), threadCopyWorker[threadCopyFileCount % threadCount].data(),
-                      static_cast<void (DoCopyFileWorker::*)(const DFileInfoPointer, const DFileInfoPointer)>(&DoCopyFileWorker::doFileCopy),
-                      fromInfo, toInfo);
-#else
-    QtConcurrent::run(threadPool.data(), [this, fromInfo, toInfo]() {
-        threadCopyWorker[threadCopyFileCount % threadCount]->doFileCopy(fromInfo, toInfo);
-    });
-#endif
+    CopyTask task;
+    task.fromInfo = fromInfo;
+    task.toInfo = toInfo;
+    task.size = fromInfo->attribute(DFileInfo::AttributeID::kStandardSize).toLongLong();
+    copyScheduler->submit(task);
 
     threadCopyFileCount++;
     return true;
@@ -63,6 +63,8 @@ public:
     QAtomicInteger<qint64> blockRenameWriteSize { 0 };   // The copy size is 0. The write statistics size of the linked file and directory
     QAtomicInteger<qint64> skipWriteSize { 0 };   // 跳过的文件大
     QAtomicInteger<qint64> completeFileCount { 0 };   // copy complete file count
+    QAtomicInteger<qint64> clonedFileCount { 0 };   // files copied by sharing extents (reflink)
+    QAtomicInteger<qint64> rangeCopiedFileCount { 0 };   // files copied by copy_file_range
     std::atomic_bool signalThread { true };
     DThreadMap<QUrl, qint64> everyFileWriteSize;
     DThreadList<QSharedPointer<DPFILEOPERATIONS_NAMESPACE::WorkerData::BlockFileCopyInfo>> blockCopyInfoQueue;
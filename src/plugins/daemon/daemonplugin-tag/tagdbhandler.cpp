@@ -236,12 +236,7 @@ bool TagDbHandler::addTagsForFiles(const QVariantMap &data)
 
     // insert file--tags
     bool ret = handle->transaction([tmpData, this]() -> bool {
-        for (auto dataIt = tmpData.begin(); dataIt != tmpData.end(); ++dataIt) {
-            bool ret = tagFile(dataIt.key(), dataIt.value());
-            if (!ret)
-                return ret;
-        }
-        return true;
+        return tagFiles(tmpData);
     });
 
     emit filesWereTagged(data);
@@ -261,10 +256,7 @@ bool TagDbHandler::removeTagsOfFiles(const QVariantMap &data)
     // remove file--tags
 
     bool ret = handle->transaction([data, this]() -> bool {
-        for (auto it = data.begin(); it != data.end(); ++it)
-            if (!removeSpecifiedTagOfFile(it.key(), it.value()))
-                return false;
-        return true;
+        return removeSpecifiedTagsOfFiles(data);
     });
 
     emit filesUntagged(data);
@@ -479,31 +471,31 @@ bool TagDbHandler::insertTagProperty(const QString &name, const QVariant &value)
     return true;
 }
 
-bool TagDbHandler::tagFile(const QString &file, const QVariant &tags)
+bool TagDbHandler::tagFiles(const QVariantMap &fileTags)
 {
     DFMBASE_NAMESPACE::FinallyUtil finally([&]() { lastErr.clear(); });
 
-    if (file.isEmpty() || tags.isNull()) {
-        lastErr = "input parameter is empty!";
-        return false;
+    // insert file--tags with one prepared statement
+    QList<QSharedPointer<FileTagInfo>> infos;
+    for (auto it = fileTags.begin(); it != fileTags.end(); ++it) {
+        if (it.key().isEmpty() || it.value().isNull()) {
+            lastErr = "input parameter is empty!";
+            return false;
+        }
+
+        const QStringList &tempTags = it.value().toStringList();
+        for (const auto &tag : tempTags) {
+            QSharedPointer<FileTagInfo> temp(new FileTagInfo);
+            temp->setFilePath(it.key());
+            temp->setTagName(tag);
+            temp->setTagOrder(0);
+            temp->setFuture("null");
+            infos.append(temp);
+        }
     }
 
-    // insert file--tags
-    const QStringList &tempTags = tags.toStringList();
-    int suc = tempTags.count();
-    for (const auto &tag : tempTags) {
-        FileTagInfo temp;
-        temp.setFilePath(file);
-        temp.setTagName(tag);
-        temp.setTagOrder(0);
-        temp.setFuture("null");
-        if (-1 == handle->insert<FileTagInfo>(temp))
-            break;
-        suc--;
-    }
-
-    if (0 < suc) {
-        lastErr = QString("Tag file failed! file: %1, tagName: %2").arg(file).arg(tempTags.at(--suc));
+    if (!handle->insertBatch<FileTagInfo>(infos)) {
+        lastErr = QString("Tag files failed! files: %1").arg(fileTags.keys().join(","));
         return false;
     }
 
@@ -511,26 +503,24 @@ bool TagDbHandler::tagFile(const QString &file, const QVariant &tags)
     return true;
 }
 
-bool TagDbHandler::removeSpecifiedTagOfFile(const QString &url, const QVariant &val)
+bool TagDbHandler::removeSpecifiedTagsOfFiles(const QVariantMap &fileTags)
 {
     DFMBASE_NAMESPACE::FinallyUtil finally([&]() { lastErr.clear(); });
 
-    if (url.isEmpty() || val.isNull()) {
-        lastErr = "input parameter is empty!";
-        return false;
-    }
+    QList<QVariantList> rows;
+    for (auto it = fileTags.begin(); it != fileTags.end(); ++it) {
+        if (it.key().isEmpty() || it.value().isNull()) {
+            lastErr = "input parameter is empty!";
+            return false;
+        }
 
-    auto field = Expression::Field<FileTagInfo>;
-    const auto tempTags = val.toStringList();
-    int suc = tempTags.count();
-    for (const auto &tag : tempTags) {
-        if (!handle->remove<FileTagInfo>((field("filePath") == url) && (field("tagName") == tag)))
-            break;
-        suc--;
+        const QStringList &tempTags = it.value().toStringList();
+        for (const auto &tag : tempTags)
+            rows.append({ it.key(), tag });
     }
 
-    if (0 < suc) {
-        lastErr = QString("Remove specified tag Of File failed! file: %1, tagName: %2").arg(url).arg(tempTags.at(--suc));
+    if (!handle->removeBatch<FileTagInfo>({ "filePath", "tagName" }, rows)) {
+        lastErr = QString("Remove specified tags of files failed! files: %1").arg(fileTags.keys().join(","));
         return false;
     }
 
@@ -63,8 +63,8 @@ private:
     bool createTable(const QString &tableName);
     bool checkTag(const QString &tag);
     bool insertTagProperty(const QString &name, const QVariant &value);
-    bool tagFile(const QString &file, const QVariant &tags);
-    bool removeSpecifiedTagOfFile(const QString &url, const QVariant &val);
+    bool tagFiles(const QVariantMap &fileTags);
+    bool removeSpecifiedTagsOfFiles(const QVariantMap &fileTags);
     bool changeTagColor(const QString &tagName, const QString &newTagColor);
     bool changeTagNameWithFile(const QString &tagName, const QString &newName);
     bool changeFilePath(const QString &oldPath, const QString &newPath);
@@ -766,8 +766,7 @@ QRectF CanvasItemDelegate::paintIcon(QPainter *painter, const QIcon &icon, const
         // 绘制带有阴影的背景
         auto stroke { iconStyle.stroke };
         backgroundRect.adjust(-stroke, -stroke, stroke, stroke);
-        const auto &originPixmap { IconUtils::renderIconBackground(backgroundRect.size(), iconStyle) };
-        const auto &shadowPixmap { IconUtils::addShadowToPixmap(originPixmap, iconStyle.shadowOffset, iconStyle.shadowRange, 0.2) };
+        const auto &shadowPixmap { IconUtils::renderShadowedIconBackground(backgroundRect.size(), iconStyle, 0.2) };
         painter->drawPixmap(backgroundRect, shadowPixmap, QRectF());
         imageRect.adjust(iconStyle.shadowRange, iconStyle.shadowRange, -iconStyle.shadowRange, -iconStyle.shadowRange);
 
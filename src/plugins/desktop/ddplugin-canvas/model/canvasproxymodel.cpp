@@ -321,6 +321,9 @@ void CanvasProxyModelPrivate::standardSort(QList<QUrl> &files) const
     if (files.isEmpty())
         return;
 
+    if (fileSortRole == kItemFileDisplayNameRole)
+        return sortByCollationKey(files);
+
     std::stable_sort(files.begin(), files.end(), [this](const QUrl &left, const QUrl &right) {
         return lessThan(left, right);
     });
@@ -328,6 +331,41 @@ void CanvasProxyModelPrivate::standardSort(QList<QUrl> &files) const
     return;
 }
 
+void CanvasProxyModelPrivate::sortByCollationKey(QList<QUrl> &files) const
+{
+    struct SortEntry
+    {
+        QUrl url;
+        bool isDir { false };
+        QByteArray key;
+    };
+
+    // build the name keys once, the comparisons are bytewise then
+    QVector<SortEntry> entries;
+    entries.reserve(files.count());
+    for (const QUrl &url : files) {
+        SortEntry entry { url };
+        const QModelIndex &idx = q->index(url);
+        const FileInfoPointer &info = fileMap.value(url);
+        if (idx.isValid() && info) {
+            entry.isDir = isNotMixDirAndFile && info->isAttributes(OptInfoType::kIsDir);
+            entry.key = FileUtils::collationKey(q->data(idx, kItemFileDisplayNameRole).toString());
+        }
+        entries.append(entry);
+    }
+
+    const bool ascending = fileSortOrder == Qt::AscendingOrder;
+    std::stable_sort(entries.begin(), entries.end(), [ascending](const SortEntry &left, const SortEntry &right) {
+        // The folder is fixed in the front position
+        if (left.isDir != right.isDir)
+            return left.isDir;
+        return ascending ? left.key < right.key : right.key < left.key;
+    });
+
+    for (int i = 0; i < entries.count(); ++i)
+        files[i] = entries.at(i).url;
+}
+
 void CanvasProxyModelPrivate::clearMapping()
 {
     fileList.clear();
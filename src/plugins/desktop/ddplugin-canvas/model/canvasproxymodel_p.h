@@ -50,6 +50,7 @@ public:
 
 protected:
     void standardSort(QList<QUrl> &files) const;
+    void sortByCollationKey(QList<QUrl> &files) const;
     void specialSort(QList<QUrl> &files) const;
 
 private:
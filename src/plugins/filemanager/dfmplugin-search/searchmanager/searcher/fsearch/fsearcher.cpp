@@ -53,13 +53,15 @@ bool FSearcher::search()
     }
 
     notifyTimer.start();
-    searchHandler->loadDatabase(path, "");
+    // 共享的数据库只做增量刷新，不再每次搜索都重新遍历
+    searchHandler->loadSharedDatabase(path);
     auto callback = std::bind(FSearcher::receiveResultCallback, std::placeholders::_1, std::placeholders::_2, this);
 
     conditionMtx.lock();
     if (searchHandler->search(keyword, callback))
         waitCondition.wait(&conditionMtx, ULONG_MAX);
     conditionMtx.unlock();
+    searchHandler->releaseSharedDatabase();
 
     if (status.testAndSetRelease(kRuning, kCompleted)) {
         if (hasItem())
@@ -6,9 +6,49 @@
 
 #include <dfm-base/base/device/deviceutils.h>
 
+#include <QReadWriteLock>
+#include <QSet>
+
 DPSEARCH_USE_NAMESPACE
 DFMBASE_USE_NAMESPACE
 
+/*!
+ * \brief The FSearchHandler::SharedDatabase struct 在多次搜索间复用的数据库
+ * 首次搜索时完整遍历建库，之后的搜索只重新读取修改时间变化的目录，
+ * 以及文件操作通知的目录。搜索持读锁，刷新持写锁。
+ */
+struct FSearchHandler::SharedDatabase
+{
+    ~SharedDatabase()
+    {
+        if (db) {
+            db_clear(db);
+            db_free(db);
+        }
+    }
+
+    QString path;
+    bool filterHidden { false };
+    bool enablePy { false };
+    // 建库被中断时数据库不完整，下次使用时重新建库
+    bool complete { false };
+    Database *db { nullptr };
+    QReadWriteLock lock;
+    // 由 sharedMutex 保护
+    QSet<QString> dirtyDirs;
+};
+
+static QMutex sharedMutex;
+// 等待共享数据库写锁时检查停止的间隔
+static constexpr int kSharedLockWaitMs { 100 };
+
+// 只保留最近一次搜索的根目录的数据库，避免常驻多份全盘数据
+QSharedPointer<FSearchHandler::SharedDatabase> &FSearchHandler::cachedDatabase()
+{
+    static QSharedPointer<SharedDatabase> database;
+    return database;
+}
+
 FSearchHandler::FSearchHandler()
 {
 }
@@ -65,6 +105,108 @@ bool FSearchHandler::loadDatabase(const QString &path, const QString &dbLocation
                          &isStop);
 }
 
+/*!
+ * \brief FSearchHandler::loadSharedDatabase 使用共享数据库进行搜索
+ * 数据库已存在时增量刷新而不是重新遍历，成功后持有读锁直到 releaseSharedDatabase。
+ * \param path 搜索的根目录
+ * \return 是否成功加载，等待写锁期间停止时返回 false
+ */
+bool FSearchHandler::loadSharedDatabase(const QString &path)
+{
+    releaseSharedDatabase();
+
+    const bool filterHidden = app->db->db_config->filter_hidden_file;
+    const bool enablePy = app->db->db_config->enable_py;
+    QSharedPointer<SharedDatabase> shared;
+    QSet<QString> dirtyDirs;
+    bool created = false;
+    {
+        QMutexLocker lk(&sharedMutex);
+        auto &cached = cachedDatabase();
+        if (cached && cached->path == path
+            && cached->filterHidden == filterHidden && cached->enablePy == enablePy) {
+            shared = cached;
+            dirtyDirs.swap(shared->dirtyDirs);
+        } else {
+            shared.reset(new SharedDatabase);
+            shared->path = path;
+            shared->filterHidden = filterHidden;
+            shared->enablePy = enablePy;
+            shared->db = db_new();
+            shared->db->db_config->filter_hidden_file = filterHidden;
+            shared->db->db_config->enable_py = enablePy;
+            // 建库完成前其他搜索等待写锁
+            shared->lock.lockForWrite();
+            cached = shared;
+            created = true;
+        }
+    }
+
+    // 其他搜索正在建库或刷新时等待，但要响应停止
+    if (!created) {
+        while (!shared->lock.tryLockForWrite(kSharedLockWaitMs)) {
+            if (isStop) {
+                // 未处理的目录留给下次搜索
+                QMutexLocker lk(&sharedMutex);
+                shared->dirtyDirs.unite(dirtyDirs);
+                return false;
+            }
+        }
+    }
+
+    const QByteArray &localPath = path.toLocal8Bit();
+    if (!shared->complete) {
+        load_database(shared->db, localPath.data(), nullptr, &isStop);
+        shared->complete = !isStop;
+    } else {
+        uint32_t changes = 0;
+        for (const QString &dir : dirtyDirs)
+            changes += db_location_refresh_dir(shared->db, localPath.data(), dir.toLocal8Bit().data(), &isStop);
+        changes += db_location_refresh(shared->db, localPath.data(), &isStop);
+        // 中断的刷新可能只读取了新目录的一部分，而目录的修改时间已经更新，下次使用时重新建库
+        if (isStop)
+            shared->complete = false;
+        fmDebug() << "fsearch database refreshed:" << path << "changed entries:" << changes << "stopped:" << isStop;
+    }
+    shared->lock.unlock();
+
+    shared->lock.lockForRead();
+    sharedDb = shared;
+    ownDb = app->db;
+    app->db = shared->db;
+    return true;
+}
+
+/*!
+ * \brief FSearchHandler::releaseSharedDatabase 等待搜索回调结束后释放共享数据库的读锁
+ */
+void FSearchHandler::releaseSharedDatabase()
+{
+    if (!sharedDb)
+        return;
+
+    // 搜索线程在回调结束前仍会访问数据库节点
+    syncMutex.lock();
+    syncMutex.unlock();
+    detachSharedDatabase();
+}
+
+/*!
+ * \brief FSearchHandler::markDirChanged 记录内容发生变化的目录，下次搜索时重新读取
+ * \param dirPath 目录路径
+ */
+void FSearchHandler::markDirChanged(const QString &dirPath)
+{
+    QMutexLocker lk(&sharedMutex);
+    const auto &cached = cachedDatabase();
+    if (!cached)
+        return;
+
+    const QString &root = cached->path;
+    if (root == "/" || dirPath == root || dirPath.startsWith(root.endsWith('/') ? root : root + '/'))
+        cached->dirtyDirs.insert(dirPath);
+}
+
 bool FSearchHandler::updateDatabase()
 {
     isStop = false;
@@ -91,8 +233,8 @@ bool FSearchHandler::search(const QString &keyword, FSearchHandler::FSearchCallb
     callbackFunc = callback;
     db_search_results_clear(app->search);
     Database *db = app->db;
-    if (!db_try_lock(db))
-        return false;
+    // 共享数据库可能被其他搜索短暂锁定
+    db_lock(db);
 
     if (app->search) {
         db_search_update(app->search,
@@ -151,8 +293,21 @@ long FSearchHandler::dbTimeStamp()
     return app->db->timestamp;
 }
 
+void FSearchHandler::detachSharedDatabase()
+{
+    if (!sharedDb)
+        return;
+
+    if (app)
+        app->db = ownDb;
+    ownDb = nullptr;
+    sharedDb->lock.unlock();
+    sharedDb.reset();
+}
+
 void FSearchHandler::releaseApp()
 {
+    detachSharedDatabase();
     if (app) {
         if (app->db) {
             db_clear(app->db);
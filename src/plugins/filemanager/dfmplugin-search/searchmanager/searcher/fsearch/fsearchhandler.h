@@ -13,6 +13,7 @@ extern "C" {
 
 #include <QFlags>
 #include <QMutex>
+#include <QSharedPointer>
 
 #include <functional>
 
@@ -41,6 +42,9 @@ public:
     void init();
     void reset();
     bool loadDatabase(const QString &path, const QString &dbLocation);
+    bool loadSharedDatabase(const QString &path);
+    void releaseSharedDatabase();
+    static void markDirChanged(const QString &dirPath);
     bool updateDatabase();
     bool saveDatabase(const QString &savePath);
     bool search(const QString &keyword, FSearchCallbackFunc callback);
@@ -50,6 +54,9 @@ public:
     long dbTimeStamp();
 
 private:
+    struct SharedDatabase;
+    static QSharedPointer<SharedDatabase> &cachedDatabase();
+    void detachSharedDatabase();
     void releaseApp();
     static void reveiceResultsCallback(void *data, void *sender);
 
@@ -59,6 +66,9 @@ private:
     uint32_t maxResults = DEFAULT_MAX_RESULTS;
     FSearchCallbackFunc callbackFunc = nullptr;
     QMutex syncMutex;
+    // 搜索期间持有共享数据库的读锁，app->db 暂时指向共享数据库
+    QSharedPointer<SharedDatabase> sharedDb;
+    Database *ownDb = nullptr;
 };
 
 DPSEARCH_END_NAMESPACE
@@ -6,21 +6,52 @@
 #include "utils/searchhelper.h"
 
 #include <dfm-base/utils/fileutils.h>
+#include <dfm-base/utils/systempathutil.h>
 #include <dfm-base/base/schemefactory.h>
+#include <dfm-base/base/device/deviceutils.h>
 
 #include <QDebug>
+#include <QFile>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 static int kEmitInterval = 50;   // 推送时间间隔（ms
 static constexpr char kFilterFolders[] = "^/(dev|proc|sys|run|tmpfs).*$";
+static constexpr char kDesktopSuffix[] = ".desktop";
+// 结果分批提交，减少锁竞争
+static constexpr int kResultBatchSize = 100;
+// 低速设备（网络挂载等）上并发遍历只会让请求排队
+static constexpr int kLowSpeedCrawlerCount = 2;
+static constexpr int kCrawlWaitInterval = 100;
 
 DFMBASE_USE_NAMESPACE
 DPSEARCH_USE_NAMESPACE
 
+static const QRegularExpression &filterFoldersRegex()
+{
+    static const QRegularExpression reg(kFilterFolders);
+    return reg;
+}
+
 IteratorSearcher::IteratorSearcher(const QUrl &url, const QString &key, QObject *parent)
     : AbstractSearcher(url, SearchHelper::instance()->checkWildcardAndToRegularExpression(key), parent)
 {
     searchPathList << url;
     regex = QRegularExpression(keyword, QRegularExpression::CaseInsensitiveOption);
+    regex.optimize();
+
+    isLiteralKey = !key.contains('*') && !key.contains('?') && !key.contains('[');
+    if (isLiteralKey)
+        literalMatcher = QStringMatcher(key, Qt::CaseInsensitive);
+
+    // 仅在过滤目录下进行搜索时，过滤目录下的内容才能被检索
+    if (dfmbase::FileUtils::isLocalFile(url))
+        filterSystemDirs = !filterFoldersRegex().match(url.toLocalFile()).hasMatch();
 }
 
 bool IteratorSearcher::search()
@@ -30,8 +61,11 @@ bool IteratorSearcher::search()
         return false;
 
     notifyTimer.start();
-    // 遍历搜索
-    doSearch();
+    // 遍历搜索，本地目录多线程遍历
+    if (searchUrl.isLocalFile())
+        doLocalSearch();
+    else
+        doSearch();
 
     //检查是否还有数据
     if (status.testAndSetRelease(kRuning, kCompleted)) {
@@ -63,8 +97,9 @@ QList<QUrl> IteratorSearcher::takeAll()
 void IteratorSearcher::tryNotify()
 {
     int cur = notifyTimer.elapsed();
-    if (hasItem() && (cur - lastEmit) > kEmitInterval) {
-        lastEmit = cur;
+    int last = lastEmit.loadAcquire();
+    // 多个遍历线程同时到达时只推送一次
+    if (hasItem() && (cur - last) > kEmitInterval && lastEmit.testAndSetOrdered(last, cur)) {
         fmDebug() << "IteratorSearcher unearthed, current spend:" << cur;
         emit unearthed(this);
     }
@@ -76,22 +111,17 @@ void IteratorSearcher::doSearch()
         if (searchPathList.isEmpty() || status.loadAcquire() != kRuning)
             return;
 
-        const auto &url = searchPathList.takeAt(0);
+        const auto &url = searchPathList.dequeue();
         auto iterator = DirIteratorFactory::create(url, QStringList(), QDir::NoDotAndDotDot | QDir::Dirs | QDir::Files);
         if (!iterator)
             continue;
 
-        iterator->setProperty("QueryAttributes","standard::name,standard::type,standard::size,\
-                                     standard::size,standard::is-symlink,standard::symlink-target,access::*,time::*");
+        // 只查询匹配需要的属性，命中后再更新完整属性
+        iterator->setProperty("QueryAttributes", "standard::name,standard::display-name,standard::type,\
+                                     standard::is-symlink,standard::symlink-target");
 
-        // 仅在过滤目录下进行搜索时，过滤目录下的内容才能被检索
-        if (dfmbase::FileUtils::isLocalFile(url)) {
-            QRegExp reg(kFilterFolders);
-            const auto &searchRootPath = searchUrl.toLocalFile();
-            const auto &filePath = url.toLocalFile();
-            if (!reg.exactMatch(searchRootPath) && reg.exactMatch(filePath))
-                continue;
-        }
+        if (dfmbase::FileUtils::isLocalFile(url) && isFilteredDir(url.toLocalFile()))
+            continue;
 
         while (iterator->hasNext()) {
             //中断
@@ -106,18 +136,16 @@ void IteratorSearcher::doSearch()
             // 将目录添加到待搜索目录中
             if (info->isAttributes(OptInfoType::kIsDir) && !info->isAttributes(OptInfoType::kIsSymLink)) {
                 const auto &fileUrl = info->urlOf(UrlInfoType::kUrl);
-                if (!searchPathList.contains(fileUrl) || !fileUrl.path().startsWith("/sys/"))
+                if (!fileUrl.path().startsWith("/sys/") && !visitedPaths.contains(fileUrl)) {
+                    visitedPaths.insert(fileUrl);
                     searchPathList << fileUrl;
+                }
             }
 
-            QRegularExpressionMatch match = regex.match(info->displayOf(DisPlayInfoType::kFileDisplayName));
-            if (match.hasMatch()) {
+            if (matchName(info->displayOf(DisPlayInfoType::kFileDisplayName))) {
                 const auto &fileUrl = info->urlOf(UrlInfoType::kUrl);
-                {
-                    info->updateAttributes();
-                    QMutexLocker lk(&mutex);
-                    allResults << fileUrl;                   
-                }
+                info->updateAttributes();
+                appendResults({ fileUrl });
 
                 //推送
                 tryNotify();
@@ -127,3 +155,162 @@ void IteratorSearcher::doSearch()
         iterator.clear();
     }
 }
+
+/*!
+ * \brief IteratorSearcher::doLocalSearch 多线程遍历本地目录
+ * 各线程共享待遍历目录队列，目录按 (设备, inode) 去重以避免绑定挂载造成的循环。
+ * 遍历时只读取文件名和类型，不创建 FileInfo。
+ */
+void IteratorSearcher::doLocalSearch()
+{
+    int crawlerCount = QThread::idealThreadCount();
+    if (DeviceUtils::isLowSpeedDevice(searchUrl))
+        crawlerCount = kLowSpeedCrawlerCount;
+    crawlerCount = qMax(1, crawlerCount);
+
+    pendingDirs.enqueue(searchUrl.toLocalFile());
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(crawlerCount);
+    for (int i = 0; i < crawlerCount; ++i)
+        QtConcurrent::run(&pool, [this] { crawlLocalDirs(); });
+    pool.waitForDone();
+}
+
+void IteratorSearcher::crawlLocalDirs()
+{
+    forever {
+        QString dirPath;
+        {
+            QMutexLocker lk(&crawlMutex);
+            // 队列为空但仍有线程在遍历时，等待其产出新的目录
+            while (pendingDirs.isEmpty() && busyCrawlers > 0 && status.loadAcquire() == kRuning)
+                crawlCondition.wait(&crawlMutex, kCrawlWaitInterval);
+
+            if (pendingDirs.isEmpty() || status.loadAcquire() != kRuning) {
+                crawlCondition.wakeAll();
+                return;
+            }
+
+            dirPath = pendingDirs.dequeue();
+            ++busyCrawlers;
+        }
+
+        QStringList subDirs;
+        crawlLocalDir(dirPath, &subDirs);
+
+        QMutexLocker lk(&crawlMutex);
+        for (const auto &subDir : subDirs)
+            pendingDirs.enqueue(subDir);
+        --busyCrawlers;
+        crawlCondition.wakeAll();
+    }
+}
+
+void IteratorSearcher::crawlLocalDir(const QString &dirPath, QStringList *subDirs)
+{
+    if (isFilteredDir(dirPath))
+        return;
+
+    int fd = ::open(QFile::encodeName(dirPath).constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0)
+        return;
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        return;
+    }
+
+    {
+        QMutexLocker lk(&crawlMutex);
+        const auto &dirId = qMakePair(static_cast<quint64>(st.st_dev), static_cast<quint64>(st.st_ino));
+        if (visitedDirs.contains(dirId)) {
+            ::close(fd);
+            return;
+        }
+        visitedDirs.insert(dirId);
+    }
+
+    DIR *dir = ::fdopendir(fd);
+    if (!dir) {
+        ::close(fd);
+        return;
+    }
+
+    QString basePath = dirPath;
+    if (!basePath.endsWith('/'))
+        basePath.append('/');
+
+    QList<QUrl> results;
+    struct dirent *entry = nullptr;
+    while ((entry = ::readdir(dir))) {
+        //中断
+        if (status.loadAcquire() != kRuning)
+            break;
+
+        // 与 QDir::Dirs | QDir::Files 一致，不遍历隐藏文件
+        if (entry->d_name[0] == '.')
+            continue;
+
+        bool isDir = entry->d_type == DT_DIR;
+        if (entry->d_type == DT_UNKNOWN) {
+            struct stat childSt;
+            if (::fstatat(::dirfd(dir), entry->d_name, &childSt, AT_SYMLINK_NOFOLLOW) != 0)
+                continue;
+            isDir = S_ISDIR(childSt.st_mode);
+        }
+
+        const QString &name = QFile::decodeName(entry->d_name);
+        const QString &filePath = basePath + name;
+        if (isDir && !filePath.startsWith("/sys/"))
+            subDirs->append(filePath);
+
+        bool matched = false;
+        if (name.endsWith(kDesktopSuffix)) {
+            // 桌面文件显示的是应用名称，需要创建文件信息
+            const auto &info = InfoFactory::create<FileInfo>(QUrl::fromLocalFile(filePath));
+            matched = info && matchName(info->displayOf(DisPlayInfoType::kFileDisplayName));
+        } else if (isDir && SystemPathUtil::instance()->isSystemPath(filePath)) {
+            // 系统目录（文档、下载等）显示的是本地化名称，与文件信息的显示名称保持一致
+            const QString &displayName = SystemPathUtil::instance()->systemPathDisplayNameByPath(filePath);
+            matched = matchName(displayName.isEmpty() ? name : displayName);
+        } else {
+            matched = matchName(name);
+        }
+
+        if (matched) {
+            results << QUrl::fromLocalFile(filePath);
+            if (results.size() >= kResultBatchSize) {
+                appendResults(results);
+                results.clear();
+                tryNotify();
+            }
+        }
+    }
+    ::closedir(dir);
+
+    if (!results.isEmpty()) {
+        appendResults(results);
+        tryNotify();
+    }
+}
+
+bool IteratorSearcher::isFilteredDir(const QString &dirPath) const
+{
+    return filterSystemDirs && filterFoldersRegex().match(dirPath).hasMatch();
+}
+
+bool IteratorSearcher::matchName(const QString &name) const
+{
+    if (isLiteralKey)
+        return literalMatcher.indexIn(name) >= 0;
+
+    return regex.match(name).hasMatch();
+}
+
+void IteratorSearcher::appendResults(const QList<QUrl> &results)
+{
+    QMutexLocker lk(&mutex);
+    allResults << results;
+}
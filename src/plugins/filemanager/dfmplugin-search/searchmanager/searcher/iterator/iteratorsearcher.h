@@ -9,7 +9,12 @@
 
 #include <QTime>
 #include <QMutex>
+#include <QWaitCondition>
 #include <QRegularExpression>
+#include <QStringMatcher>
+#include <QQueue>
+#include <QSet>
+#include <QPair>
 
 DPSEARCH_BEGIN_NAMESPACE
 
@@ -28,17 +33,35 @@ private:
     QList<QUrl> takeAll() override;
     void tryNotify();
     void doSearch();
+    void doLocalSearch();
+    void crawlLocalDirs();
+    void crawlLocalDir(const QString &dirPath, QStringList *subDirs);
+    bool isFilteredDir(const QString &dirPath) const;
+    bool matchName(const QString &name) const;
+    void appendResults(const QList<QUrl> &results);
 
 private:
     QAtomicInt status = kReady;
     QList<QUrl> allResults;
     mutable QMutex mutex;
-    QList<QUrl> searchPathList;
+    QQueue<QUrl> searchPathList;
+    QSet<QUrl> visitedPaths;
     QRegularExpression regex;
+    // a key without wildcards is a plain substring, matched without the regular expression
+    QStringMatcher literalMatcher;
+    bool isLiteralKey { false };
+    bool filterSystemDirs { true };
+
+    // the directories waiting for the local crawlers
+    QMutex crawlMutex;
+    QWaitCondition crawlCondition;
+    QQueue<QString> pendingDirs;
+    QSet<QPair<quint64, quint64>> visitedDirs;
+    int busyCrawlers { 0 };
 
     //计时
     QTime notifyTimer;
-    int lastEmit = 0;
+    QAtomicInt lastEmit = 0;
 };
 
 DPSEARCH_END_NAMESPACE
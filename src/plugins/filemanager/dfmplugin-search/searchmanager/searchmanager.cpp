@@ -4,6 +4,7 @@
 
 #include "searchmanager.h"
 #include "maincontroller/maincontroller.h"
+#include "searchmanager/searcher/fsearch/fsearchhandler.h"
 #include "utils/searchhelper.h"
 
 #include <dfm-base/base/urlroute.h>
@@ -12,6 +13,8 @@
 
 #include <dfm-framework/dpf.h>
 
+#include <QFileInfo>
+
 Q_DECLARE_METATYPE(const char *)
 
 DFMBASE_USE_NAMESPACE
@@ -88,4 +91,16 @@ void SearchManager::init()
     //直连，防止被事件循环打乱时序
     connect(mainController, &MainController::matched, this, &SearchManager::matched, Qt::DirectConnection);
     connect(mainController, &MainController::searchCompleted, this, &SearchManager::searchCompleted, Qt::DirectConnection);
+
+    // 文件操作改变了父目录的内容，fsearch 的数据库下次搜索时重新读取这些目录
+    auto markParentDir = [](const QUrl &url) {
+        if (url.isLocalFile())
+            FSearchHandler::markDirChanged(QFileInfo(url.toLocalFile()).absolutePath());
+    };
+    connect(this, &SearchManager::fileAdd, this, markParentDir, Qt::DirectConnection);
+    connect(this, &SearchManager::fileDelete, this, markParentDir, Qt::DirectConnection);
+    connect(this, &SearchManager::fileRename, this, [markParentDir](const QUrl &oldUrl, const QUrl &newUrl) {
+        markParentDir(oldUrl);
+        markParentDir(newUrl);
+    }, Qt::DirectConnection);
 }
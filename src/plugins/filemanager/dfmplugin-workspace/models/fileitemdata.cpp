@@ -10,11 +10,45 @@
 #include <dfm-base/utils/thumbnail/thumbnailfactory.h>
 
 #include <QStandardPaths>
+#include <QCache>
+#include <QMutex>
 
 using namespace dfmbase;
 using namespace dfmbase::Global;
 using namespace dfmplugin_workspace;
 
+// 列表模式一屏最多显示数百行，缓存的时间文本足够覆盖数屏内容
+static constexpr int kMaxCachedTimeTexts { 4096 };
+
+/*!
+ * \brief formatLastModified 返回格式化后的修改时间
+ * 列表视图每次重绘都会取该数据，格式化结果按时间缓存，所有条目共享，时间格式变化时清空缓存
+ */
+static QString formatLastModified(const QDateTime &lastModified)
+{
+    if (!lastModified.isValid())
+        return "-";
+
+    static QMutex mutex;
+    static QCache<qint64, QString> cache(kMaxCachedTimeTexts);
+    static QString cachedFormat;
+
+    const QString &format = FileUtils::dateTimeFormat();
+    const qint64 msecs = lastModified.toMSecsSinceEpoch();
+    QMutexLocker lk(&mutex);
+    if (format != cachedFormat) {
+        cache.clear();
+        cachedFormat = format;
+    }
+
+    if (QString *text = cache.object(msecs))
+        return *text;
+
+    const QString &text = lastModified.toString(format);
+    cache.insert(msecs, new QString(text));
+    return text;
+}
+
 FileItemData::FileItemData(const QUrl &url, const FileInfoPointer &info, FileItemData *parent)
     : parent(parent),
       url(url),
@@ -43,6 +77,11 @@ void FileItemData::setSortFileInfo(SortInfoPointer info)
     sortInfo = info;
 }
 
+SortInfoPointer FileItemData::sortFileInfo() const
+{
+    return sortInfo;
+}
+
 void FileItemData::refreshInfo()
 {
     if (!info.isNull())
@@ -120,10 +159,8 @@ QVariant FileItemData::data(int role) const
             return info->displayOf(DisPlayInfoType::kFileDisplayPath);
         return url.path();
     case kItemFileLastModifiedRole: {
-        if (info) {
-            auto lastModified = info->timeOf(TimeInfoType::kLastModified).value<QDateTime>();
-            return lastModified.isValid() ? lastModified.toString(FileUtils::dateTimeFormat()) : "-";
-        }
+        if (info)
+            return formatLastModified(info->timeOf(TimeInfoType::kLastModified).value<QDateTime>());
         return "-";
     }
     case kItemIconRole:
@@ -20,6 +20,7 @@ public:
 
     void setParentData(FileItemData *p);
     void setSortFileInfo(SortInfoPointer info);
+    SortInfoPointer sortFileInfo() const;
 
     void refreshInfo();
     void clearThumbnail();
@@ -48,6 +48,7 @@ FileViewModel::FileViewModel(QAbstractItemView *parent)
     currentKey = QString::number(quintptr(this), 16);
     itemRootData = new FileItemData(dirRootUrl);
     connect(ThumbnailFactory::instance(), &ThumbnailFactory::produceFinished, this, &FileViewModel::onFileThumbUpdated);
+    connect(ThumbnailFactory::instance(), &ThumbnailFactory::produceCanceled, this, &FileViewModel::onFileThumbCanceled);
     connect(Application::instance(), &Application::genericAttributeChanged, this, &FileViewModel::onGenericAttributeChanged);
     connect(Application::instance(), &Application::showedHiddenFilesChanged, this, &FileViewModel::onHiddenSettingChanged);
     connect(DConfigManager::instance(), &DConfigManager::valueChanged, this, &FileViewModel::onDConfigChanged);
@@ -751,6 +752,25 @@ void FileViewModel::onFileThumbUpdated(const QUrl &url, const QString &thumb)
     }
 }
 
+void FileViewModel::onFileThumbCanceled(const QUrl &url)
+{
+    auto canceledIndex = getIndexByUrl(url);
+    if (!canceledIndex.isValid())
+        return;
+
+    // the thumbnail is joined again once the item is painted
+    auto info = fileInfo(canceledIndex);
+    if (info)
+        info->setExtendedAttributes(ExtInfoType::kFileThumbnail, QVariant());
+
+    auto view = qobject_cast<FileView *>(QObject::parent());
+    if (view) {
+        view->update(canceledIndex);
+    } else {
+        Q_EMIT dataChanged(canceledIndex, canceledIndex);
+    }
+}
+
 void FileViewModel::onFileUpdated(int show)
 {
     auto view = qobject_cast<FileView *>(QObject::parent());
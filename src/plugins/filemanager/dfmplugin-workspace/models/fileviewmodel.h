@@ -122,6 +122,7 @@ Q_SIGNALS:
 
 public Q_SLOTS:
     void onFileThumbUpdated(const QUrl &url, const QString &thumb);
+    void onFileThumbCanceled(const QUrl &url);
     void onFileUpdated(int show);
     void onInsert(int firstIndex, int count);
     void onInsertFinish();
@@ -22,6 +22,9 @@
 using namespace dfmbase;
 using namespace dfmplugin_workspace;
 
+// small directories list fast enough without a snapshot
+static constexpr int kMinSnapshotFileCount { 2000 };
+
 RootInfo::RootInfo(const QUrl &u, const bool canCache, QObject *parent)
     : QObject(parent), url(u), canCache(canCache)
 {
@@ -115,8 +118,11 @@ void RootInfo::startWork(const QString &key, const bool getCache)
     {
         QWriteLocker lk(&childrenLock);
         childrenUrlList.clear();
+        childrenUrlSet.clear();
         sourceDataList.clear();
+        snapshotPending.clear();
     }
+    showSnapshot(key);
     traversalThreads.value(key)->traversalThread->start();
 }
 
@@ -176,6 +182,7 @@ void RootInfo::reset()
     {
         QWriteLocker lk(&childrenLock);
         childrenUrlList.clear();
+        childrenUrlSet.clear();
         sourceDataList.clear();
     }
 
@@ -277,6 +284,8 @@ void RootInfo::doWatcherEvent()
                 emit requestClearRoot(fileUrl);
                 QWriteLocker lk(&childrenLock);
                 childrenUrlList.clear();
+                childrenUrlSet.clear();
+        childrenUrlSet.clear();
                 sourceDataList.clear();
                 break;
             }
@@ -338,6 +347,11 @@ void RootInfo::doThreadWatcherEvent()
 
 void RootInfo::handleTraversalResult(const FileInfoPointer &child, const QString &travseToken)
 {
+    if (snapshotShown) {
+        mergeSnapshot({ sortFileInfo(child) });
+        return;
+    }
+
     auto sortInfo = addChild(child);
     if (sortInfo)
         Q_EMIT iteratorAddFile(travseToken, sortInfo, child);
@@ -345,6 +359,14 @@ void RootInfo::handleTraversalResult(const FileInfoPointer &child, const QString
 
 void RootInfo::handleTraversalResults(const QList<FileInfoPointer> children, const QString &travseToken)
 {
+    if (snapshotShown) {
+        QList<SortInfoPointer> sortInfos;
+        for (const auto &info : children)
+            sortInfos.append(sortFileInfo(info));
+        mergeSnapshot(sortInfos);
+        return;
+    }
+
     QList<SortInfoPointer> sortInfos;
     QList<FileInfoPointer> infos;
     for (const auto &info : children) {
@@ -364,18 +386,35 @@ void RootInfo::handleTraversalLocalResult(QList<SortInfoPointer> children,
                                           dfmio::DEnumerator::SortRoleCompareFlag sortRole,
                                           Qt::SortOrder sortOrder, bool isMixDirAndFile, const QString &travseToken)
 {
+    // the snapshot was loaded with the same dir key, it only needs rewriting if the listing or its order changed
+    bool snapshotDirty = originSortRole != sortRole || originSortOrder != sortOrder || originMixSort != isMixDirAndFile;
     originSortRole = sortRole;
     originSortOrder = sortOrder;
     originMixSort = isMixDirAndFile;
 
-    addChildren(children);
-    traversaling = false;
+    if (snapshotShown.exchange(false)) {
+        snapshotDirty = reconcileSnapshot(children) || snapshotDirty;
+        traversaling = false;
+    } else {
+        snapshotDirty = true;
+        addChildren(children);
+        traversaling = false;
 
-    Q_EMIT iteratorLocalFiles(travseToken, children, originSortRole, originSortOrder, originMixSort);
+        Q_EMIT iteratorLocalFiles(travseToken, children, originSortRole, originSortOrder, originMixSort);
+    }
+
+    if (snapshotDirty)
+        saveSnapshot(children);
 }
 
 void RootInfo::handleTraversalFinish(const QString &travseToken)
 {
+    // the results came one by one, whatever they did not confirm is gone and the rows are not sorted anymore
+    if (snapshotShown.exchange(false)) {
+        dropUnconfirmedSnapshot();
+        originSortRole = dfmio::DEnumerator::SortRoleCompareFlag::kSortRoleCompareDefault;
+    }
+
     traversaling = false;
     emit traversalFinished(travseToken);
     traversalFinish = true;
@@ -458,6 +497,7 @@ void RootInfo::addChildren(const QList<SortInfoPointer> &children)
 
         QWriteLocker lk(&childrenLock);
         childrenUrlList.append(file->fileUrl());
+        childrenUrlSet.insert(file->fileUrl());
         sourceDataList.append(file);
     }
 }
@@ -476,11 +516,12 @@ SortInfoPointer RootInfo::addChild(const FileInfoPointer &child)
 
     {
         QWriteLocker lk(&childrenLock);
-        if (childrenUrlList.contains(childUrl)) {
+        if (childrenUrlSet.contains(childUrl)) {
             sourceDataList.replace(childrenUrlList.indexOf(childUrl), sort);
             return sort;
         }
         childrenUrlList.append(childUrl);
+        childrenUrlSet.insert(childUrl);
         sourceDataList.append(sort);
     }
 
@@ -527,6 +568,7 @@ void RootInfo::removeChildren(const QList<QUrl> &urlList)
             continue;
         }
         childrenUrlList.removeAt(childIndex);
+        childrenUrlSet.remove(realUrl);
         removeChildren.append(sourceDataList.takeAt(childIndex));
     }
 
@@ -543,7 +585,7 @@ void RootInfo::removeChildren(const QList<QUrl> &urlList)
 bool RootInfo::containsChild(const QUrl &url)
 {
     QReadLocker lk(&childrenLock);
-    return childrenUrlList.contains(url);
+    return childrenUrlSet.contains(url);
 }
 
 SortInfoPointer RootInfo::updateChild(const QUrl &url)
@@ -557,7 +599,7 @@ SortInfoPointer RootInfo::updateChild(const QUrl &url)
     auto realUrl = info->urlOf(UrlInfoType::kUrl);
 
     QWriteLocker lk(&childrenLock);
-    if (!childrenUrlList.contains(realUrl))
+    if (!childrenUrlSet.contains(realUrl))
         return nullptr;
     sort = sortFileInfo(info);
     if (sort.isNull())
@@ -585,6 +627,209 @@ void RootInfo::updateChildren(const QList<QUrl> &urls)
     emit watcherUpdateFiles(updates);
 }
 
+/*!
+ * \brief RootInfo::showSnapshot Show the stored listing of the directory before enumerating it
+ * Only local directories that do not cache their data otherwise take part, the snapshot is
+ * used when the directory did not change since it was taken.
+ */
+void RootInfo::showSnapshot(const QString &key)
+{
+    snapshotShown = false;
+    snapshotKey = DirSnapshotCache::DirKey();
+    if (canCache || !url.isLocalFile() || !DirSnapshotCache::dirKey(url, &snapshotKey))
+        return;
+
+    DirSnapshotCache::Snapshot snapshot;
+    if (isRefresh || !DirSnapshotCache::load(url, snapshotKey, &snapshot))
+        return;
+
+    fmInfo() << "show dir snapshot, file count: " << snapshot.children.count() << " url: " << url;
+    originSortRole = snapshot.sortRole;
+    originSortOrder = snapshot.sortOrder;
+    originMixSort = snapshot.isMixDirAndFile;
+    addChildren(snapshot.children);
+    {
+        QWriteLocker lk(&childrenLock);
+        snapshotPending.clear();
+        snapshotPending.reserve(snapshot.children.count());
+        for (const auto &sortInfo : snapshot.children)
+            snapshotPending.insert(sortInfo->fileUrl(), sortInfo);
+    }
+    snapshotShown = true;
+
+    Q_EMIT iteratorLocalFiles(key, snapshot.children, originSortRole, originSortOrder, originMixSort);
+}
+
+/*!
+ * \brief RootInfo::reconcileSnapshot Replace the shown snapshot by the enumerated children
+ * The view only receives the difference: entries missing from the snapshot are added,
+ * vanished ones removed and changed ones updated in place.
+ * \return true if the listing differs from the snapshot
+ */
+bool RootInfo::reconcileSnapshot(const QList<SortInfoPointer> &children)
+{
+    QList<SortInfoPointer> added;
+    QList<SortInfoPointer> removed;
+    QList<SortInfoPointer> updated;
+    {
+        QWriteLocker lk(&childrenLock);
+        QHash<QUrl, SortInfoPointer> shown;
+        shown.swap(snapshotPending);
+
+        QList<QUrl> urls;
+        QList<SortInfoPointer> datas;
+        for (const auto &child : children) {
+            if (!child)
+                continue;
+
+            SortInfoPointer old = shown.take(child->fileUrl());
+            if (!old) {
+                added.append(child);
+                old = child;
+            } else if (snapshotChanged(old, child)) {
+                refreshSnapshotRow(old, child);
+                updated.append(old);
+            }
+            urls.append(old->fileUrl());
+            datas.append(old);
+        }
+        removed = shown.values();
+        childrenUrlList = urls;
+        childrenUrlSet = QSet<QUrl>(urls.cbegin(), urls.cend());
+        sourceDataList = datas;
+    }
+
+    fmInfo() << "dir snapshot reconciled, added: " << added.count() << " removed: " << removed.count()
+             << " updated: " << updated.count() << " url: " << url;
+    if (!removed.isEmpty())
+        Q_EMIT watcherRemoveFiles(removed);
+    if (!added.isEmpty())
+        Q_EMIT watcherAddFiles(added);
+    if (!updated.isEmpty())
+        Q_EMIT watcherUpdateFiles(updated);
+
+    return !added.isEmpty() || !removed.isEmpty() || !updated.isEmpty();
+}
+
+/*!
+ * \brief RootInfo::mergeSnapshot Merge a part of an enumeration that delivers its results
+ * one by one into the shown snapshot, see dropUnconfirmedSnapshot for the vanished entries
+ */
+void RootInfo::mergeSnapshot(const QList<SortInfoPointer> &children)
+{
+    QList<SortInfoPointer> added;
+    QList<SortInfoPointer> updated;
+    {
+        QWriteLocker lk(&childrenLock);
+        for (const auto &child : children) {
+            if (!child)
+                continue;
+
+            const QUrl &childUrl = child->fileUrl();
+            SortInfoPointer old = snapshotPending.take(childUrl);
+            if (!old) {
+                if (childrenUrlSet.contains(childUrl))
+                    continue;
+                childrenUrlList.append(childUrl);
+                childrenUrlSet.insert(childUrl);
+                sourceDataList.append(child);
+                added.append(child);
+            } else if (snapshotChanged(old, child)) {
+                refreshSnapshotRow(old, child);
+                updated.append(old);
+            }
+        }
+    }
+
+    if (!added.isEmpty())
+        Q_EMIT watcherAddFiles(added);
+    if (!updated.isEmpty())
+        Q_EMIT watcherUpdateFiles(updated);
+}
+
+/*!
+ * \brief RootInfo::dropUnconfirmedSnapshot Remove the snapshot rows the finished enumeration did not list
+ */
+void RootInfo::dropUnconfirmedSnapshot()
+{
+    QList<SortInfoPointer> removed;
+    {
+        QWriteLocker lk(&childrenLock);
+        if (snapshotPending.isEmpty())
+            return;
+
+        QList<QUrl> urls;
+        QList<SortInfoPointer> datas;
+        for (int i = 0; i < childrenUrlList.count(); ++i) {
+            const auto &pending = snapshotPending.value(childrenUrlList.at(i));
+            if (pending && pending == sourceDataList.at(i)) {
+                removed.append(pending);
+                childrenUrlSet.remove(childrenUrlList.at(i));
+                continue;
+            }
+            urls.append(childrenUrlList.at(i));
+            datas.append(sourceDataList.at(i));
+        }
+        snapshotPending.clear();
+        childrenUrlList = urls;
+        sourceDataList = datas;
+    }
+
+    fmInfo() << "dir snapshot merged, removed: " << removed.count() << " url: " << url;
+    if (!removed.isEmpty())
+        Q_EMIT watcherRemoveFiles(removed);
+}
+
+// the view holds the shown sort info, keep the object and refresh its values
+void RootInfo::refreshSnapshotRow(const SortInfoPointer &shown, const SortInfoPointer &live) const
+{
+    shown->setDir(live->isDir());
+    shown->setFile(live->isFile());
+    shown->setSymlink(live->isSymLink());
+    shown->setHide(live->isHide());
+    if (live->isStatLater()) {
+        shown->setStatLater(true);
+    } else {
+        shown->setSize(live->fileSize());
+        shown->setReadable(live->isReadable());
+        shown->setWriteable(live->isWriteable());
+        shown->setExecutable(live->isExecutable());
+        shown->setStatLater(false);
+    }
+}
+
+// entries whose size and permissions are not read yet only compare by their type
+bool RootInfo::snapshotChanged(const SortInfoPointer &shown, const SortInfoPointer &live) const
+{
+    if (shown->isDir() != live->isDir() || shown->isFile() != live->isFile()
+        || shown->isSymLink() != live->isSymLink() || shown->isHide() != live->isHide())
+        return true;
+
+    if (shown->isStatLater() || live->isStatLater())
+        return shown->isStatLater() != live->isStatLater();
+
+    return shown->fileSize() != live->fileSize() || shown->isReadable() != live->isReadable()
+            || shown->isWriteable() != live->isWriteable() || shown->isExecutable() != live->isExecutable();
+}
+
+void RootInfo::saveSnapshot(const QList<SortInfoPointer> &children)
+{
+    if (!snapshotKey.isValid())
+        return;
+
+    if (children.count() < kMinSnapshotFileCount) {
+        DirSnapshotCache::remove(url);
+        return;
+    }
+
+    DirSnapshotCache::Snapshot snapshot;
+    snapshot.children = children;
+    snapshot.sortRole = originSortRole;
+    snapshot.sortOrder = originSortOrder;
+    snapshot.isMixDirAndFile = originMixSort;
+    DirSnapshotCache::save(url, snapshotKey, snapshot);
+}
+
 bool RootInfo::checkFileEventQueue()
 {
     QMutexLocker lk(&watcherEventMutex);
@@ -7,12 +7,15 @@
 
 #include "dfmplugin_workspace_global.h"
 #include "utils/traversaldirthreadmanager.h"
+#include "utils/dirsnapshotcache.h"
 
 #include <dfm-base/dfm_base_global.h>
 #include <dfm-base/utils/traversaldirthread.h>
 #include <dfm-base/interfaces/abstractfilewatcher.h>
 
 #include <QReadWriteLock>
+#include <QHash>
+#include <QSet>
 #include <QQueue>
 #include <QFuture>
 
@@ -120,6 +123,14 @@ private:
     SortInfoPointer updateChild(const QUrl &url);
     void updateChildren(const QList<QUrl> &urls);
 
+    void showSnapshot(const QString &key);
+    bool reconcileSnapshot(const QList<SortInfoPointer> &children);
+    void mergeSnapshot(const QList<SortInfoPointer> &children);
+    void dropUnconfirmedSnapshot();
+    bool snapshotChanged(const SortInfoPointer &shown, const SortInfoPointer &live) const;
+    void refreshSnapshotRow(const SortInfoPointer &shown, const SortInfoPointer &live) const;
+    void saveSnapshot(const QList<SortInfoPointer> &children);
+
     bool checkFileEventQueue();
     void enqueueEvent(const QPair<QUrl, EventType> &e);
     QPair<QUrl, EventType> dequeueEvent();
@@ -138,6 +149,7 @@ private:
 
     QReadWriteLock childrenLock;
     QList<QUrl> childrenUrlList {};
+    QSet<QUrl> childrenUrlSet {};   // membership of childrenUrlList, kept in step with it
     QList<SortInfoPointer> sourceDataList {};
     // origin data sort information
     dfmio::DEnumerator::SortRoleCompareFlag originSortRole { dfmio::DEnumerator::SortRoleCompareFlag::kSortRoleCompareDefault };
@@ -157,6 +169,11 @@ private:
     std::atomic_bool needStartWatcher { true };
     std::atomic_bool isRefresh { false };
     QStringList connectedTokens;
+
+    // listing snapshot of a large local directory, shown until the enumeration replaces it
+    DirSnapshotCache::DirKey snapshotKey;
+    std::atomic_bool snapshotShown { false };
+    QHash<QUrl, SortInfoPointer> snapshotPending;   // shown rows the enumeration did not confirm yet, guarded by childrenLock
 };
 }
 
@@ -0,0 +1,99 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "direnumerationpool.h"
+
+#include <dfm-base/base/device/deviceutils.h>
+
+#include <QThread>
+#include <QFile>
+
+#include <sys/stat.h>
+
+using namespace dfmbase;
+using namespace dfmplugin_workspace;
+
+// network mounts and other remote locations answer slowly and serialize on the server anyway
+static constexpr int kSlowDeviceLimit { 2 };
+static constexpr int kWaitInterval { 100 };
+// keys of slow locations carry this prefix, their slots come out of the remote budget
+static constexpr char kRemoteKeyPrefix[] { "remote:" };
+
+DirEnumerationPool *DirEnumerationPool::instance()
+{
+    static DirEnumerationPool ins;
+    return &ins;
+}
+
+DirEnumerationPool::DirEnumerationPool()
+{
+    localSlots.max = qMax(2, QThread::idealThreadCount());
+    remoteSlots.max = qMax(2, QThread::idealThreadCount());
+}
+
+/*!
+ * \brief DirEnumerationPool::acquire Wait for an enumeration slot on the device of the directory
+ * \param dir the directory to enumerate
+ * \param slotKey receives the key to release the slot with
+ * \param isStopped polled while waiting, a stopped traversal gives up without a slot
+ * \return true when the slot was taken and must be released
+ */
+bool DirEnumerationPool::acquire(const QUrl &dir, QString *slotKey, const std::function<bool()> &isStopped)
+{
+    int limit = localSlots.max;
+    const QString &key = deviceKey(dir, &limit);
+
+    QMutexLocker lk(&mutex);
+    SlotBudget &budget = budgetOf(key);
+    while (budget.running >= budget.max || runningPerDevice.value(key) >= limit) {
+        if (isStopped && isStopped())
+            return false;
+        slotFreed.wait(&mutex, kWaitInterval);
+    }
+
+    ++budget.running;
+    ++runningPerDevice[key];
+    if (slotKey)
+        *slotKey = key;
+    return true;
+}
+
+void DirEnumerationPool::release(const QString &slotKey)
+{
+    QMutexLocker lk(&mutex);
+    SlotBudget &budget = budgetOf(slotKey);
+    if (budget.running <= 0)
+        return;
+
+    --budget.running;
+    if (--runningPerDevice[slotKey] <= 0)
+        runningPerDevice.remove(slotKey);
+    slotFreed.wakeAll();
+}
+
+QString DirEnumerationPool::deviceKey(const QUrl &dir, int *limit)
+{
+    if (!dir.isLocalFile()) {
+        *limit = kSlowDeviceLimit;
+        return kRemoteKeyPrefix + dir.scheme() + "://" + dir.host();
+    }
+
+    const QString &path = dir.toLocalFile();
+    // do not stat the directories of network mounts, key them by their mount directory
+    if (DeviceUtils::isLowSpeedDevice(dir)) {
+        *limit = kSlowDeviceLimit;
+        return kRemoteKeyPrefix + path.section(QChar('/'), 0, 5);
+    }
+
+    struct stat st;
+    if (::stat(QFile::encodeName(path).constData(), &st) != 0)
+        return path;
+
+    return QString("dev:%1").arg(static_cast<quint64>(st.st_dev));
+}
+
+DirEnumerationPool::SlotBudget &DirEnumerationPool::budgetOf(const QString &slotKey)
+{
+    return slotKey.startsWith(kRemoteKeyPrefix) ? remoteSlots : localSlots;
+}
@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DIRENUMERATIONPOOL_H
+#define DIRENUMERATIONPOOL_H
+
+#include "dfmplugin_workspace_global.h"
+
+#include <QUrl>
+#include <QHash>
+#include <QMutex>
+#include <QWaitCondition>
+
+#include <functional>
+
+namespace dfmplugin_workspace {
+
+/*!
+ * \brief The DirEnumerationPool class shares the enumeration slots of all directory traversals
+ * Opening a directory and expanding tree nodes each start a traversal, the pool lets as many
+ * of them run as there are cores while keeping the number per device bounded, so expanding a
+ * lot of nodes neither floods one disk nor waits for the others. Local and remote locations
+ * draw from separate budgets, hanging network enumerations never hold back local ones.
+ */
+class DirEnumerationPool
+{
+public:
+    static DirEnumerationPool *instance();
+
+    bool acquire(const QUrl &dir, QString *slotKey, const std::function<bool()> &isStopped);
+    void release(const QString &slotKey);
+
+private:
+    DirEnumerationPool();
+    Q_DISABLE_COPY(DirEnumerationPool)
+
+    struct SlotBudget
+    {
+        int running { 0 };
+        int max { 0 };
+    };
+
+    static QString deviceKey(const QUrl &dir, int *limit);
+    SlotBudget &budgetOf(const QString &slotKey);
+
+private:
+    QMutex mutex;
+    QWaitCondition slotFreed;
+    QHash<QString, int> runningPerDevice;
+    SlotBudget localSlots;
+    SlotBudget remoteSlots;
+};
+
+}
+
+#endif   // DIRENUMERATIONPOOL_H
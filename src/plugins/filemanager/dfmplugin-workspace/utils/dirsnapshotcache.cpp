@@ -0,0 +1,240 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dirsnapshotcache.h"
+
+#include <dfm-base/base/standardpaths.h>
+
+#include <QFile>
+#include <QSaveFile>
+#include <QDir>
+#include <QFileInfo>
+#include <QCryptographicHash>
+
+#include <sys/stat.h>
+
+#include <cstring>
+
+using namespace dfmbase;
+using namespace dfmplugin_workspace;
+
+namespace {
+constexpr char kSnapshotMagic[8] { 'D', 'F', 'M', 'S', 'N', 'A', 'P', '\0' };
+constexpr quint32 kSnapshotVersion { 1 };
+constexpr int kMaxSnapshotCount { 64 };
+
+enum RecordFlag : quint32 {
+    kRecordFile = 0x01,
+    kRecordDir = 0x02,
+    kRecordSymLink = 0x04,
+    kRecordHide = 0x08,
+    kRecordReadable = 0x10,
+    kRecordWriteable = 0x20,
+    kRecordExecutable = 0x40,
+    kRecordStatLater = 0x80,
+};
+
+struct SnapshotHeader
+{
+    char magic[8];
+    quint32 version;
+    quint32 count;
+    quint64 device;
+    quint64 inode;
+    qint64 mtimeSec;
+    qint64 mtimeNsec;
+    qint32 sortRole;
+    qint32 sortOrder;
+    quint32 isMixDirAndFile;
+    quint32 namesSize;
+};
+
+struct SnapshotRecord
+{
+    qint64 size;
+    quint32 nameOffset;
+    quint32 nameLength;
+    quint32 flags;
+    quint32 reserved;
+};
+}   // namespace
+
+/*!
+ * \brief DirSnapshotCache::dirKey Stat the directory for the values a snapshot is bound to
+ * Take the key before enumerating, a change during the enumeration then makes the stored
+ * snapshot stale instead of hiding the change.
+ */
+bool DirSnapshotCache::dirKey(const QUrl &dir, DirSnapshotCache::DirKey *key)
+{
+    if (!key || !dir.isLocalFile())
+        return false;
+
+    struct stat st;
+    if (::stat(QFile::encodeName(dir.toLocalFile()).constData(), &st) != 0 || !S_ISDIR(st.st_mode))
+        return false;
+
+    key->device = st.st_dev;
+    key->inode = st.st_ino;
+    key->mtimeSec = st.st_mtim.tv_sec;
+    key->mtimeNsec = st.st_mtim.tv_nsec;
+    return true;
+}
+
+bool DirSnapshotCache::load(const QUrl &dir, const DirSnapshotCache::DirKey &key, DirSnapshotCache::Snapshot *snapshot)
+{
+    if (!snapshot || !key.isValid())
+        return false;
+
+    QFile file(snapshotPath(dir));
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    const qint64 fileSize = file.size();
+    if (fileSize < static_cast<qint64>(sizeof(SnapshotHeader)))
+        return false;
+
+    const uchar *data = file.map(0, fileSize);
+    if (!data)
+        return false;
+
+    SnapshotHeader header;
+    memcpy(&header, data, sizeof(header));
+    const qint64 recordsEnd = static_cast<qint64>(sizeof(SnapshotHeader)) + static_cast<qint64>(header.count) * static_cast<qint64>(sizeof(SnapshotRecord));
+    if (memcmp(header.magic, kSnapshotMagic, sizeof(kSnapshotMagic)) != 0
+        || header.version != kSnapshotVersion
+        || header.device != key.device || header.inode != key.inode
+        || header.mtimeSec != key.mtimeSec || header.mtimeNsec != key.mtimeNsec
+        || recordsEnd + header.namesSize != fileSize) {
+        file.unmap(const_cast<uchar *>(data));
+        return false;
+    }
+
+    const char *names = reinterpret_cast<const char *>(data + recordsEnd);
+    QString basePath = dir.path();
+    if (!basePath.endsWith(QDir::separator()))
+        basePath.append(QDir::separator());
+
+    QList<SortInfoPointer> children;
+    children.reserve(static_cast<int>(header.count));
+    for (quint32 i = 0; i < header.count; ++i) {
+        SnapshotRecord record;
+        memcpy(&record, data + sizeof(SnapshotHeader) + i * sizeof(SnapshotRecord), sizeof(record));
+        if (static_cast<quint64>(record.nameOffset) + record.nameLength > header.namesSize) {
+            file.unmap(const_cast<uchar *>(data));
+            return false;
+        }
+
+        QUrl childUrl(dir);
+        childUrl.setPath(basePath + QString::fromUtf8(names + record.nameOffset, static_cast<int>(record.nameLength)));
+
+        auto sortInfo = SortInfoPointer::create();
+        sortInfo->setUrl(childUrl);
+        sortInfo->setSize(record.size);
+        sortInfo->setFile(record.flags & kRecordFile);
+        sortInfo->setDir(record.flags & kRecordDir);
+        sortInfo->setSymlink(record.flags & kRecordSymLink);
+        sortInfo->setHide(record.flags & kRecordHide);
+        sortInfo->setReadable(record.flags & kRecordReadable);
+        sortInfo->setWriteable(record.flags & kRecordWriteable);
+        sortInfo->setExecutable(record.flags & kRecordExecutable);
+        sortInfo->setStatLater(record.flags & kRecordStatLater);
+        children.append(sortInfo);
+    }
+    file.unmap(const_cast<uchar *>(data));
+
+    snapshot->children = children;
+    snapshot->sortRole = static_cast<dfmio::DEnumerator::SortRoleCompareFlag>(header.sortRole);
+    snapshot->sortOrder = static_cast<Qt::SortOrder>(header.sortOrder);
+    snapshot->isMixDirAndFile = header.isMixDirAndFile;
+    return true;
+}
+
+bool DirSnapshotCache::save(const QUrl &dir, const DirSnapshotCache::DirKey &key, const DirSnapshotCache::Snapshot &snapshot)
+{
+    if (!key.isValid())
+        return false;
+
+    QByteArray names;
+    QByteArray records;
+    records.reserve(snapshot.children.count() * static_cast<int>(sizeof(SnapshotRecord)));
+    quint32 count = 0;
+    for (const auto &child : snapshot.children) {
+        if (!child)
+            continue;
+
+        const QByteArray &name = child->fileUrl().fileName().toUtf8();
+        SnapshotRecord record {};
+        record.nameOffset = static_cast<quint32>(names.size());
+        record.nameLength = static_cast<quint32>(name.size());
+        record.flags = (child->isFile() ? kRecordFile : 0)
+                | (child->isDir() ? kRecordDir : 0)
+                | (child->isSymLink() ? kRecordSymLink : 0)
+                | (child->isHide() ? kRecordHide : 0);
+        // saving must not stat the entries the enumeration left for later
+        if (child->isStatLater()) {
+            record.flags |= kRecordStatLater;
+        } else {
+            record.size = child->fileSize();
+            record.flags |= (child->isReadable() ? kRecordReadable : 0)
+                    | (child->isWriteable() ? kRecordWriteable : 0)
+                    | (child->isExecutable() ? kRecordExecutable : 0);
+        }
+        names.append(name);
+        records.append(reinterpret_cast<const char *>(&record), sizeof(record));
+        ++count;
+    }
+
+    SnapshotHeader header {};
+    memcpy(header.magic, kSnapshotMagic, sizeof(kSnapshotMagic));
+    header.version = kSnapshotVersion;
+    header.count = count;
+    header.device = key.device;
+    header.inode = key.inode;
+    header.mtimeSec = key.mtimeSec;
+    header.mtimeNsec = key.mtimeNsec;
+    header.sortRole = static_cast<qint32>(snapshot.sortRole);
+    header.sortOrder = static_cast<qint32>(snapshot.sortOrder);
+    header.isMixDirAndFile = snapshot.isMixDirAndFile;
+    header.namesSize = static_cast<quint32>(names.size());
+
+    const QString &path = snapshotPath(dir);
+    QDir().mkpath(QFileInfo(path).absolutePath());
+
+    // written to a temporary file and renamed, a reader never maps a half written snapshot
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(records);
+    file.write(names);
+    if (!file.commit()) {
+        fmWarning() << "Failed to save dir snapshot:" << path << file.errorString();
+        return false;
+    }
+
+    pruneSnapshots();
+    return true;
+}
+
+void DirSnapshotCache::remove(const QUrl &dir)
+{
+    QFile::remove(snapshotPath(dir));
+}
+
+QString DirSnapshotCache::snapshotPath(const QUrl &dir)
+{
+    const QByteArray &hash = QCryptographicHash::hash(dir.toString(QUrl::StripTrailingSlash).toUtf8(),
+                                                      QCryptographicHash::Sha1)
+                                     .toHex();
+    return QString("%1/dirsnapshots/%2.snapshot").arg(StandardPaths::location(StandardPaths::kCachePath), QString::fromLatin1(hash));
+}
+
+// keep the snapshots of the most recently listed directories only
+void DirSnapshotCache::pruneSnapshots()
+{
+    QDir dir(QString("%1/dirsnapshots").arg(StandardPaths::location(StandardPaths::kCachePath)));
+    const QFileInfoList &snapshots = dir.entryInfoList({ "*.snapshot" }, QDir::Files, QDir::Time);
+    for (int i = kMaxSnapshotCount; i < snapshots.count(); ++i)
+        QFile::remove(snapshots.at(i).absoluteFilePath());
+}
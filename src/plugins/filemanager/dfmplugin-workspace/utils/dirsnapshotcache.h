@@ -0,0 +1,58 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DIRSNAPSHOTCACHE_H
+#define DIRSNAPSHOTCACHE_H
+
+#include "dfmplugin_workspace_global.h"
+
+#include <dfm-base/interfaces/sortfileinfo.h>
+
+#include <dfm-io/denumerator.h>
+
+#include <QUrl>
+#include <QList>
+
+namespace dfmplugin_workspace {
+
+/*!
+ * \brief The DirSnapshotCache class keeps the listing of large local directories on disk
+ * A snapshot is bound to the device, inode and mtime of the directory, adding, removing or
+ * renaming an entry changes the mtime and so invalidates it. The file is mapped on load,
+ * the records are fixed size and the names are kept in one block behind them.
+ */
+class DirSnapshotCache
+{
+public:
+    struct DirKey
+    {
+        quint64 device { 0 };
+        quint64 inode { 0 };
+        qint64 mtimeSec { 0 };
+        qint64 mtimeNsec { 0 };
+
+        bool isValid() const { return inode != 0; }
+    };
+
+    struct Snapshot
+    {
+        QList<SortInfoPointer> children;
+        dfmio::DEnumerator::SortRoleCompareFlag sortRole { dfmio::DEnumerator::SortRoleCompareFlag::kSortRoleCompareDefault };
+        Qt::SortOrder sortOrder { Qt::AscendingOrder };
+        bool isMixDirAndFile { false };
+    };
+
+    static bool dirKey(const QUrl &dir, DirKey *key);
+    static bool load(const QUrl &dir, const DirKey &key, Snapshot *snapshot);
+    static bool save(const QUrl &dir, const DirKey &key, const Snapshot &snapshot);
+    static void remove(const QUrl &dir);
+
+private:
+    static QString snapshotPath(const QUrl &dir);
+    static void pruneSnapshots();
+};
+
+}
+
+#endif   // DIRSNAPSHOTCACHE_H
@@ -16,6 +16,8 @@
 
 #include <QStandardPaths>
 
+#include <algorithm>
+
 using namespace dfmplugin_workspace;
 using namespace dfmbase::Global;
 using namespace dfmio;
@@ -154,7 +156,7 @@ int FileSortWorker::getChildShowIndex(const QUrl &url)
 QList<QUrl> FileSortWorker::getChildrenUrls()
 {
     QReadLocker lk(&locker);
-    return visibleChildren;
+    return visibleChildren.toList();
 }
 
 QDir::Filters FileSortWorker::getFilters() const
@@ -351,10 +353,10 @@ void FileSortWorker::handleWatcherRemoveChildren(const QList<SortInfoPointer> &c
         int showIndex = -1;
         {
             QReadLocker lk(&locker);
-            if (!visibleChildren.contains(sortInfo->fileUrl()))
-                continue;
             showIndex = visibleChildren.indexOf(sortInfo->fileUrl());
         }
+        if (showIndex < 0)
+            continue;
 
         Q_EMIT removeRows(showIndex, 1);
         removed = true;
@@ -486,15 +488,13 @@ bool FileSortWorker::handleUpdateFile(const QUrl &url)
     if (!sortInfo)
         return false;
 
-    bool childVisible = false;
     int childIndex = -1;
     {
         QReadLocker lk(&locker);
-        childVisible = visibleChildren.contains(url);
         childIndex = visibleChildren.indexOf(url);
     }
 
-    if (childVisible) {
+    if (childIndex >= 0) {
         if (!checkFilters(sortInfo, true)) {
             Q_EMIT removeRows(childIndex, 1);
             {
@@ -552,7 +552,7 @@ bool FileSortWorker::handleUpdateFile(const QUrl &url)
         {
             QWriteLocker lk(&locker);
 
-            insertToList(visibleChildren, showIndex, sortInfo->fileUrl());
+            visibleChildren.insert(showIndex, sortInfo->fileUrl());
         }
         added = true;
 
@@ -861,7 +861,7 @@ void FileSortWorker::filterAndSortFiles(const QUrl &dir, const bool fileter, con
     if (istree)
         visibleList = sortAllTreeFilesByParent(dir, reverse);
     else {
-        visibleList = sortTreeFiles(visibleTreeChildren.contains(current) ? visibleTreeChildren[current] : visibleChildren, reverse);
+        visibleList = sortTreeFiles(visibleTreeChildren.contains(current) ? visibleTreeChildren[current] : visibleChildren.toList(), reverse);
     }
 
     // 执行界面刷新  设置过滤，当前的目录是当前树的根目录，反序。所有的显示url都要改变
@@ -890,7 +890,7 @@ void FileSortWorker::resortCurrent(const bool reverse)
     if (istree)
         visibleList = sortAllTreeFilesByParent(current, reverse);
     else {
-        visibleList = sortTreeFiles(visibleTreeChildren.contains(current) ? visibleTreeChildren[current] : visibleChildren, reverse);
+        visibleList = sortTreeFiles(visibleTreeChildren.contains(current) ? visibleTreeChildren[current] : visibleChildren.toList(), reverse);
     }
 
     resortVisibleChildren(visibleList);
@@ -1029,7 +1029,7 @@ bool FileSortWorker::addChild(const SortInfoPointer &sortInfo,
     Q_EMIT insertRows(showIndex, 1);
     {
         QWriteLocker lk(&locker);
-        insertToList(visibleChildren, showIndex, sortInfo->fileUrl());
+        visibleChildren.insert(showIndex, sortInfo->fileUrl());
     }
 
     if (sort == AbstractSortFilter::SortScenarios::kSortScenariosWatcherAddFile)
@@ -1131,7 +1131,7 @@ QList<QUrl> FileSortWorker::sortAllTreeFilesByParent(const QUrl &dir, const bool
 
             QList<QUrl> sortList {};
             if (visibleTreeChildren.isEmpty() && UniversalUtils::urlEquals(parent, current)) {
-                sortList = sortTreeFiles(visibleChildren, reverse);
+                sortList = sortTreeFiles(visibleChildren.toList(), reverse);
             } else {
                 sortList = bSort ? sortTreeFiles(visibleTreeChildren.take(parent), reverse) : visibleTreeChildren.value(parent);
             }
@@ -1169,16 +1169,25 @@ QList<QUrl> FileSortWorker::sortTreeFiles(const QList<QUrl> &children, const boo
     }
 
     QList<QUrl> sortList;
+    if (!reverse) {
+        sortList = sortUrls(children);
+        if (isCanceled)
+            return {};
+        if (sortList.isEmpty())
+            return {};
+
+        visibleTreeChildren.insert(parentUrl, sortList);
+        return sortList;
+    }
+
     int sortIndex = 0;
-    QHash<QUrl, SortInfoPointer> sortInfos = reverse && !isMixDirAndFile ? this->children.value(parentUrl)
-                                                                         : QHash<QUrl, SortInfoPointer>();
+    QHash<QUrl, SortInfoPointer> sortInfos = !isMixDirAndFile ? this->children.value(parentUrl)
+                                                              : QHash<QUrl, SortInfoPointer>();
     bool firstFile = false;
     for (const auto &url : children) {
         if (isCanceled)
             return {};
-        if (!reverse) {
-            sortIndex = insertSortList(url, sortList, AbstractSortFilter::SortScenarios::kSortScenariosNormal);
-        } else if (!firstFile && !isMixDirAndFile) {
+        if (!firstFile && !isMixDirAndFile) {
             auto sortInfo = sortInfos.value(url);
             if (sortInfo && sortInfo->isFile()) {
                 firstFile = true;
@@ -1329,15 +1338,11 @@ void FileSortWorker::removeVisibleChildren(const int startPos, const int size)
         return;
     Q_EMIT removeRows(startPos, size);
     {
-        auto tmp = getChildrenUrls();
-        QList<QUrl> visibleList;
-        visibleList.append(tmp.mid(0, startPos));
-        visibleList.append(tmp.mid(startPos + size));
         if (isCanceled)
             return;
 
         QWriteLocker lk(&locker);
-        visibleChildren = visibleList;
+        visibleChildren.remove(startPos, size);
     }
 
     Q_EMIT removeFinish();
@@ -1378,10 +1383,12 @@ int FileSortWorker::insertSortList(const QUrl &needNode, const QList<QUrl> &list
     if (isCanceled)
         return 0;
 
-    if ((sortOrder == Qt::AscendingOrder) ^ !lessThan(needNode, list.first(), sort))
+    // the inserted node takes part in every comparison, resolve its info only once
+    const SortEntry needEntry = sortEntry(needNode);
+    if ((sortOrder == Qt::AscendingOrder) ^ !lessThan(needEntry, sortEntry(list.first()), sort))
         return 0;
 
-    if ((sortOrder == Qt::AscendingOrder) ^ lessThan(needNode, list.last(), sort))
+    if ((sortOrder == Qt::AscendingOrder) ^ lessThan(needEntry, sortEntry(list.last()), sort))
         return list.count();
 
     int row = (begin + end) / 2;
@@ -1395,7 +1402,7 @@ int FileSortWorker::insertSortList(const QUrl &needNode, const QList<QUrl> &list
             break;
 
         const QUrl &node = list.at(row);
-        if ((sortOrder == Qt::AscendingOrder) ^ lessThan(needNode, node, sort)) {
+        if ((sortOrder == Qt::AscendingOrder) ^ lessThan(needEntry, sortEntry(node), sort)) {
             begin = row;
             row = (end + begin + 1) / 2;
             if (row >= end)
@@ -1409,21 +1416,64 @@ int FileSortWorker::insertSortList(const QUrl &needNode, const QList<QUrl> &list
     return row;
 }
 
+/*!
+ * \brief FileSortWorker::sortUrls Sort the urls in the current order
+ * The sort data of every url is resolved once up front, then a single merge sort replaces
+ * the binary insert of every url into the growing result list.
+ */
+QList<QUrl> FileSortWorker::sortUrls(const QList<QUrl> &urls)
+{
+    QVector<QPair<QUrl, SortEntry>> entries;
+    entries.reserve(urls.count());
+    for (const auto &url : urls)
+        entries.append({ url, sortEntry(url) });
+
+    const bool ascending = sortOrder == Qt::AscendingOrder;
+    std::stable_sort(entries.begin(), entries.end(), [this, ascending](const QPair<QUrl, SortEntry> &left, const QPair<QUrl, SortEntry> &right) {
+        return ascending ? lessThan(left.second, right.second, AbstractSortFilter::SortScenarios::kSortScenariosNormal)
+                         : lessThan(right.second, left.second, AbstractSortFilter::SortScenarios::kSortScenariosNormal);
+    });
+
+    QList<QUrl> sorted;
+    sorted.reserve(entries.count());
+    for (const auto &entry : entries)
+        sorted.append(entry.first);
+    return sorted;
+}
+
+FileSortWorker::SortEntry FileSortWorker::sortEntry(const QUrl &url)
+{
+    SortEntry entry;
+    const auto &item = childrenDataMap.value(url);
+    if (item) {
+        entry.info = item->fileInfo();
+        entry.sortInfo = item->sortFileInfo();
+    }
+    if (!entry.info)
+        entry.info = InfoFactory::create<FileInfo>(url);
+    // only a name sort compares the keys, other roles fall back to the names on ties only.
+    // the key lives as long as the sort, entries do not keep one each
+    if (entry.info && orgSortRole == kItemFileDisplayNameRole)
+        entry.nameKey = FileUtils::collationKey(data(entry.info, kItemFileDisplayNameRole).toString());
+    return entry;
+}
+
 // 左边比右边小返回true，
 bool FileSortWorker::lessThan(const QUrl &left, const QUrl &right, AbstractSortFilter::SortScenarios sort)
 {
     if (isCanceled)
         return false;
 
-    const auto &leftItem = childrenDataMap.value(left);
-    const auto &rightItem = childrenDataMap.value(right);
+    return lessThan(sortEntry(left), sortEntry(right), sort);
+}
 
-    const FileInfoPointer leftInfo = leftItem && leftItem->fileInfo()
-            ? leftItem->fileInfo()
-            : InfoFactory::create<FileInfo>(left);
-    const FileInfoPointer rightInfo = rightItem && rightItem->fileInfo()
-            ? rightItem->fileInfo()
-            : InfoFactory::create<FileInfo>(right);
+bool FileSortWorker::lessThan(const SortEntry &left, const SortEntry &right, AbstractSortFilter::SortScenarios sort)
+{
+    if (isCanceled)
+        return false;
+
+    const FileInfoPointer &leftInfo = left.info;
+    const FileInfoPointer &rightInfo = right.info;
 
     if (!leftInfo)
         return false;
@@ -1448,6 +1498,13 @@ bool FileSortWorker::lessThan(const QUrl &left, const QUrl &right, AbstractSortF
     if (isCanceled)
         return false;
 
+    // names compare by their collation keys, see FileUtils::collationKey, equal keys by the names
+    if (!left.nameKey.isEmpty() && !right.nameKey.isEmpty()) {
+        if (left.nameKey != right.nameKey)
+            return left.nameKey < right.nameKey;
+        return leftInfo->displayOf(DisPlayInfoType::kFileDisplayName) < rightInfo->displayOf(DisPlayInfoType::kFileDisplayName);
+    }
+
     QVariant leftData = data(leftInfo, orgSortRole);
     QVariant rightData = data(rightInfo, orgSortRole);
 
@@ -1693,27 +1750,19 @@ int FileSortWorker::indexOfVisibleChild(const QUrl &itemUrl)
 
 int FileSortWorker::setVisibleChildren(const int startPos, const QList<QUrl> &filterUrls, const FileSortWorker::InsertOpt opt, const int endPos)
 {
-    QList<QUrl> visibleList;
-    if (opt == InsertOpt::kInsertOptForce) {
-        visibleList = filterUrls;
-    } else {
-        auto tmp = getChildrenUrls();
-        visibleList.append(tmp.mid(0, startPos));
-        visibleList.append(filterUrls);
-        if (opt == InsertOpt::kInsertOptReplace) {
-            visibleList.append(tmp.mid(endPos != -1 ? endPos : startPos + filterUrls.length()));
-        } else if (opt == InsertOpt::kInsertOptAppend) {
-            visibleList.append(tmp.mid(startPos));
-        }
-    }
-
     if (isCanceled)
         return -1;
 
     QWriteLocker lk(&locker);
-    visibleChildren = visibleList;
+    if (opt == InsertOpt::kInsertOptForce) {
+        visibleChildren.setUrls(filterUrls);
+    } else {
+        if (opt == InsertOpt::kInsertOptReplace)
+            visibleChildren.remove(startPos, (endPos != -1 ? endPos : startPos + filterUrls.length()) - startPos);
+        visibleChildren.insert(startPos, filterUrls);
+    }
 
-    return visibleList.length();
+    return visibleChildren.count();
 }
 
 bool FileSortWorker::checkAndUpdateFileInfoUpdate()
@@ -7,6 +7,7 @@
 
 #include "dfmplugin_workspace_global.h"
 #include "models/fileitemdata.h"
+#include "utils/visibleurllist.h"
 #include <dfm-base/dfm_global_defines.h>
 #include <dfm-base/interfaces/fileinfo.h>
 #include <dfm-base/interfaces/abstractsortfilter.h>
@@ -38,6 +39,14 @@ class FileSortWorker : public QObject
         kInsertOptForce = 2,
     };
 
+    // what a comparison needs of one url, resolved once per sort instead of once per comparison
+    struct SortEntry
+    {
+        FileInfoPointer info { nullptr };
+        SortInfoPointer sortInfo { nullptr };
+        QByteArray nameKey;   // collation key of the displayed name when sorting by name, built once per sort
+    };
+
 public:
     explicit FileSortWorker(const QUrl &url,
                             const QString &key,
@@ -195,6 +204,9 @@ private:
     int insertSortList(const QUrl &needNode, const QList<QUrl> &list,
                        AbstractSortFilter::SortScenarios sort);
     bool lessThan(const QUrl &left, const QUrl &right, AbstractSortFilter::SortScenarios sort);
+    bool lessThan(const SortEntry &left, const SortEntry &right, AbstractSortFilter::SortScenarios sort);
+    SortEntry sortEntry(const QUrl &url);
+    QList<QUrl> sortUrls(const QList<QUrl> &urls);
     QVariant data(const FileInfoPointer &info, Global::ItemRoles role);
 
     bool checkFilters(const SortInfoPointer &sortInfo, const bool byInfo = false);
@@ -217,7 +229,7 @@ private:
     QReadWriteLock childrenDataLocker;
     QHash<QUrl, FileItemDataPointer> childrenDataMap {};
     QHash<QUrl, FileItemDataPointer> childrenDataLastMap {};
-    QList<QUrl> visibleChildren {};
+    VisibleUrlList visibleChildren;
     QReadWriteLock locker;
     AbstractSortFilterPointer sortAndFilter { nullptr };
     FileViewFilterCallback filterCallback { nullptr };
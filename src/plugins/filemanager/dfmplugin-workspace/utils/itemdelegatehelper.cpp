@@ -10,11 +10,23 @@
 #include <QPainter>
 #include <QApplication>
 #include <QPainterPath>
+#include <QCache>
 
 #include <cmath>
 
 #define CEIL(x) (static_cast<int>(std::ceil(x)))
 
+// 列表模式每次滚动会重绘上百行，缓存的排版结果足够覆盖数屏内容
+static constexpr int kMaxCachedTextLayouts { 4096 };
+
+namespace {
+struct CachedTextLines
+{
+    QList<QRectF> rects;   // 相对于排版区域左上角
+    QStringList lines;
+};
+}
+
 using namespace dfmplugin_workspace;
 using namespace dfmbase;
 
@@ -74,8 +86,7 @@ void ItemDelegateHelper::paintIcon(QPainter *painter, const QIcon &icon, const P
         // 绘制带有阴影的背景
         auto stroke { iconStyle.stroke };
         backgroundRect.adjust(-stroke, -stroke, stroke, stroke);
-        const auto &originPixmap { IconUtils::renderIconBackground(backgroundRect.size(), iconStyle) };
-        const auto &shadowPixmap { IconUtils::addShadowToPixmap(originPixmap, iconStyle.shadowOffset, iconStyle.shadowRange, 0.2) };
+        const auto &shadowPixmap { IconUtils::renderShadowedIconBackground(backgroundRect.size(), iconStyle, 0.2) };
         painter->drawPixmap(backgroundRect, shadowPixmap);
         imageRect.adjust(iconStyle.shadowRange, iconStyle.shadowRange, -iconStyle.shadowRange, -iconStyle.shadowRange);
 
@@ -158,6 +169,44 @@ void ItemDelegateHelper::hideTooltipImmediately()
     }
 }
 
+/*!
+ * \brief ItemDelegateHelper::layoutCachedText 使用缓存的排版结果绘制单行或多行省略文本
+ * 缓存以文本、区域大小、字体、行高、对齐和省略方式为键，文件更新、列宽变化或字体变化都会得到新的键，
+ * 旧的排版结果按最近最少使用淘汰。只能在 GUI 线程中调用。
+ * \param painter 提供字体和文字方向，draw 为 false 时只返回排版后的文本行
+ * \return 省略后的文本行
+ */
+QStringList ItemDelegateHelper::layoutCachedText(const QString &text, const QRectF &rect, qreal lineHeight, int alignmentFlag,
+                                                 Qt::TextElideMode elideMode, QPainter *painter, bool draw)
+{
+    static QCache<QString, CachedTextLines> cache(kMaxCachedTextLayouts);
+
+    const QFont &font = painter->font();
+    // 文本最后拼接，文件名中的 %1 等字符不会被当作占位符
+    const QString &key = QString::number(rect.width()) + 'x' + QString::number(rect.height())
+            + '_' + QString::number(lineHeight) + '_' + QString::number(alignmentFlag)
+            + '_' + QString::number(static_cast<int>(elideMode))
+            + '_' + QString::number(static_cast<int>(painter->layoutDirection()))
+            + '_' + font.key() + QChar(0x1f) + text;
+
+    CachedTextLines *cached = cache.object(key);
+    if (!cached) {
+        cached = new CachedTextLines;
+        QScopedPointer<ElideTextLayout> layout(createTextLayout(text, QTextOption::WrapAtWordBoundaryOrAnywhere,
+                                                                lineHeight, alignmentFlag, painter));
+        cached->rects = layout->layout(QRectF(QPointF(0, 0), rect.size()), elideMode, nullptr, Qt::NoBrush, &cached->lines);
+        cache.insert(key, cached);
+    }
+
+    if (draw) {
+        for (int i = 0; i < cached->rects.size() && i < cached->lines.size(); ++i)
+            painter->drawText(cached->rects.at(i).translated(rect.topLeft()),
+                              Qt::AlignAbsolute | Qt::AlignLeft | Qt::AlignTop, cached->lines.at(i));
+    }
+
+    return cached->lines;
+}
+
 ElideTextLayout *ItemDelegateHelper::createTextLayout(const QString &name, QTextOption::WrapMode wordWrap,
                                                       qreal lineHeight, int alignmentFlag, QPainter *painter)
 {
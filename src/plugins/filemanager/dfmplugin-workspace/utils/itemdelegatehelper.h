@@ -65,6 +65,8 @@ public:
 
     static dfmbase::ElideTextLayout *createTextLayout(const QString &name, QTextOption::WrapMode wordWrap,
                                                       qreal lineHeight, int alignmentFlag, QPainter *painter = nullptr);
+    static QStringList layoutCachedText(const QString &text, const QRectF &rect, qreal lineHeight, int alignmentFlag,
+                                        Qt::TextElideMode elideMode, QPainter *painter, bool draw = true);
 
 private:
     static void drawBackground(const qreal &backgroundRadius, const QRectF &rect,
@@ -3,19 +3,43 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "traversaldirthreadmanager.h"
+#include "direnumerationpool.h"
 #include <dfm-base/base/schemefactory.h>
 #include <dfm-base/file/local/localdiriterator.h>
 #include <dfm-base/utils/fileutils.h>
 
+#include <dfm-io/dfmio_utils.h>
+
 #include <QElapsedTimer>
 #include <QDebug>
 
+#include <cerrno>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
 typedef QList<QSharedPointer<DFMBASE_NAMESPACE::SortFileInfo>>& SortInfoList;
 
 using namespace dfmbase;
 using namespace dfmplugin_workspace;
 USING_IO_NAMESPACE
 
+namespace {
+// the record layout of getdents64, glibc has no declaration for it
+struct LinuxDirent64
+{
+    ino64_t d_ino;
+    off64_t d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[];
+};
+constexpr int kDirentBufferSize { 64 * 1024 };
+}
+
 TraversalDirThreadManager::TraversalDirThreadManager(const QUrl &url,
                                                      const QStringList &nameFilters,
                                                      QDir::Filters filters,
@@ -108,17 +132,30 @@ void TraversalDirThreadManager::run()
 
     QElapsedTimer timer;
     timer.start();
-    fmInfo() << "dir query start, url: " << dirUrl;
+
+    QString slotKey;
+    if (!DirEnumerationPool::instance()->acquire(dirUrl, &slotKey, [this]() { return stopFlag; })) {
+        emit traversalFinished(traversalToken);
+        running = false;
+        return;
+    }
+    fmInfo() << "dir query start, url: " << dirUrl << " wait slot elapsed: " << timer.elapsed();
 
     int count = 0;
     if (!dirIterator->oneByOne()) {
-        const QList<SortInfoPointer> &fileList = iteratorAll();
+        const bool localListing = canIteratorLocalDir();
+        const QList<SortInfoPointer> &fileList = localListing ? iteratorLocalDir() : iteratorAll();
         count = fileList.count();
         fmInfo() << "local dir query end, file count: " << count << " url: " << dirUrl << " elapsed: " << timer.elapsed();
-        createFileInfo(fileList);
+        DirEnumerationPool::instance()->release(slotKey);
+        // the direct listing defers the stat of its entries, the view creates the file infos of
+        // the rows it shows, creating them all here would stat every entry again
+        if (!localListing)
+            createFileInfo(fileList);
     } else {
         count = iteratorOneByOne(timer);
         fmInfo() << "dir query end, file count: " << count << " url: " << dirUrl << " elapsed: " << timer.elapsed();
+        DirEnumerationPool::instance()->release(slotKey);
     }
     running = false;
 }
@@ -215,6 +252,114 @@ QList<SortInfoPointer> TraversalDirThreadManager::iteratorAll()
     return fileList;
 }
 
+/*!
+ * \brief TraversalDirThreadManager::canIteratorLocalDir Whether the entries can be read directly
+ * The direct listing does not sort, it is used when the view sorts by name anyway and the
+ * traversal does not filter by name or type. Hidden entries are filtered by the listing itself.
+ */
+bool TraversalDirThreadManager::canIteratorLocalDir() const
+{
+    if (!dirUrl.isLocalFile() || !nameFilters.isEmpty())
+        return false;
+
+    if (sortRole != DEnumerator::SortRoleCompareFlag::kSortRoleCompareDefault
+        && sortRole != DEnumerator::SortRoleCompareFlag::kSortRoleCompareFileName)
+        return false;
+
+    const QDir::Filters listAll = QDir::AllEntries | QDir::System;
+    return (filters & listAll) == listAll;
+}
+
+/*!
+ * \brief TraversalDirThreadManager::iteratorLocalDir List a local directory with getdents64
+ * Only the name, type and inode of the entries are read, symlinks and file systems that do not
+ * report the type are stated. Size and permissions are read once the view asks for them, see
+ * SortFileInfo::setStatLater. Hidden entries are skipped here unless the filters show them.
+ * The result is unsorted and left to the sort worker.
+ */
+QList<SortInfoPointer> TraversalDirThreadManager::iteratorLocalDir()
+{
+    const QString &dirPath = dirUrl.toLocalFile();
+    const int fd = ::open(QFile::encodeName(dirPath).constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) {
+        fmWarning() << "open dir failed, fall back to the dir iterator, url: " << dirUrl << strerror(errno);
+        return iteratorAll();
+    }
+    Q_EMIT iteratorInitFinished();
+
+    QString basePath = dirUrl.path();
+    if (!basePath.endsWith(QDir::separator()))
+        basePath.append(QDir::separator());
+    const QSet<QString> &hideList = DFMUtils::hideListFromUrl(QUrl::fromLocalFile(basePath + ".hidden"));
+    const bool showHidden = filters.testFlag(QDir::Hidden);
+
+    QList<SortInfoPointer> fileList;
+    QByteArray buffer(kDirentBufferSize, Qt::Uninitialized);
+    while (!stopFlag) {
+        const long readSize = ::syscall(SYS_getdents64, fd, buffer.data(), buffer.size());
+        if (readSize <= 0) {
+            if (readSize < 0)
+                fmWarning() << "getdents64 failed, url: " << dirUrl << strerror(errno);
+            break;
+        }
+
+        for (long offset = 0; offset < readSize;) {
+            const auto *entry = reinterpret_cast<const LinuxDirent64 *>(buffer.constData() + offset);
+            offset += entry->d_reclen;
+
+            const char *name = entry->d_name;
+            if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')))
+                continue;
+            // dot entries are hidden without decoding the name, the .hidden list needs it
+            if (!showHidden && name[0] == '.')
+                continue;
+            const QString &fileName = QFile::decodeName(name);
+            const bool isHide = name[0] == '.' || hideList.contains(fileName);
+            if (!showHidden && isHide)
+                continue;
+
+            unsigned char type = entry->d_type;
+            bool isSymLink = type == DT_LNK;
+            if (type == DT_UNKNOWN || isSymLink) {
+                struct stat st;
+                if (::fstatat(fd, name, &st, 0) == 0)
+                    type = S_ISDIR(st.st_mode) ? DT_DIR : (S_ISREG(st.st_mode) ? DT_REG : DT_UNKNOWN);
+                else
+                    type = DT_UNKNOWN;
+                if (!isSymLink) {
+                    struct stat lst;
+                    isSymLink = ::fstatat(fd, name, &lst, AT_SYMLINK_NOFOLLOW) == 0 && S_ISLNK(lst.st_mode);
+                }
+            }
+
+            QUrl childUrl(dirUrl);
+            childUrl.setPath(basePath + fileName);
+
+            auto sortInfo = SortInfoPointer::create();
+            sortInfo->setUrl(childUrl);
+            sortInfo->setDir(type == DT_DIR);
+            sortInfo->setFile(type == DT_REG);
+            sortInfo->setSymlink(isSymLink);
+            sortInfo->setHide(isHide);
+            sortInfo->setStatLater(true);
+            fileList.append(sortInfo);
+        }
+    }
+    ::close(fd);
+
+    if (stopFlag) {
+        emit traversalFinished(traversalToken);
+        return {};
+    }
+
+    // unsorted, the sort worker orders the children by its own name keys
+    emit updateLocalChildren(fileList, DEnumerator::SortRoleCompareFlag::kSortRoleCompareDefault,
+                             sortOrder, isMixDirAndFile, traversalToken);
+    emit traversalFinished(traversalToken);
+
+    return fileList;
+}
+
 void TraversalDirThreadManager::createFileInfo(const QList<SortInfoPointer> &list)
 {
     for (const SortInfoPointer &sortInfo : list) {
@@ -68,6 +68,8 @@ protected:
 private:
     int iteratorOneByOne(const QElapsedTimer &timere);
     QList<SortInfoPointer> iteratorAll();
+    bool canIteratorLocalDir() const;
+    QList<SortInfoPointer> iteratorLocalDir();
     void createFileInfo(const QList<SortInfoPointer> &list);
 };
 }
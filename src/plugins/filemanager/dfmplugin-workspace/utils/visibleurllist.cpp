@@ -0,0 +1,257 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "visibleurllist.h"
+
+using namespace dfmplugin_workspace;
+
+// a chunk is split once it grows beyond kMaxChunkSize, bulk loads fill chunks to half of it
+// so that the following inserts do not split at once
+static constexpr int kMaxChunkSize { 512 };
+static constexpr int kFillChunkSize { kMaxChunkSize / 2 };
+
+int VisibleUrlList::count() const
+{
+    return total;
+}
+
+bool VisibleUrlList::isEmpty() const
+{
+    return total == 0;
+}
+
+QUrl VisibleUrlList::at(const int row) const
+{
+    if (row < 0 || row >= total)
+        return QUrl();
+
+    const auto &chunk = chunks.at(chunkIndexOfRow(row));
+    return chunk->urls.at(row - chunk->start);
+}
+
+int VisibleUrlList::indexOf(const QUrl &url) const
+{
+    const Chunk *chunk = urlChunks.value(url, nullptr);
+    if (!chunk)
+        return -1;
+
+    const int offset = chunk->urls.indexOf(url);
+    return offset < 0 ? -1 : chunk->start + offset;
+}
+
+bool VisibleUrlList::contains(const QUrl &url) const
+{
+    return indexOf(url) >= 0;
+}
+
+QList<QUrl> VisibleUrlList::toList() const
+{
+    QList<QUrl> urls;
+    urls.reserve(total);
+    for (const auto &chunk : chunks)
+        urls.append(chunk->urls);
+    return urls;
+}
+
+/*!
+ * \brief VisibleUrlList::insert Insert an url before the row, out of range rows append it
+ */
+void VisibleUrlList::insert(const int row, const QUrl &url)
+{
+    if (chunks.isEmpty())
+        chunks.append(ChunkPointer(new Chunk));
+
+    const int pos = (row < 0 || row >= total) ? total : row;
+    const int index = pos == total ? chunks.count() - 1 : chunkIndexOfRow(pos);
+    Chunk *chunk = chunks.at(index).data();
+    chunk->urls.insert(pos - chunk->start, url);
+    urlChunks.insert(url, chunk);
+    ++total;
+
+    if (chunk->urls.count() > kMaxChunkSize)
+        splitChunk(index);
+    updateStarts(index + 1);
+}
+
+/*!
+ * \brief VisibleUrlList::insert Insert urls before the row, out of range rows append them
+ * Only the chunk at the row is split, the urls go into new chunks behind it, so the cost
+ * does not depend on the rows around the insert position.
+ */
+void VisibleUrlList::insert(const int row, const QList<QUrl> &urls)
+{
+    if (urls.isEmpty())
+        return;
+    if (chunks.isEmpty())
+        chunks.append(ChunkPointer(new Chunk));
+
+    const int pos = (row < 0 || row >= total) ? total : row;
+    const int index = pos == total ? chunks.count() - 1 : chunkIndexOfRow(pos);
+    Chunk *chunk = chunks.at(index).data();
+    const int offset = pos - chunk->start;
+
+    if (chunk->urls.count() + urls.count() <= kMaxChunkSize) {
+        QList<QUrl> merged;
+        merged.reserve(chunk->urls.count() + urls.count());
+        merged.append(chunk->urls.mid(0, offset));
+        merged.append(urls);
+        merged.append(chunk->urls.mid(offset));
+        chunk->urls = merged;
+        for (const auto &url : urls)
+            urlChunks.insert(url, chunk);
+    } else {
+        QVector<ChunkPointer> added;
+        added.reserve(urls.count() / kFillChunkSize + 2);
+        for (int i = 0; i < urls.count(); i += kFillChunkSize) {
+            ChunkPointer next(new Chunk);
+            next->urls = urls.mid(i, kFillChunkSize);
+            for (const auto &url : next->urls)
+                urlChunks.insert(url, next.data());
+            added.append(next);
+        }
+
+        // the rows behind the insert position move to a chunk of their own
+        if (offset < chunk->urls.count()) {
+            ChunkPointer tail(new Chunk);
+            tail->urls = chunk->urls.mid(offset);
+            chunk->urls.erase(chunk->urls.begin() + offset, chunk->urls.end());
+            for (const auto &url : tail->urls)
+                urlChunks.insert(url, tail.data());
+            added.append(tail);
+        }
+
+        QVector<ChunkPointer> merged;
+        merged.reserve(chunks.count() + added.count());
+        merged.append(chunks.mid(0, chunk->urls.isEmpty() ? index : index + 1));
+        merged.append(added);
+        merged.append(chunks.mid(index + 1));
+        chunks.swap(merged);
+    }
+
+    total += urls.count();
+    updateStarts(index);
+}
+
+void VisibleUrlList::removeAt(const int row)
+{
+    if (row < 0 || row >= total)
+        return;
+
+    const int index = chunkIndexOfRow(row);
+    Chunk *chunk = chunks.at(index).data();
+    const QUrl &url = chunk->urls.takeAt(row - chunk->start);
+    if (urlChunks.value(url) == chunk && !chunk->urls.contains(url))
+        urlChunks.remove(url);
+    --total;
+
+    if (chunk->urls.isEmpty()) {
+        chunks.remove(index);
+        updateStarts(index);
+    } else {
+        updateStarts(index + 1);
+    }
+}
+
+/*!
+ * \brief VisibleUrlList::remove Remove `count` rows starting at the row
+ * Only the chunks holding the removed rows are touched, emptied chunks are dropped.
+ */
+void VisibleUrlList::remove(const int row, const int count)
+{
+    if (row < 0 || row >= total || count <= 0)
+        return;
+
+    const int end = qMin(total, row + count);
+    const int first = chunkIndexOfRow(row);
+    int index = first;
+    // chunk starts keep their old values until updateStarts, so rows stay in old coordinates
+    for (int pos = row; pos < end; ++index) {
+        Chunk *chunk = chunks.at(index).data();
+        const int from = pos - chunk->start;
+        const int to = qMin(chunk->urls.count(), end - chunk->start);
+        for (int i = from; i < to; ++i) {
+            if (urlChunks.value(chunk->urls.at(i)) == chunk)
+                urlChunks.remove(chunk->urls.at(i));
+        }
+        pos = chunk->start + to;
+        chunk->urls.erase(chunk->urls.begin() + from, chunk->urls.begin() + to);
+        // an url may be listed twice in one chunk, keep the ones left findable
+        for (const auto &url : chunk->urls)
+            urlChunks.insert(url, chunk);
+    }
+
+    for (int i = index - 1; i >= first; --i) {
+        if (chunks.at(i)->urls.isEmpty())
+            chunks.remove(i);
+    }
+    total -= end - row;
+    updateStarts(first);
+}
+
+void VisibleUrlList::setUrls(const QList<QUrl> &urls)
+{
+    clear();
+    urlChunks.reserve(urls.count());
+    chunks.reserve(urls.count() / kFillChunkSize + 1);
+
+    for (int i = 0; i < urls.count(); i += kFillChunkSize) {
+        ChunkPointer chunk(new Chunk);
+        chunk->urls = urls.mid(i, kFillChunkSize);
+        chunk->start = i;
+        for (const auto &url : chunk->urls)
+            urlChunks.insert(url, chunk.data());
+        chunks.append(chunk);
+    }
+    total = urls.count();
+}
+
+void VisibleUrlList::clear()
+{
+    chunks.clear();
+    urlChunks.clear();
+    total = 0;
+}
+
+// the last chunk whose first row is not behind the row
+int VisibleUrlList::chunkIndexOfRow(const int row) const
+{
+    int begin = 0;
+    int end = chunks.count() - 1;
+    while (begin < end) {
+        const int mid = (begin + end + 1) / 2;
+        if (chunks.at(mid)->start <= row)
+            begin = mid;
+        else
+            end = mid - 1;
+    }
+    return begin;
+}
+
+void VisibleUrlList::splitChunk(const int index)
+{
+    Chunk *chunk = chunks.at(index).data();
+    const int half = chunk->urls.count() / 2;
+
+    ChunkPointer next(new Chunk);
+    next->urls = chunk->urls.mid(half);
+    chunk->urls.erase(chunk->urls.begin() + half, chunk->urls.end());
+    for (const auto &url : next->urls)
+        urlChunks.insert(url, next.data());
+
+    chunks.insert(index + 1, next);
+}
+
+void VisibleUrlList::updateStarts(const int fromIndex)
+{
+    int start = 0;
+    if (fromIndex > 0) {
+        const auto &prev = chunks.at(fromIndex - 1);
+        start = prev->start + prev->urls.count();
+    }
+
+    for (int i = fromIndex; i < chunks.count(); ++i) {
+        chunks[i]->start = start;
+        start += chunks.at(i)->urls.count();
+    }
+}
@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef VISIBLEURLLIST_H
+#define VISIBLEURLLIST_H
+
+#include "dfmplugin_workspace_global.h"
+
+#include <QUrl>
+#include <QList>
+#include <QVector>
+#include <QHash>
+#include <QSharedPointer>
+
+namespace dfmplugin_workspace {
+
+/*!
+ * \brief The VisibleUrlList class keeps the rows of the view in small chunks
+ * Every url knows its chunk and every chunk knows its first row, so looking up the row of an
+ * url, inserting and removing a row only touch one chunk plus the chunk offsets instead of
+ * scanning or moving the whole list.
+ * Const members do not modify anything and may be called by several readers at once.
+ */
+class VisibleUrlList
+{
+    Q_DISABLE_COPY(VisibleUrlList)
+
+public:
+    VisibleUrlList() = default;
+
+    int count() const;
+    bool isEmpty() const;
+    QUrl at(const int row) const;
+    int indexOf(const QUrl &url) const;
+    bool contains(const QUrl &url) const;
+    QList<QUrl> toList() const;
+
+    void insert(const int row, const QUrl &url);
+    void insert(const int row, const QList<QUrl> &urls);
+    void removeAt(const int row);
+    void remove(const int row, const int count);
+    void setUrls(const QList<QUrl> &urls);
+    void clear();
+
+private:
+    struct Chunk
+    {
+        QList<QUrl> urls;
+        int start { 0 };
+    };
+    using ChunkPointer = QSharedPointer<Chunk>;
+
+    int chunkIndexOfRow(const int row) const;
+    void splitChunk(const int index);
+    void updateStarts(const int fromIndex);
+
+private:
+    QVector<ChunkPointer> chunks;
+    QHash<QUrl, Chunk *> urlChunks;
+    int total { 0 };
+};
+
+}
+
+#endif   // VISIBLEURLLIST_H
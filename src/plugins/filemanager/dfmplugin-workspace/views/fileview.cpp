@@ -42,6 +42,7 @@
 #include <dfm-base/base/configs/dconfig/dconfigmanager.h>
 #include <dfm-base/utils/fileinfohelper.h>
 #include <dfm-base/base/device/deviceutils.h>
+#include <dfm-base/utils/thumbnail/thumbnailfactory.h>
 
 #ifdef DTKWIDGET_CLASS_DSizeMode
 #    include <DSizeMode>
@@ -2130,6 +2131,28 @@ void FileView::initializeScrollBarWatcher()
         if (d->scrollBarSliderPressed)
             d->scrollBarValueChangedTimer->start();
     });
+
+    // once scrolling settles, thumbnails of the rows on the screen are produced first
+    d->thumbnailJobTimer = new QTimer(this);
+    d->thumbnailJobTimer->setInterval(100);
+    d->thumbnailJobTimer->setSingleShot(true);
+    connect(d->thumbnailJobTimer, &QTimer::timeout, this, &FileView::updateThumbnailJobs);
+    connect(verticalScrollBar(), &QScrollBar::valueChanged, d->thumbnailJobTimer, qOverload<>(&QTimer::start));
+}
+
+void FileView::updateThumbnailJobs()
+{
+    QRect visibleRect = viewport()->rect();
+    visibleRect.moveTop(verticalOffset());
+
+    QList<QUrl> visibleUrls;
+    for (const auto &range : visibleIndexes(visibleRect)) {
+        for (int row = range.first; row <= range.second; ++row)
+            visibleUrls.append(model()->data(model()->index(row, 0, model()->rootIndex()), kItemUrlRole).toUrl());
+    }
+
+    ThumbnailFactory::instance()->cancelThumbnailJobs(rootUrl(), visibleUrls);
+    ThumbnailFactory::instance()->raiseThumbnailJobs(visibleUrls);
 }
 
 void FileView::initializePreSelectTimer()
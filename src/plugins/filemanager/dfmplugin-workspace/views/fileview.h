@@ -200,6 +200,7 @@ private:
     void initializeStatusBar();
     void initializeConnect();
     void initializeScrollBarWatcher();
+    void updateThumbnailJobs();
     void initializePreSelectTimer();
 
     void delayUpdateStatusBar();
@@ -503,11 +503,8 @@ void ListItemDelegate::paintItemColumn(QPainter *painter, const QStyleOptionView
                 painter->setPen(opt.palette.color(cGroup, QPalette::Text));
 
             if (data.canConvert<QString>()) {
-                QScopedPointer<ElideTextLayout> layout(ItemDelegateHelper::createTextLayout(index.data(rol).toString().remove('\n'),
-                                                                                            QTextOption::WrapAtWordBoundaryOrAnywhere,
-                                                                                            d->textLineHeight, index.data(Qt::TextAlignmentRole).toInt(),
-                                                                                            painter));
-                layout->layout(textRect, elideMode, painter);
+                ItemDelegateHelper::layoutCachedText(data.toString().remove('\n'), textRect, d->textLineHeight,
+                                                     index.data(Qt::TextAlignmentRole).toInt(), elideMode, painter);
             }
         }
     }
@@ -520,10 +517,7 @@ void ListItemDelegate::paintFileName(QPainter *painter, const QStyleOptionViewIt
     const QVariant &data = index.data(role);
     painter->setPen(option.palette.color(drawBackground ? QPalette::BrightText : QPalette::Text));
 
-    QScopedPointer<ElideTextLayout> layout(ItemDelegateHelper::createTextLayout("", QTextOption::WrapAtWordBoundaryOrAnywhere,
-                                                                                textLineHeight, index.data(Qt::TextAlignmentRole).toInt(),
-                                                                                painter));
-
+    const int alignment = index.data(Qt::TextAlignmentRole).toInt();
     if (data.canConvert<QString>()) {
         QString fileName {};
 
@@ -544,11 +538,11 @@ void ListItemDelegate::paintFileName(QPainter *painter, const QStyleOptionViewIt
                 if (suffix == ".")
                     break;
 
-                QStringList textList {};
-                layout->setText(index.data(kItemFileBaseNameRole).toString().remove('\n'));
                 QRectF baseNameRect = rect;
                 baseNameRect.adjust(0, 0, -option.fontMetrics.horizontalAdvance(suffix), 0);
-                layout->layout(baseNameRect, Qt::ElideRight, nullptr, Qt::NoBrush, &textList);
+                const QStringList &textList = ItemDelegateHelper::layoutCachedText(index.data(kItemFileBaseNameRole).toString().remove('\n'),
+                                                                                   baseNameRect, textLineHeight, alignment,
+                                                                                   Qt::ElideRight, painter, false);
 
                 fileName = textList.join('\n');
 
@@ -559,17 +553,11 @@ void ListItemDelegate::paintFileName(QPainter *painter, const QStyleOptionViewIt
         }
 
         if (fileName.isEmpty()) {
-            QStringList textList {};
-            layout->setText(index.data(role).toString().remove('\n'));
-            layout->layout(rect, Qt::ElideRight, nullptr, Qt::NoBrush, &textList);
-
-            fileName = fileName = textList.join('\n');
+            const QStringList &textList = ItemDelegateHelper::layoutCachedText(data.toString().remove('\n'), rect, textLineHeight,
+                                                                               alignment, Qt::ElideRight, painter, false);
+            fileName = textList.join('\n');
         }
-        QScopedPointer<ElideTextLayout> layout(ItemDelegateHelper::createTextLayout(fileName,
-                                                                                    QTextOption::WrapAtWordBoundaryOrAnywhere,
-                                                                                    textLineHeight, index.data(Qt::TextAlignmentRole).toInt(),
-                                                                                    painter));
-        layout->layout(rect, Qt::ElideRight, painter);
+        ItemDelegateHelper::layoutCachedText(fileName, rect, textLineHeight, alignment, Qt::ElideRight, painter);
     } else {
         // Todo(yanghao&liuyangming)???
         //         drawNotStringData(option, textLineHeight, rect, data, drawBackground, painter, 0);
@@ -78,6 +78,7 @@ class FileViewPrivate
 
     QTimer *scrollBarValueChangedTimer { nullptr };
     bool scrollBarSliderPressed { false };
+    QTimer *thumbnailJobTimer { nullptr };
 
     bool pressedStartWithExpand { false };
     bool mouseLeftPressed { false };
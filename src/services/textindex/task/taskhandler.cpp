@@ -7,6 +7,7 @@
 #include "progressnotifier.h"
 #include "utils/indextraverseutils.h"
 #include "utils/scopeguard.h"
+#include "utils/boundedqueue.h"
 
 #include <docparser.h>
 
@@ -24,10 +25,16 @@
 #include <QRegularExpression>
 #include <QStandardPaths>
 #include <QQueue>
+#include <QHash>
+#include <QThread>
+#include <QThreadPool>
+#include <QRunnable>
 
 #include <dirent.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
 #include <unistd.h>
 
 SERVICETEXTINDEX_USE_NAMESPACE
@@ -67,7 +74,7 @@ private:
 };
 
 // 目录遍历相关函数
-using FileHandler = std::function<void(const QString &path)>;
+using FileHandler = std::function<void(const QString &path, const struct stat &st)>;
 
 // 常量定义
 static constexpr char kSupportFiles[] { "(rtf)|(odt)|(ods)|(odp)|(odg)|(docx)|(xlsx)|(pptx)|(ppsx)|(md)|"
@@ -75,6 +82,30 @@ static constexpr char kSupportFiles[] { "(rtf)|(odt)|(ods)|(odp)|(odg)|(docx)|(x
                                         "(sh)|(html)|(htm)|(xml)|(xhtml)|(dhtml)|(shtm)|(shtml)|"
                                         "(json)|(css)|(yaml)|(ini)|(bat)|(js)|(sql)|(uof)|(ofd)" };
 
+// 流水线参数：遍历线程 -> 多个内容提取线程 -> 单个写入线程
+static constexpr int kPathQueueCapacity { 1024 };
+static constexpr int kDocumentQueueCapacity { 64 };   // 文档包含全文内容，队列不宜过长
+// IndexWriter 参数：内存缓冲写满后才落盘为一个段，批量建索引时放宽合并因子，减少段合并
+static constexpr double kRamBufferSizeMB { 64.0 };
+static constexpr int kMergeFactor { 10 };
+static constexpr int kBulkMergeFactor { 30 };
+// 后台线程的调度优先级，IO 使用 idle 级别
+static constexpr int kWorkerNice { 10 };
+static constexpr int kIoprioWhoProcess { 1 };
+static constexpr int kIoprioClassIdle { 3 };
+static constexpr int kIoprioClassShift { 13 };
+
+// 遍历线程生成、提取线程填充内容、写入线程提交的一条记录
+struct IndexJob
+{
+    QString path;
+    DocumentPtr doc;
+    bool isUpdate { false };
+};
+
+// 决定文件是否需要写入索引，以及是新增还是更新
+using FileFilter = std::function<bool(const QString &path, const struct stat &st, bool *isUpdate)>;
+
 // 文档处理相关函数
 DocumentPtr createFileDocument(const QString &file)
 {
@@ -99,91 +130,81 @@ DocumentPtr createFileDocument(const QString &file)
     return doc;
 }
 
-bool checkNeedUpdate(const QString &file, const IndexReaderPtr &reader, bool *needAdd)
-{
-    try {
-        SearcherPtr searcher = newLucene<IndexSearcher>(reader);
-        TermQueryPtr query = newLucene<TermQuery>(newLucene<Term>(L"path", file.toStdWString()));
-
-        TopDocsPtr topDocs = searcher->search(query, 1);
-        int32_t numTotalHits = topDocs->totalHits;
-        if (numTotalHits == 0) {
-            if (needAdd)
-                *needAdd = true;
-            return true;
-        }
-
-        DocumentPtr doc = searcher->doc(topDocs->scoreDocs[0]->doc);
-        QFileInfo fileInfo(file);
-        if (!fileInfo.exists())
-            return false;
-
-        const QDateTime modifyTime = fileInfo.lastModified();
-        const QString modifyEpoch = QString::number(modifyTime.toSecsSinceEpoch());
-        const String &storeTime = doc->get(L"modified");
-
-        return modifyEpoch.toStdWString() != storeTime;
-    } catch (const std::exception &e) {
-        fmWarning() << "Check update failed:" << file << e.what();
-        return false;
-    }
-}
-
+// 遍历时已确认是普通文件，这里只检查后缀
 bool isSupportedFile(const QString &path)
 {
-    QFileInfo fileInfo(path);
-    if (!fileInfo.exists() || !fileInfo.isFile())
+    const int dot = path.lastIndexOf('.');
+    if (dot < 0 || dot < path.lastIndexOf('/'))
         return false;
 
-    QString suffix = fileInfo.suffix().toLower();
+    const QString &suffix = path.mid(dot + 1).toLower();
     static const QRegularExpression suffixRegex(kSupportFiles);
     return suffixRegex.match(suffix).hasMatch();
 }
 
-void processFile(const QString &path, const IndexWriterPtr &writer, ProgressReporter *reporter)
+bool extractFile(IndexJob *job)
 {
     try {
-        if (!isSupportedFile(path))
-            return;
 #ifdef QT_DEBUG
-        fmDebug() << "Adding [" << path << "]";
+        fmDebug() << (job->isUpdate ? "Updating [" : "Adding [") << job->path << "]";
 #endif
-        writer->addDocument(createFileDocument(path));
-        if (reporter) {
-            reporter->increment();
-        }
+        job->doc = createFileDocument(job->path);
+        return true;
     } catch (const std::exception &e) {
-        fmWarning() << "Process file failed:" << path << e.what();
+        fmWarning() << "Process file failed:" << job->path << e.what();
     }
+
+    return false;
 }
 
-void updateFile(const QString &path, const IndexReaderPtr &reader,
-                const IndexWriterPtr &writer, ProgressReporter *reporter)
+/*!
+ * \brief loadIndexedFiles 一次性读取索引中所有文档的路径和修改时间
+ * 只遍历 path 和 modified 两个字段的词典，不加载存储的文档内容。
+ * \return 路径到修改时间（秒）的映射
+ */
+QHash<QString, qint64> loadIndexedFiles(const IndexReaderPtr &reader)
 {
-    try {
-        if (!isSupportedFile(path))
-            return;
+    QHash<int32_t, qint64> modifiedOfDoc;
+    QHash<QString, qint64> files;
+    TermDocsPtr termDocs = reader->termDocs();
+    ScopeGuard termDocsCloser([&termDocs]() { termDocs->close(); });
+
+    TermEnumPtr terms = reader->terms(newLucene<Term>(L"modified", L""));
+    for (TermPtr term = terms->term(); term && term->field() == L"modified"; term = terms->next() ? terms->term() : TermPtr()) {
+        const qint64 modified = QString::fromStdWString(term->text()).toLongLong();
+        termDocs->seek(term);
+        while (termDocs->next())
+            modifiedOfDoc.insert(termDocs->doc(), modified);
+    }
+    terms->close();
+
+    files.reserve(modifiedOfDoc.size());
+    terms = reader->terms(newLucene<Term>(L"path", L""));
+    for (TermPtr term = terms->term(); term && term->field() == L"path"; term = terms->next() ? terms->term() : TermPtr()) {
+        const QString &path = QString::fromStdWString(term->text());
+        termDocs->seek(term);
+        while (termDocs->next())
+            files.insert(path, modifiedOfDoc.value(termDocs->doc(), -1));
+    }
+    terms->close();
 
-        bool needAdd = false;
-        if (checkNeedUpdate(path, reader, &needAdd)) {
-            if (needAdd) {
-#ifdef QT_DEBUG
-                fmDebug() << "Adding [" << path << "]";
-#endif
-                writer->addDocument(createFileDocument(path));
-            } else {
-                fmDebug() << "Updating file [" << path << "]";
-                TermPtr term = newLucene<Term>(L"path", path.toStdWString());
-                writer->updateDocument(term, createFileDocument(path));
-            }
-        }
+    return files;
+}
 
-        if (reporter) {
-            reporter->increment();
-        }
-    } catch (const std::exception &e) {
-        fmWarning() << "Update file failed:" << path << e.what();
-    }
+void configureWriter(const IndexWriterPtr &writer, int mergeFactor)
+{
+    writer->setRAMBufferSizeMB(kRamBufferSizeMB);
+    writer->setMergeFactor(mergeFactor);
+}
+
+void lowerThreadPriority()
+{
+    // 索引在后台进行，不与前台应用争抢 CPU 和磁盘
+    const auto tid = static_cast<id_t>(syscall(SYS_gettid));
+    if (setpriority(PRIO_PROCESS, tid, kWorkerNice) != 0)
+        fmDebug() << "Cannot lower the cpu priority of the index thread";
+    if (syscall(SYS_ioprio_set, kIoprioWhoProcess, tid, kIoprioClassIdle << kIoprioClassShift) != 0)
+        fmDebug() << "Cannot lower the io priority of the index thread";
 }
 
 void traverseDirectoryCommon(const QString &rootPath, TaskState &state,
@@ -237,7 +258,7 @@ void traverseDirectoryCommon(const QString &rootPath, TaskState &state,
             // 对于普通文件，只检查路径有效性
             if (S_ISREG(st.st_mode)) {
                 if (IndexTraverseUtils::isValidFile(fullPath)) {
-                    fileHandler(fullPath);
+                    fileHandler(fullPath, st);
                 }
             }
             // 对于目录，加入队列（后续会检查是否访问过）
@@ -248,22 +269,92 @@ void traverseDirectoryCommon(const QString &rootPath, TaskState &state,
     }
 }
 
-void traverseDirectory(const QString &rootPath, const IndexWriterPtr &writer,
-                       TaskState &running)
+/*!
+ * \brief runIndexPipeline 遍历目录并写入索引
+ * 当前线程遍历目录，多个线程并行提取文档内容，单个线程写入 IndexWriter，
+ * 队列容量有限，提取过慢时遍历阻塞，写入过慢时提取阻塞。
+ */
+void runIndexPipeline(const QString &rootPath, const IndexWriterPtr &writer,
+                      TaskState &state, const FileFilter &filter)
 {
-    ProgressReporter reporter;
-    traverseDirectoryCommon(rootPath, running, [&](const QString &path) {
-        processFile(path, writer, &reporter);
+    BoundedQueue<IndexJob> pathQueue(kPathQueueCapacity);
+    BoundedQueue<IndexJob> jobQueue(kDocumentQueueCapacity);
+    const int extractorCount = qMax(1, QThread::idealThreadCount() - 1);
+    QAtomicInt runningExtractors(extractorCount);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(extractorCount + 1);
+    for (int i = 0; i < extractorCount; ++i) {
+        pool.start(QRunnable::create([&] {
+            lowerThreadPriority();
+            IndexJob job;
+            while (pathQueue.pop(&job)) {
+                // 任务停止后只清空队列
+                if (!state.isRunning())
+                    continue;
+
+                if (extractFile(&job))
+                    jobQueue.push(std::move(job));
+            }
+
+            // 最后一个提取线程结束时，写入线程取完剩余文档后退出
+            if (!runningExtractors.deref())
+                jobQueue.close();
+        }));
+    }
+
+    pool.start(QRunnable::create([&] {
+        lowerThreadPriority();
+        ProgressReporter reporter;
+        IndexJob job;
+        while (jobQueue.pop(&job)) {
+            if (!state.isRunning())
+                continue;
+
+            try {
+                if (job.isUpdate) {
+                    writer->updateDocument(newLucene<Term>(L"path", job.path.toStdWString()), job.doc);
+                } else {
+                    writer->addDocument(job.doc);
+                }
+                reporter.increment();
+            } catch (const std::exception &e) {
+                fmWarning() << "Write index failed:" << job.path << e.what();
+            }
+        }
+    }));
+
+    traverseDirectoryCommon(rootPath, state, [&](const QString &path, const struct stat &st) {
+        if (!isSupportedFile(path))
+            return;
+
+        IndexJob job;
+        job.path = path;
+        if (!filter || filter(path, st, &job.isUpdate))
+            pathQueue.push(std::move(job));
     });
+
+    pathQueue.close();
+    pool.waitForDone();
 }
 
-void traverseForUpdate(const QString &rootPath, const IndexReaderPtr &reader,
-                       const IndexWriterPtr &writer, TaskState &running)
+// 遍历中没有出现、且确实已不存在的文件，从索引中删除
+void removeDeletedFiles(const QString &rootPath, const QHash<QString, qint64> &unvisitedFiles,
+                        const IndexWriterPtr &writer)
 {
-    ProgressReporter reporter;
-    traverseDirectoryCommon(rootPath, running, [&](const QString &path) {
-        updateFile(path, reader, writer, &reporter);
-    });
+    const QString &root = QDir::cleanPath(rootPath);
+    const QString &prefix = root.endsWith('/') ? root : root + '/';
+    int removed = 0;
+    for (auto it = unvisitedFiles.cbegin(); it != unvisitedFiles.cend(); ++it) {
+        if (!it.key().startsWith(prefix) || QFileInfo::exists(it.key()))
+            continue;
+
+        writer->deleteDocuments(newLucene<Term>(L"path", it.key().toStdWString()));
+        ++removed;
+    }
+
+    if (removed > 0)
+        fmInfo() << "Removed" << removed << "deleted files from index";
 }
 
 }   // namespace
@@ -305,15 +396,17 @@ TaskHandler TaskHandlers::CreateIndexHandler()
 
             fmInfo() << "Indexing to directory:" << indexStorePath();
 
+            configureWriter(writer, kBulkMergeFactor);
             writer->deleteAll();
-            traverseDirectory(path, writer, running);
+            runIndexPipeline(path, writer, running, nullptr);
 
             if (!running.isRunning()) {
                 fmInfo() << "Create index task was interrupted";
                 return false;
             }
 
-            writer->optimize();
+            // 只提交，不做全量合并
+            writer->commit();
             return true;
         } catch (const LuceneException &e) {
             fmWarning() << "Create index failed with Lucene exception:"
@@ -359,14 +452,30 @@ TaskHandler TaskHandlers::UpdateIndexHandler()
                 }
             });
 
-            traverseForUpdate(path, reader, writer, running);
+            // 与索引中记录的修改时间比较，只提取新增和修改过的文件
+            QHash<QString, qint64> indexedFiles = loadIndexedFiles(reader);
+            fmInfo() << "Loaded" << indexedFiles.size() << "indexed files";
+
+            configureWriter(writer, kMergeFactor);
+            runIndexPipeline(path, writer, running, [&indexedFiles](const QString &file, const struct stat &st, bool *isUpdate) {
+                auto it = indexedFiles.find(file);
+                if (it == indexedFiles.end())
+                    return true;
+
+                const bool changed = it.value() != static_cast<qint64>(st.st_mtime);
+                *isUpdate = true;
+                indexedFiles.erase(it);
+                return changed;
+            });
 
             if (!running.isRunning()) {
                 fmInfo() << "Update index task was interrupted";
                 return false;
             }
 
-            writer->optimize();
+            removeDeletedFiles(path, indexedFiles, writer);
+
+            writer->commit();
             return true;
         } catch (const LuceneException &e) {
             // Lucene异常表示索引损坏
@@ -427,7 +536,7 @@ TaskHandler TaskHandlers::RemoveIndexHandler()
                 return false;
             }
 
-            writer->optimize();
+            writer->commit();
             return true;
         } catch (const LuceneException &e) {
             fmWarning() << "Remove index failed with Lucene exception:"
@@ -0,0 +1,74 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef BOUNDEDQUEUE_H
+#define BOUNDEDQUEUE_H
+
+#include "service_textindex_global.h"
+
+#include <QMutex>
+#include <QQueue>
+#include <QWaitCondition>
+
+SERVICETEXTINDEX_BEGIN_NAMESPACE
+
+// 容量有限的阻塞队列，生产者过快时阻塞，避免待处理的文档占满内存
+template<typename T>
+class BoundedQueue
+{
+public:
+    explicit BoundedQueue(int capacity)
+        : m_capacity(qMax(1, capacity)) { }
+
+    // 队列满时阻塞，队列关闭后返回 false
+    bool push(T item)
+    {
+        QMutexLocker lk(&m_mutex);
+        while (m_items.size() >= m_capacity && !m_closed)
+            m_notFull.wait(&m_mutex);
+
+        if (m_closed)
+            return false;
+
+        m_items.enqueue(std::move(item));
+        m_notEmpty.wakeOne();
+        return true;
+    }
+
+    // 队列为空时阻塞，队列关闭且已取完时返回 false
+    bool pop(T *item)
+    {
+        QMutexLocker lk(&m_mutex);
+        while (m_items.isEmpty() && !m_closed)
+            m_notEmpty.wait(&m_mutex);
+
+        if (m_items.isEmpty())
+            return false;
+
+        *item = m_items.dequeue();
+        m_notFull.wakeOne();
+        return true;
+    }
+
+    // 不再接收新的数据，已有的数据仍可取出
+    void close()
+    {
+        QMutexLocker lk(&m_mutex);
+        m_closed = true;
+        m_notEmpty.wakeAll();
+        m_notFull.wakeAll();
+    }
+
+private:
+    const int m_capacity;
+    bool m_closed { false };
+    QQueue<T> m_items;
+    QMutex m_mutex;
+    QWaitCondition m_notEmpty;
+    QWaitCondition m_notFull;
+};
+
+SERVICETEXTINDEX_END_NAMESPACE
+
+#endif   // BOUNDEDQUEUE_H
@@ -3,10 +3,16 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "stubext.h"
+#include "ut_testobj_user.h"
 #include <dfm-base/base/db/sqlitehandle.h>
 
+#include <QTemporaryDir>
+
 #include <gtest/gtest.h>
 
+DFMBASE_USE_NAMESPACE
+using namespace TestObj;
+
 class UT_SqliteHelper : public testing::Test
 {
 protected:
@@ -16,3 +22,44 @@ protected:
 public:
     stub_ext::StubExt stub;
 };
+
+TEST_F(UT_SqliteHelper, insertBatch)
+{
+    QTemporaryDir dir;
+    SqliteHandle handle(dir.filePath("user.db"));
+    ASSERT_TRUE(handle.createTable<User>(SqliteConstraint::primary("id"), SqliteConstraint::autoIncreament("id")));
+
+    QList<QSharedPointer<User>> users;
+    for (int i = 0; i != 100; ++i) {
+        QSharedPointer<User> user(new User);
+        // quotes are bound, not concatenated into the sql
+        user->setName(QString("o'user%1").arg(i));
+        user->setPassword("pwd");
+        user->setEmail("mail");
+        users.append(user);
+    }
+
+    EXPECT_TRUE(handle.transaction([&handle, &users] { return handle.insertBatch<User>(users); }));
+    EXPECT_EQ(100, handle.query<User>().toBeans().size());
+
+    EXPECT_TRUE(handle.updateBatch<User>({ "email" }, { "name" }, { { "new", "o'user1" } }));
+    auto field = Expression::Field<User>;
+    EXPECT_EQ(1, handle.query<User>().where(field("email") == "new").toBeans().size());
+
+    EXPECT_TRUE(handle.removeBatch<User>({ "name" }, { { "o'user1" }, { "o'user2" } }));
+    EXPECT_EQ(98, handle.query<User>().toBeans().size());
+}
+
+TEST_F(UT_SqliteHelper, insert)
+{
+    QTemporaryDir dir;
+    SqliteHandle handle(dir.filePath("user.db"));
+    ASSERT_TRUE(handle.createTable<User>(SqliteConstraint::primary("id"), SqliteConstraint::autoIncreament("id")));
+
+    User user;
+    user.setName("name");
+    user.setPassword("pwd");
+    user.setEmail("mail");
+    EXPECT_EQ(1, handle.insert<User>(user));
+    EXPECT_EQ(2, handle.insert<User>(user));
+}
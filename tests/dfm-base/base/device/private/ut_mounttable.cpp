@@ -0,0 +1,62 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "stubext.h"
+
+#include <dfm-base/base/device/private/mounttable.h>
+
+#include <gtest/gtest.h>
+
+#include <libmount.h>
+
+DFMBASE_USE_NAMESPACE
+class UT_MountTable : public testing::Test
+{
+protected:
+    virtual void SetUp() override
+    {
+        MountTable::instance().invalidate();
+    }
+    virtual void TearDown() override
+    {
+        stub.clear();
+        MountTable::instance().invalidate();
+    }
+
+protected:
+    stub_ext::StubExt stub;
+};
+
+TEST_F(UT_MountTable, MountOf)
+{
+    EXPECT_EQ(MountTable::instance().mountOf("/").target, "/");
+    EXPECT_EQ(MountTable::instance().mountOf("/proc/self/mountinfo").target, "/proc");
+    EXPECT_EQ(MountTable::instance().mountOf("/proc/").target, "/proc");
+}
+
+TEST_F(UT_MountTable, FindByTarget)
+{
+    const MountEntry &entry = MountTable::instance().findByTarget("/proc/");
+    EXPECT_TRUE(entry.isValid());
+    EXPECT_EQ(entry.fsType, "proc");
+    EXPECT_FALSE(MountTable::instance().findByTarget("/proc/self").isValid());
+}
+
+TEST_F(UT_MountTable, ParseOnlyWhenChanged)
+{
+    int parsed = 0;
+    stub.set_lamda(&mnt_table_parse_mtab, [&parsed](libmnt_table *, const char *) {
+        __DBG_STUB_INVOKE__
+        ++parsed;
+        return -1;
+    });
+
+    MountTable::instance().mountOf("/");
+    MountTable::instance().mountOf("/home");
+    EXPECT_EQ(parsed, 1);
+
+    MountTable::instance().invalidate();
+    MountTable::instance().mountOf("/");
+    EXPECT_EQ(parsed, 2);
+}
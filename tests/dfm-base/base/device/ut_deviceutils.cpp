@@ -8,6 +8,7 @@
 #include <dfm-base/base/application/settings.h>
 #include <dfm-base/base/device/deviceutils.h>
 #include <dfm-base/base/device/deviceproxymanager.h>
+#include <dfm-base/base/device/private/mounttable.h>
 #include <dfm-base/base/schemefactory.h>
 #include <dfm-base/file/local/localfilewatcher.h>
 #include <dfm-base/file/local/localdiriterator.h>
@@ -50,6 +51,8 @@ TEST_F(UT_DeviceUtils, bug_139803_UseLibmount)
         libmnt_table *table { NULL };
         return table;
     });
+    // mtab is parsed again once the cached table is out of date
+    MountTable::instance().invalidate();
     DeviceUtils::getMountInfo("/dev/sr0");
     EXPECT_TRUE(useLibMountInterfaces);
 }
@@ -0,0 +1,124 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#include "stubext.h"
+
+#include <dfm-base/interfaces/sortfileinfo.h>
+#include <dfm-base/interfaces/private/sortfileinfo_p.h>
+
+#include <QTemporaryDir>
+#include <QFile>
+#include <QSet>
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+DFMBASE_USE_NAMESPACE
+
+class UT_SortFileInfo : public testing::Test
+{
+public:
+    virtual void SetUp() override
+    {
+    }
+
+    virtual void TearDown() override
+    {
+        stub.clear();
+    }
+
+public:
+    stub_ext::StubExt stub;
+};
+
+TEST_F(UT_SortFileInfo, flagWord)
+{
+    SortFileInfo info;
+    info.setFile(true);
+    info.setHide(true);
+    info.setWriteable(true);
+    EXPECT_TRUE(info.isFile());
+    EXPECT_FALSE(info.isDir());
+    EXPECT_FALSE(info.isSymLink());
+    EXPECT_TRUE(info.isHide());
+    EXPECT_FALSE(info.isReadable());
+    EXPECT_TRUE(info.isWriteable());
+    EXPECT_FALSE(info.isExecutable());
+
+    // clearing one flag leaves its neighbours alone
+    info.setHide(false);
+    info.setDir(true);
+    EXPECT_TRUE(info.isFile());
+    EXPECT_TRUE(info.isDir());
+    EXPECT_FALSE(info.isHide());
+    EXPECT_TRUE(info.isWriteable());
+    EXPECT_FALSE(info.isStatLater());
+}
+
+TEST_F(UT_SortFileInfo, statLater)
+{
+    QTemporaryDir dir;
+    QFile file(dir.filePath("file"));
+    file.open(QIODevice::WriteOnly);
+    file.write(QByteArray(123, 'a'));
+    file.close();
+
+    SortFileInfo info;
+    info.setUrl(QUrl::fromLocalFile(file.fileName()));
+    info.setStatLater(true);
+    EXPECT_TRUE(info.isStatLater());
+    EXPECT_EQ(123, info.fileSize());
+    EXPECT_FALSE(info.isStatLater());
+    EXPECT_TRUE(info.isReadable());
+    EXPECT_TRUE(info.isWriteable());
+    EXPECT_FALSE(info.isExecutable());
+}
+
+TEST_F(UT_SortFileInfo, statWithoutStripeLock)
+{
+    QTemporaryDir dir;
+    QFile file(dir.filePath("file"));
+    file.open(QIODevice::WriteOnly);
+    file.close();
+
+    SortFileInfo info;
+    info.setUrl(QUrl::fromLocalFile(file.fileName()));
+    info.setStatLater(true);
+
+    // the stripe is shared with other infos, it must be free while the file is read
+    QMutex *stripe = info.d->lock();
+    bool lockedDuringIO = false;
+    stub.set_lamda(&::access, [stripe, &lockedDuringIO](const char *, int) {
+        __DBG_STUB_INVOKE__
+        if (stripe->tryLock())
+            stripe->unlock();
+        else
+            lockedDuringIO = true;
+        return 0;
+    });
+    EXPECT_TRUE(info.isExecutable());
+    EXPECT_FALSE(lockedDuringIO);
+}
+
+TEST_F(UT_SortFileInfo, stripedLocks)
+{
+    QList<SortInfoPointer> infos;
+    for (int i = 0; i < 256; ++i)
+        infos.append(SortInfoPointer::create());
+
+    QSet<QMutex *> stripes;
+    for (const auto &info : infos) {
+        EXPECT_EQ(info->d->lock(), info->d->lock());
+        stripes.insert(info->d->lock());
+    }
+    // many infos share a few locks instead of owning one each
+    EXPECT_GT(stripes.count(), 1);
+    EXPECT_LE(stripes.count(), 64);
+}
+
+TEST_F(UT_SortFileInfo, compactLayout)
+{
+    // the url, the size and the flag word, names and sort keys are not kept per entry
+    EXPECT_LE(sizeof(SortFileInfoPrivate), sizeof(QUrl) + 2 * sizeof(qint64));
+}
@@ -109,4 +109,36 @@ TEST_F(UT_FileUtils, bug_186753_notdlnfsDeviceIsNotLocalDevice)
    EXPECT_FALSE(FileUtils::isLocalDevice(url));
 }
 
+TEST_F(UT_FileUtils, testCollationKeyMatchesCompareByStringEx)
+{
+    const QStringList names { "a", "A.txt", "b", "file2", "file10", "file010", "File3.txt",
+                              "Test", "test.doc", "test.docx", "_hidden", "9", "1a", "a1" };
+    for (const QString &left : names) {
+        for (const QString &right : names) {
+            if (left == right || FileUtils::compareByStringEx(left, right) == FileUtils::compareByStringEx(right, left))
+                continue;
+            EXPECT_EQ(FileUtils::compareByStringEx(left, right),
+                      FileUtils::collationKey(left) < FileUtils::collationKey(right))
+                    << left.toStdString() << " " << right.toStdString();
+        }
+    }
+}
+
+TEST_F(UT_FileUtils, testCollationKeyNumbersByValue)
+{
+    EXPECT_TRUE(FileUtils::collationKey("file2") < FileUtils::collationKey("file10"));
+    EXPECT_TRUE(FileUtils::collationKey("9") < FileUtils::collationKey("10"));
+    EXPECT_TRUE(FileUtils::collationKey("abc") < FileUtils::collationKey("_abc"));
+    EXPECT_TRUE(FileUtils::collationKey("abc") < FileUtils::collationKey("abc.txt"));
+    EXPECT_FALSE(FileUtils::collationKey("a") == FileUtils::collationKey("A"));
+}
+
+TEST_F(UT_FileUtils, testCollationKeySize)
+{
+    // the key does not carry the name, equal keys are told apart by the caller
+    EXPECT_EQ(FileUtils::collationKey("Report.txt"), FileUtils::collationKey("report.txt"));
+    const QString &name("a_rather_long_file_name_2024.tar");
+    EXPECT_LE(FileUtils::collationKey(name).size(), name.size() * 3);
+}
+
 #endif
@@ -0,0 +1,152 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "utils/thumbnail/thumbnailcreators.h"
+
+#include <QTemporaryDir>
+#include <QImageReader>
+#include <QBuffer>
+#include <QImage>
+#include <QFile>
+
+#include <gtest/gtest.h>
+#include "stubext.h"
+
+DFMBASE_USE_NAMESPACE
+DFMGLOBAL_USE_NAMESPACE
+
+namespace {
+void appendLE(QByteArray &data, quint32 value, int bytes)
+{
+    for (int i = 0; i < bytes; ++i)
+        data.append(static_cast<char>((value >> (8 * i)) & 0xFF));
+}
+
+void appendEntry(QByteArray &data, quint16 tag, quint16 type, quint32 value)
+{
+    appendLE(data, tag, 2);
+    appendLE(data, type, 2);
+    appendLE(data, 1, 4);
+    appendLE(data, value, 4);
+}
+}   // namespace
+
+class UT_ThumbnailCreators : public testing::Test
+{
+public:
+    virtual void SetUp() override
+    {
+        // the main image is never readable, a result can only come from the exif preview
+        stub.set_lamda(&QImageReader::canRead, [] {
+            __DBG_STUB_INVOKE__
+            return false;
+        });
+
+        QImage image(320, 240, QImage::Format_RGB32);
+        image.fill(Qt::red);
+        QBuffer buffer(&preview);
+        buffer.open(QIODevice::WriteOnly);
+        image.save(&buffer, "JPEG");
+    }
+
+    virtual void TearDown() override
+    {
+        stub.clear();
+    }
+
+    // a little endian tiff block: IFD0 with the orientation, IFD1 with the preview
+    QByteArray tiff(quint32 ifd0Offset = 8, quint16 ifd1Count = 2) const
+    {
+        QByteArray data("II\x2A\x00", 4);
+        appendLE(data, ifd0Offset, 4);
+        appendLE(data, 1, 2);
+        appendEntry(data, 0x0112, 3, 1);
+        const quint32 ifd1Offset = static_cast<quint32>(data.size()) + 4;
+        appendLE(data, ifd1Offset, 4);
+        appendLE(data, ifd1Count, 2);
+        const quint32 previewOffset = ifd1Offset + 2 + 2 * 12 + 4;
+        appendEntry(data, 0x0201, 4, previewOffset);
+        appendEntry(data, 0x0202, 4, static_cast<quint32>(preview.size()));
+        appendLE(data, 0, 4);
+        return data + preview;
+    }
+
+    QString writeJpeg(const QByteArray &tiffBlock, int declaredLength = -1)
+    {
+        QByteArray data("\xFF\xD8\xFF\xE1", 4);
+        const int segmentLength = declaredLength < 0 ? tiffBlock.size() + 8 : declaredLength;
+        data.append(static_cast<char>((segmentLength >> 8) & 0xFF));
+        data.append(static_cast<char>(segmentLength & 0xFF));
+        data.append("Exif\0\0", 6);
+        data.append(tiffBlock);
+        data.append("\xFF\xDA\x00\x02", 4);
+
+        const QString &path = dir.filePath(QString("image%1.jpg").arg(++fileIndex));
+        QFile file(path);
+        file.open(QIODevice::WriteOnly);
+        file.write(data);
+        file.close();
+        return path;
+    }
+
+    QString writeRaw(const QByteArray &data)
+    {
+        const QString &path = dir.filePath(QString("image%1.jpg").arg(++fileIndex));
+        QFile file(path);
+        file.open(QIODevice::WriteOnly);
+        file.write(data);
+        file.close();
+        return path;
+    }
+
+    stub_ext::StubExt stub;
+    QTemporaryDir dir;
+    QByteArray preview;
+    int fileIndex { 0 };
+};
+
+TEST_F(UT_ThumbnailCreators, exifPreviewCoversSize)
+{
+    const QString &path = writeJpeg(tiff());
+    const QImage &large = ThumbnailCreators::imageThumbnailCreator(path, kLarge);
+    EXPECT_EQ(256, qMax(large.width(), large.height()));
+    const QImage &small = ThumbnailCreators::imageThumbnailCreator(path, kSmall);
+    EXPECT_EQ(64, qMax(small.width(), small.height()));
+}
+
+TEST_F(UT_ThumbnailCreators, exifPreviewTooSmall)
+{
+    QImage image(160, 120, QImage::Format_RGB32);
+    image.fill(Qt::blue);
+    preview.clear();
+    QBuffer buffer(&preview);
+    buffer.open(QIODevice::WriteOnly);
+    image.save(&buffer, "JPEG");
+
+    const QString &path = writeJpeg(tiff());
+    EXPECT_TRUE(ThumbnailCreators::imageThumbnailCreator(path, kLarge).isNull());
+    EXPECT_FALSE(ThumbnailCreators::imageThumbnailCreator(path, kNormal).isNull());
+}
+
+TEST_F(UT_ThumbnailCreators, exifTruncatedSegment)
+{
+    // the APP1 header ends before the exif identifier
+    EXPECT_TRUE(ThumbnailCreators::imageThumbnailCreator(writeRaw(QByteArray("\xFF\xD8\xFF\xE1\x40\x00Ex", 8)), kLarge).isNull());
+    // the segment claims more bytes than the file holds
+    const QByteArray &block = tiff();
+    EXPECT_TRUE(ThumbnailCreators::imageThumbnailCreator(writeRaw(QByteArray("\xFF\xD8\xFF\xE1\xFF\xF0Exif\0\0", 12) + block.left(20)), kLarge).isNull());
+    // the declared length cuts the preview
+    EXPECT_TRUE(ThumbnailCreators::imageThumbnailCreator(writeJpeg(block, block.size() / 2), kLarge).isNull());
+}
+
+TEST_F(UT_ThumbnailCreators, exifMalformedOffsets)
+{
+    // offsets that wrap around in 32 bits
+    EXPECT_TRUE(ThumbnailCreators::imageThumbnailCreator(writeJpeg(tiff(0xFFFFFFFF)), kLarge).isNull());
+    EXPECT_TRUE(ThumbnailCreators::imageThumbnailCreator(writeJpeg(tiff(0xFFFFFFFE)), kLarge).isNull());
+    // an entry count running past the block
+    EXPECT_TRUE(ThumbnailCreators::imageThumbnailCreator(writeJpeg(tiff(8, 0xFFFF)), kLarge).isNull());
+    // a segment length below the minimum
+    EXPECT_TRUE(ThumbnailCreators::imageThumbnailCreator(writeJpeg(tiff(), 1), kLarge).isNull());
+}
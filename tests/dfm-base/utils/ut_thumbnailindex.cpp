@@ -0,0 +1,99 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "utils/thumbnail/thumbnailindex.h"
+#include "utils/thumbnail/thumbnailhelper.h"
+
+#include <dfm-base/base/standardpaths.h>
+
+#include <QTemporaryDir>
+#include <QFile>
+
+#include <gtest/gtest.h>
+#include "stubext.h"
+
+#include <sys/stat.h>
+
+#include <cstring>
+
+DFMBASE_USE_NAMESPACE
+
+class UT_ThumbnailIndex : public testing::Test
+{
+public:
+    virtual void SetUp() override
+    {
+        QString (*location)(StandardPaths::StandardLocation) = &StandardPaths::location;
+        stub.set_lamda(location, [this](StandardPaths::StandardLocation) {
+            __DBG_STUB_INVOKE__
+            return cacheDir.path();
+        });
+
+        thumbnail = cacheDir.filePath("thumb.png");
+        writeThumbnail("png");
+    }
+
+    virtual void TearDown() override
+    {
+        stub.clear();
+    }
+
+    void writeThumbnail(const QByteArray &content)
+    {
+        QFile file(thumbnail);
+        file.open(QIODevice::WriteOnly | QIODevice::Truncate);
+        file.write(content);
+    }
+
+    stub_ext::StubExt stub;
+    QTemporaryDir cacheDir;
+    QString thumbnail;
+};
+
+TEST_F(UT_ThumbnailIndex, InsertAndContains)
+{
+    const QByteArray &urlMd5 = ThumbnailHelper::dataToMd5Hex("file:///home/test/a.jpg");
+    EXPECT_FALSE(ThumbnailIndex::instance()->contains(urlMd5, Global::kLarge, 100, thumbnail));
+
+    ThumbnailIndex::instance()->insert(urlMd5, Global::kLarge, 100, thumbnail);
+    EXPECT_TRUE(ThumbnailIndex::instance()->contains(urlMd5, Global::kLarge, 100, thumbnail));
+    // another size or a modified source file is a miss
+    EXPECT_FALSE(ThumbnailIndex::instance()->contains(urlMd5, Global::kNormal, 100, thumbnail));
+    EXPECT_FALSE(ThumbnailIndex::instance()->contains(urlMd5, Global::kLarge, 101, thumbnail));
+
+    // the thumbnail was replaced by another application
+    writeThumbnail("another png");
+    EXPECT_FALSE(ThumbnailIndex::instance()->contains(urlMd5, Global::kLarge, 100, thumbnail));
+
+    ThumbnailIndex::instance()->insert(urlMd5, Global::kLarge, 100, thumbnail);
+    ThumbnailIndex::instance()->remove(urlMd5, Global::kLarge);
+    EXPECT_FALSE(ThumbnailIndex::instance()->contains(urlMd5, Global::kLarge, 100, thumbnail));
+}
+
+TEST_F(UT_ThumbnailIndex, OutdatedIndexReplaced)
+{
+    // an outdated index of the full size, still mapped by another process
+    const QString &indexPath = cacheDir.filePath("thumbnail.index");
+    QFile old(indexPath);
+    ASSERT_TRUE(old.open(QIODevice::ReadWrite));
+    ASSERT_TRUE(old.resize(64));
+    old.write("outdated");
+    uchar *mapped = old.map(0, 64);
+    ASSERT_TRUE(mapped);
+    struct stat before;
+    ASSERT_EQ(0, ::stat(QFile::encodeName(indexPath).constData(), &before));
+
+    ThumbnailIndex index;
+    const QByteArray &urlMd5 = ThumbnailHelper::dataToMd5Hex("file:///home/test/b.jpg");
+    index.insert(urlMd5, Global::kLarge, 100, thumbnail);
+    EXPECT_TRUE(index.contains(urlMd5, Global::kLarge, 100, thumbnail));
+
+    // the old file was neither truncated nor rewritten, the new index is another file
+    struct stat after;
+    ASSERT_EQ(0, ::stat(QFile::encodeName(indexPath).constData(), &after));
+    EXPECT_NE(before.st_ino, after.st_ino);
+    EXPECT_EQ(64, old.size());
+    EXPECT_EQ(0, memcmp(mapped, "outdated", 8));
+    old.unmap(mapped);
+}
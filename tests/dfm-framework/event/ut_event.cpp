@@ -0,0 +1,56 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <dfm-framework/dpf.h>
+#include <dfm-framework/event/event.h>
+
+#include <gtest/gtest.h>
+
+DPF_USE_NAMESPACE
+
+TEST(UT_Event, test_event_type)
+{
+    dpfEvent->registerEventType(EventStratege::kSlot, "ut_event", "slot_Test_Type");
+    dpfEvent->registerEventType(EventStratege::kHook, "ut_event", "hook_Test_Type");
+
+    EventType slotType { DPF_EVENT_TYPE("ut_event", "slot_Test_Type") };
+    EventType hookType { DPF_EVENT_TYPE("ut_event", "hook_Test_Type") };
+    EXPECT_TRUE(isValidEventType(slotType));
+    EXPECT_TRUE(isValidEventType(hookType));
+    EXPECT_NE(slotType, hookType);
+
+    // registering again keeps the first id
+    dpfEvent->registerEventType(EventStratege::kSlot, "ut_event", "slot_Test_Type");
+    EXPECT_EQ(DPF_EVENT_TYPE("ut_event", "slot_Test_Type"), slotType);
+
+    EXPECT_EQ(DPF_EVENT_TYPE("ut_event", "slot_Test_Unknown"), EventTypeScope::kInValid);
+    EXPECT_EQ(DPF_EVENT_TYPE("ut_event_other", "slot_Test_Type"), EventTypeScope::kInValid);
+}
+
+TEST(UT_Event, test_event_type_stratege_mismatch)
+{
+    // the prefix of the topic does not match the stratege it is registered with
+    dpfEvent->registerEventType(EventStratege::kSignal, "ut_event", "slot_Test_Mismatch");
+    EXPECT_EQ(DPF_EVENT_TYPE("ut_event", "slot_Test_Mismatch"), EventTypeScope::kInValid);
+}
+
+TEST(UT_Event, test_plugin_topics)
+{
+    dpfEvent->registerEventType(EventStratege::kSignal, "ut_event_topics", "signal_Test_Topic");
+    dpfEvent->registerEventType(EventStratege::kSlot, "ut_event_topics", "slot_Test_Topic");
+
+    EXPECT_EQ(dpfEvent->pluginTopics("ut_event_topics", EventStratege::kSignal), QStringList { "signal_Test_Topic" });
+    EXPECT_EQ(dpfEvent->pluginTopics("ut_event_topics").size(), 2);
+}
+
+TEST(UT_Event, test_plugin_topics_prefix)
+{
+    dpfEvent->registerEventType(EventStratege::kSlot, "ut_prefix", "slot_Test_Own");
+    dpfEvent->registerEventType(EventStratege::kSlot, "ut_prefix_sub", "slot_Test_Sub");
+
+    // the space is matched as a prefix, topics of the longer space keep their space name
+    EXPECT_EQ(dpfEvent->pluginTopics("ut_prefix", EventStratege::kSlot),
+              (QStringList { "slot_Test_Own", "ut_prefix_sub:slot_Test_Sub" }));
+    EXPECT_EQ(dpfEvent->pluginTopics("ut_prefix_sub", EventStratege::kSlot), QStringList { "slot_Test_Sub" });
+}
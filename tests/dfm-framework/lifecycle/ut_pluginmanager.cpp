@@ -12,6 +12,8 @@
 
 #include <gtest/gtest.h>
 
+#include <QTemporaryFile>
+
 DPF_USE_NAMESPACE
 
 class UT_PluginManager : public testing::Test
@@ -336,3 +338,30 @@ TEST_F(UT_PluginManager, startPlugins)
     EXPECT_TRUE(started);
     EXPECT_TRUE(manager.d->allPluginsStarted);
 }
+
+TEST_F(UT_PluginManager, test_libraryMetaData_manifest)
+{
+    QTemporaryFile library;
+    ASSERT_TRUE(library.open());
+    library.write("library");
+    library.flush();
+
+    int parsed { 0 };
+    stub.set_lamda(&QPluginLoader::metaData, [&parsed]() {
+        __DBG_STUB_INVOKE__
+        ++parsed;
+        return QJsonObject { { "IID", "test.iid" } };
+    });
+
+    PluginManager manager;
+    EXPECT_EQ(manager.d->libraryMetaData(library.fileName()).value("IID").toString(), "test.iid");
+    EXPECT_EQ(manager.d->libraryMetaData(library.fileName()).value("IID").toString(), "test.iid");
+    EXPECT_EQ(parsed, 1);
+    EXPECT_TRUE(manager.d->manifestChanged);
+
+    // the library is replaced
+    library.write("changed");
+    library.flush();
+    manager.d->libraryMetaData(library.fileName());
+    EXPECT_EQ(parsed, 2);
+}
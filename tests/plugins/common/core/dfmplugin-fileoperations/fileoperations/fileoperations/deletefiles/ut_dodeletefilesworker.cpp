@@ -5,6 +5,7 @@
 #include "stubext.h"
 #include "plugins/common/core/dfmplugin-fileoperations/fileoperations/deletefiles/deletefiles.h"
 #include "plugins/common/core/dfmplugin-fileoperations/fileoperations/deletefiles/dodeletefilesworker.h"
+#include "plugins/common/core/dfmplugin-fileoperations/fileoperations/deletefiles/localdeleteengine.h"
 
 #include <dfm-base/base/urlroute.h>
 #include <dfm-base/base/schemefactory.h>
@@ -20,6 +21,10 @@
 
 #include <dfm-io/denumerator.h>
 
+#include <QTemporaryDir>
+#include <QDir>
+#include <QFile>
+
 typedef QMap<QString,QVariant> * mapValue;
 Q_DECLARE_METATYPE(mapValue);
 
@@ -74,23 +79,57 @@ TEST_F(UT_DoDeleteFilesWorker, testDeleteFilesOnCanNotRemoveDevice)
     worker.stop();
     EXPECT_TRUE(worker.deleteFilesOnCanNotRemoveDevice());
 
-    worker.allFilesList.append(QUrl());
+    QTemporaryDir tempDir;
+    ASSERT_TRUE(tempDir.isValid());
+    const QString &treePath = tempDir.path() + "/tree";
+    QDir().mkpath(treePath + "/sub");
+    QFile file(treePath + "/sub/file");
+    file.open(QIODevice::WriteOnly);
+    file.close();
+    const QUrl &treeUrl = QUrl::fromLocalFile(treePath);
+    worker.sourceUrls.append(treeUrl);
     EXPECT_FALSE(worker.deleteFilesOnCanNotRemoveDevice());
+    EXPECT_TRUE(QFileInfo::exists(treePath));
 
     worker.resume();
+    EXPECT_TRUE(worker.deleteFilesOnCanNotRemoveDevice());
+    EXPECT_FALSE(QFileInfo::exists(treePath));
+    EXPECT_TRUE(worker.completeSourceFiles.contains(treeUrl));
+    EXPECT_EQ(3, worker.deleteFilesCount.loadAcquire());
+    EXPECT_EQ(3, worker.foundFilesCount.loadAcquire());
+}
+
+TEST_F(UT_DoDeleteFilesWorker, testDeleteFilesOnCanNotRemoveDeviceFallback)
+{
+    DoDeleteFilesWorker worker;
+    stub_ext::StubExt stub;
+    worker.localFileHandler.reset(new LocalFileHandler);
+
+    QTemporaryDir tempDir;
+    ASSERT_TRUE(tempDir.isValid());
+    const QString &filePath = tempDir.path() + "/file";
+    QFile file(filePath);
+    file.open(QIODevice::WriteOnly);
+    file.close();
+    const QUrl &fileUrl = QUrl::fromLocalFile(filePath);
+    worker.sourceUrls.append(fileUrl);
+
+    // what the engine leaves on disk asks the user through the per entry path
+    stub.set_lamda(&LocalDeleteEngine::remove, []{ __DBG_STUB_INVOKE__ return false;});
+    stub.set_lamda(&LocalFileHandler::deleteFile, []{ __DBG_STUB_INVOKE__ return false;});
     stub.set_lamda(&DoDeleteFilesWorker::doHandleErrorAndWait, []{ __DBG_STUB_INVOKE__
                 return AbstractJobHandler::SupportAction::kNoAction;});
-    worker.sourceUrls.append(QUrl());
-    stub.set_lamda(&LocalFileHandler::deleteFile, []{ __DBG_STUB_INVOKE__ return false;});
     EXPECT_TRUE(worker.deleteFilesOnCanNotRemoveDevice());
 
     stub.set_lamda(&DoDeleteFilesWorker::doHandleErrorAndWait, []{ __DBG_STUB_INVOKE__
                 return AbstractJobHandler::SupportAction::kSkipAction;});
     EXPECT_TRUE(worker.deleteFilesOnCanNotRemoveDevice());
+    EXPECT_FALSE(worker.completeSourceFiles.contains(fileUrl));
 
     stub.set_lamda(&DoDeleteFilesWorker::doHandleErrorAndWait, []{ __DBG_STUB_INVOKE__
                 return AbstractJobHandler::SupportAction::kCancelAction;});
     EXPECT_FALSE(worker.deleteFilesOnCanNotRemoveDevice());
+    EXPECT_TRUE(QFileInfo::exists(filePath));
 }
 
 TEST_F(UT_DoDeleteFilesWorker, testDeleteFilesOnOtherDevice)
@@ -193,3 +232,31 @@ TEST_F(UT_DoDeleteFilesWorker, testDeleteDirOnOtherDevice)
     stub.set_lamda(&DoDeleteFilesWorker::deleteFileOnOtherDevice,[]{ __DBG_STUB_INVOKE__ return false;});
     EXPECT_FALSE(worker.deleteDirOnOtherDevice(info));
 }
+
+TEST_F(UT_DoDeleteFilesWorker, testDeleteDirOnOtherDeviceStopsAtMountPoint)
+{
+    DoDeleteFilesWorker worker;
+    stub_ext::StubExt stub;
+    worker.localFileHandler.reset(new LocalFileHandler);
+
+    QTemporaryDir tempDir;
+    ASSERT_TRUE(tempDir.isValid());
+    const QString &mountPath = tempDir.path() + "/mnt";
+    QDir().mkpath(mountPath);
+    QFile file(mountPath + "/file");
+    file.open(QIODevice::WriteOnly);
+    file.close();
+    auto info = InfoFactory::create<FileInfo>(QUrl::fromLocalFile(mountPath));
+
+    // the dir looks like a file system mounted inside the deleted tree
+    stub.set_lamda(&DoDeleteFilesWorker::deviceOf, []{ __DBG_STUB_INVOKE__ return static_cast<dev_t>(0xFFF002);});
+    stub.set_lamda(&DoDeleteFilesWorker::doHandleErrorAndWait, []{ __DBG_STUB_INVOKE__
+                return AbstractJobHandler::SupportAction::kSkipAction;});
+    EXPECT_TRUE(worker.deleteDirOnOtherDevice(info, static_cast<dev_t>(0xFFF001)));
+    EXPECT_TRUE(QFileInfo::exists(mountPath + "/file"));
+
+    stub.set_lamda(&DoDeleteFilesWorker::doHandleErrorAndWait, []{ __DBG_STUB_INVOKE__
+                return AbstractJobHandler::SupportAction::kCancelAction;});
+    EXPECT_FALSE(worker.deleteDirOnOtherDevice(info, static_cast<dev_t>(0xFFF001)));
+    EXPECT_TRUE(QFileInfo::exists(mountPath + "/file"));
+}
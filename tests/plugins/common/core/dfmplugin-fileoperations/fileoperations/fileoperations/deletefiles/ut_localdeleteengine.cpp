@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "plugins/common/core/dfmplugin-fileoperations/fileoperations/deletefiles/localdeleteengine.h"
+
+#include <QTemporaryDir>
+#include <QDir>
+#include <QFile>
+
+#include <gtest/gtest.h>
+
+#include <sys/resource.h>
+
+DPFILEOPERATIONS_USE_NAMESPACE
+
+class UT_LocalDeleteEngine : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        ASSERT_TRUE(tempDir.isValid());
+        root = tempDir.path() + "/tree";
+        for (int i = 0; i < 8; ++i) {
+            const QString &dir = QString("%1/dir%2/sub").arg(root).arg(i);
+            QDir().mkpath(dir);
+            for (int j = 0; j < 10; ++j) {
+                QFile file(QString("%1/file%2").arg(dir).arg(j));
+                file.open(QIODevice::WriteOnly);
+            }
+            QFile::link(dir, QString("%1/dir%2/link").arg(root).arg(i));
+        }
+    }
+    void TearDown() override {}
+
+    QTemporaryDir tempDir;
+    QString root;
+};
+
+TEST_F(UT_LocalDeleteEngine, testRemoveTree)
+{
+    QAtomicInteger<qint64> count { 0 };
+    QAtomicInteger<qint64> found { 0 };
+    LocalDeleteEngine engine(&count, []() { return true; }, &found);
+    EXPECT_TRUE(engine.remove(root));
+    EXPECT_FALSE(QFileInfo::exists(root));
+    // 8 * (10 files + sub + link + dir) + root
+    EXPECT_EQ(8 * 13 + 1, count.loadAcquire());
+    EXPECT_EQ(8 * 13 + 1, found.loadAcquire());
+    EXPECT_TRUE(engine.failedPaths().isEmpty());
+}
+
+TEST_F(UT_LocalDeleteEngine, testRemoveMissingPath)
+{
+    QAtomicInteger<qint64> count { 0 };
+    LocalDeleteEngine engine(&count, []() { return true; });
+    EXPECT_TRUE(engine.remove(root + "/missing"));
+    EXPECT_EQ(0, count.loadAcquire());
+}
+
+TEST_F(UT_LocalDeleteEngine, testStopped)
+{
+    QAtomicInteger<qint64> count { 0 };
+    LocalDeleteEngine engine(&count, []() { return false; });
+    EXPECT_FALSE(engine.remove(root));
+    EXPECT_TRUE(QFileInfo::exists(root));
+    EXPECT_TRUE(engine.failedPaths().isEmpty());
+}
+
+TEST_F(UT_LocalDeleteEngine, testRemovedNotifier)
+{
+    QAtomicInteger<qint64> count { 0 };
+    LocalDeleteEngine engine(&count, []() { return true; });
+    QStringList removed;
+    QMutex removedMutex;
+    engine.setRemovedNotifier([&](const QStringList &paths) {
+        QMutexLocker lk(&removedMutex);
+        removed.append(paths);
+    });
+
+    EXPECT_TRUE(engine.remove(root));
+    // every removed entry is reported once, the root included
+    EXPECT_EQ(count.loadAcquire(), removed.size());
+    QStringList unique = removed;
+    EXPECT_EQ(0, unique.removeDuplicates());
+    EXPECT_TRUE(removed.contains(root));
+    EXPECT_TRUE(removed.contains(root + "/dir3/sub/file7"));
+}
+
+TEST_F(UT_LocalDeleteEngine, testDeepTreeKeepsFewFds)
+{
+    QString deep = tempDir.path() + "/deep";
+    QString path = deep;
+    for (int i = 0; i < 200; ++i)
+        path += "/d";
+    ASSERT_TRUE(QDir().mkpath(path));
+
+    QAtomicInteger<qint64> count { 0 };
+    LocalDeleteEngine engine(&count, []() { return true; });
+    engine.pool.setMaxThreadCount(1);
+
+    // a walk holding one fd per level would run out of descriptors
+    struct rlimit limit;
+    ::getrlimit(RLIMIT_NOFILE, &limit);
+    struct rlimit lowered = limit;
+    lowered.rlim_cur = 64;
+    ::setrlimit(RLIMIT_NOFILE, &lowered);
+    const bool removed = engine.remove(deep);
+    ::setrlimit(RLIMIT_NOFILE, &limit);
+
+    EXPECT_TRUE(removed);
+    EXPECT_FALSE(QFileInfo::exists(deep));
+    EXPECT_EQ(201, count.loadAcquire());
+}
@@ -0,0 +1,108 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "plugins/common/core/dfmplugin-fileoperations/fileoperations/fileoperationutils/copybufferpipeline.h"
+
+#include <QByteArray>
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+DPFILEOPERATIONS_USE_NAMESPACE
+
+class UT_CopyBufferPipeline : public testing::Test
+{
+public:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(UT_CopyBufferPipeline, testReadInOrder)
+{
+    QByteArray source(10 * 1024 + 17, '\0');
+    for (int i = 0; i < source.size(); ++i)
+        source[i] = static_cast<char>(i % 251);
+
+    CopyBufferPipeline pipeline(3, 1024);
+    ASSERT_TRUE(pipeline.isValid());
+    EXPECT_EQ(1024, pipeline.blockSize());
+
+    qint64 readPos = 0;
+    pipeline.start([&](char *data, const qint64 maxSize) {
+        const qint64 size = qMin<qint64>(maxSize, source.size() - readPos);
+        memcpy(data, source.constData() + readPos, static_cast<size_t>(size));
+        readPos += size;
+        return size;
+    },
+                   0, source.size());
+
+    QByteArray target;
+    while (auto block = pipeline.takeFilled()) {
+        EXPECT_EQ(target.size(), block->offset);
+        target.append(block->data, static_cast<int>(block->size));
+        pipeline.recycle(block);
+    }
+    EXPECT_EQ(source, target);
+}
+
+TEST_F(UT_CopyBufferPipeline, testReadError)
+{
+    CopyBufferPipeline pipeline(2, 16);
+    int readCount = 0;
+    pipeline.start([&](char *, const qint64 maxSize) {
+        return ++readCount > 2 ? -1 : maxSize;
+    },
+                   0, 1024);
+
+    auto block = pipeline.takeFilled();
+    EXPECT_EQ(16, block->size);
+    pipeline.recycle(block);
+    block = pipeline.takeFilled();
+    EXPECT_EQ(16, block->size);
+    pipeline.recycle(block);
+    block = pipeline.takeFilled();
+    ASSERT_TRUE(block);
+    EXPECT_EQ(-1, block->size);
+    EXPECT_EQ(32, block->offset);
+    pipeline.recycle(block);
+    EXPECT_FALSE(pipeline.takeFilled());
+}
+
+TEST_F(UT_CopyBufferPipeline, testCancel)
+{
+    CopyBufferPipeline pipeline(2, 16);
+    pipeline.start([](char *, const qint64 maxSize) { return maxSize; }, 0, 1024 * 1024);
+    auto block = pipeline.takeFilled();
+    EXPECT_TRUE(block);
+    pipeline.cancel();
+    EXPECT_FALSE(pipeline.takeFilled());
+}
+
+TEST_F(UT_CopyBufferPipeline, testMemoryBudget)
+{
+    const qint64 blockSize = CopyBufferPipeline::maxTotalMemory() / 4;
+    {
+        CopyBufferPipeline first(4, blockSize);
+        ASSERT_TRUE(first.isValid());
+
+        // the budget is used up, no pipeline can be created until the first one is gone
+        CopyBufferPipeline second(4, blockSize);
+        EXPECT_FALSE(second.isValid());
+    }
+
+    CopyBufferPipeline third(4, blockSize);
+    EXPECT_TRUE(third.isValid());
+}
+
+TEST_F(UT_CopyBufferPipeline, testFewerBlocksWhenBudgetIsShort)
+{
+    const qint64 blockSize = CopyBufferPipeline::maxTotalMemory() / 4;
+    CopyBufferPipeline first(2, blockSize);
+    ASSERT_TRUE(first.isValid());
+
+    // only two blocks are left, the pipeline still works with them
+    CopyBufferPipeline second(4, blockSize);
+    EXPECT_TRUE(second.isValid());
+}
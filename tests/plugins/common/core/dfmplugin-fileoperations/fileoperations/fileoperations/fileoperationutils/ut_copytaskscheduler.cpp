@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "stubext.h"
+#include "plugins/common/core/dfmplugin-fileoperations/fileoperations/fileoperationutils/copytaskscheduler.h"
+
+#include <dfm-base/utils/fileutils.h>
+
+#include <QSemaphore>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+
+DPFILEOPERATIONS_USE_NAMESPACE
+DFMBASE_USE_NAMESPACE
+
+class UT_CopyTaskScheduler : public testing::Test
+{
+public:
+    void SetUp() override {}
+    void TearDown() override { stub.clear(); }
+
+    stub_ext::StubExt stub;
+};
+
+TEST_F(UT_CopyTaskScheduler, testSuggestedWorkerCount)
+{
+    stub.set_lamda(&FileUtils::getCpuProcessCount, [] { __DBG_STUB_INVOKE__ return 4; });
+    EXPECT_EQ(1, CopyTaskScheduler::suggestedWorkerCount(1, 1024));
+    EXPECT_EQ(3, CopyTaskScheduler::suggestedWorkerCount(3, 3 * 1024));
+    EXPECT_EQ(8, CopyTaskScheduler::suggestedWorkerCount(1000, 1000 * 1024));
+    EXPECT_EQ(2, CopyTaskScheduler::suggestedWorkerCount(10, 10 * 2 * 1024 * 1024));
+    EXPECT_EQ(4, CopyTaskScheduler::suggestedWorkerCount(10, 10LL * 1024 * 1024 * 1024));
+}
+
+TEST_F(UT_CopyTaskScheduler, testRunAllTasks)
+{
+    std::atomic_int done { 0 };
+    CopyTaskScheduler scheduler(4, [&done](const int, const CopyTask &) { done++; });
+    EXPECT_EQ(4, scheduler.workerCount());
+    for (int i = 0; i < 100; ++i) {
+        CopyTask task;
+        task.size = i;
+        scheduler.submit(task);
+    }
+    scheduler.waitForIdle();
+    EXPECT_EQ(100, done);
+    EXPECT_EQ(0, scheduler.pendingCount());
+}
+
+TEST_F(UT_CopyTaskScheduler, testStealFromBlockedWorker)
+{
+    QSemaphore blocked;
+    std::atomic_int done { 0 };
+    CopyTaskScheduler scheduler(2, [&](const int, const CopyTask &task) {
+        if (task.size > 0)
+            blocked.acquire();
+        done++;
+    });
+
+    CopyTask slow;
+    slow.size = 2LL * 1024 * 1024 * 1024;
+    scheduler.submit(slow);
+    for (int i = 0; i < 10; ++i)
+        scheduler.submit(CopyTask());
+
+    // the other worker drains everything while the first one is stuck
+    while (done < 10)
+        QThread::msleep(1);
+    EXPECT_EQ(0, scheduler.pendingCount());
+
+    blocked.release();
+    scheduler.waitForIdle();
+    EXPECT_EQ(11, done);
+}
+
+TEST_F(UT_CopyTaskScheduler, testStop)
+{
+    QSemaphore blocked;
+    CopyTaskScheduler scheduler(1, [&](const int, const CopyTask &) { blocked.acquire(); });
+    for (int i = 0; i < 10; ++i)
+        scheduler.submit(CopyTask());
+    scheduler.stop();
+    EXPECT_EQ(0, scheduler.pendingCount());
+    blocked.release(10);
+    scheduler.waitForIdle();
+}
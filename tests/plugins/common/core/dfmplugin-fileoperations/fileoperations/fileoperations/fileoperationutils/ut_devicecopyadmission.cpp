@@ -0,0 +1,91 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "plugins/common/core/dfmplugin-fileoperations/fileoperations/fileoperationutils/devicecopyadmission.h"
+
+#include <QThread>
+#include <QAtomicInt>
+
+#include <gtest/gtest.h>
+
+DPFILEOPERATIONS_USE_NAMESPACE
+
+class UT_DeviceCopyAdmission : public testing::Test
+{
+public:
+    void SetUp() override {}
+    void TearDown() override {}
+
+    // device ids that never collide with real devices used by other tests
+    const DeviceCopyAdmission::Devices devA { static_cast<dev_t>(0xFFF001) };
+    const DeviceCopyAdmission::Devices devB { static_cast<dev_t>(0xFFF002) };
+    const DeviceCopyAdmission::Devices devAB { static_cast<dev_t>(0xFFF001), static_cast<dev_t>(0xFFF002) };
+};
+
+TEST_F(UT_DeviceCopyAdmission, testPerDeviceLimit)
+{
+    auto admission = DeviceCopyAdmission::instance();
+    auto canceled = []() { return true; };
+
+    ASSERT_TRUE(admission->acquire(devA, nullptr));
+    // the device is busy, a canceled waiter gives up instead of blocking
+    EXPECT_FALSE(admission->acquire(devA, canceled));
+    EXPECT_FALSE(admission->acquire(devAB, canceled));
+    // an independent device is admitted
+    ASSERT_TRUE(admission->acquire(devB, nullptr));
+
+    admission->release(devA);
+    admission->release(devB);
+    ASSERT_TRUE(admission->acquire(devAB, nullptr));
+    admission->release(devAB);
+}
+
+TEST_F(UT_DeviceCopyAdmission, testWaiterAdmittedOnRelease)
+{
+    auto admission = DeviceCopyAdmission::instance();
+    ASSERT_TRUE(admission->acquire(devA, nullptr));
+
+    QAtomicInt admitted { 0 };
+    QThread *waiter = QThread::create([&]() {
+        if (admission->acquire(devA, nullptr))
+            admitted.storeRelease(1);
+    });
+    waiter->start();
+    EXPECT_FALSE(waiter->wait(100));
+    EXPECT_EQ(0, admitted.loadAcquire());
+
+    // the copy failed or finished, its slot is handed to the waiter
+    admission->release(devA);
+    EXPECT_TRUE(waiter->wait(5000));
+    EXPECT_EQ(1, admitted.loadAcquire());
+    delete waiter;
+
+    admission->release(devA);
+}
+
+TEST_F(UT_DeviceCopyAdmission, testCancelWhileWaiting)
+{
+    auto admission = DeviceCopyAdmission::instance();
+    ASSERT_TRUE(admission->acquire(devA, nullptr));
+
+    QAtomicInt stopped { 0 };
+    QAtomicInt result { -1 };
+    QThread *waiter = QThread::create([&]() {
+        result.storeRelease(admission->acquire(devA, [&]() { return stopped.loadAcquire() == 1; }) ? 1 : 0);
+    });
+    waiter->start();
+    EXPECT_FALSE(waiter->wait(100));
+
+    // the job is stopped, the waiter leaves without taking a slot
+    stopped.storeRelease(1);
+    admission->wakeWaiters();
+    EXPECT_TRUE(waiter->wait(5000));
+    EXPECT_EQ(0, result.loadAcquire());
+    delete waiter;
+
+    admission->release(devA);
+    // nothing is left behind by the canceled waiter
+    ASSERT_TRUE(admission->acquire(devA, nullptr));
+    admission->release(devA);
+}
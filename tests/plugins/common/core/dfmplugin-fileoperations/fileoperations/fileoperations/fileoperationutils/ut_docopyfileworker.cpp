@@ -12,8 +12,12 @@
 #include <dfm-base/file/local/localfilehandler.h>
 #include <dfm-base/utils/fileutils.h>
 
+#include <QTemporaryDir>
+
 #include <gtest/gtest.h>
 
+#include <zlib.h>
+
 
 DPFILEOPERATIONS_USE_NAMESPACE
 DFMBASE_USE_NAMESPACE
@@ -432,6 +436,89 @@ TEST_F(UT_DoCopyFileWorker, testVerifyFileIntegrity)
     EXPECT_TRUE(worker.verifyFileIntegrity(blocksize, 12517567, sorceInfo, targetInfo, file));
 }
 
+TEST_F(UT_DoCopyFileWorker, testVerifyFileIntegrityCorruptedTarget)
+{
+    QTemporaryDir dir;
+    const QByteArray content(4096, 'a');
+    QByteArray corrupted(content);
+    corrupted[100] = 'b';
+    auto writeFile = [&dir](const QString &name, const QByteArray &data) {
+        QFile file(dir.filePath(name));
+        file.open(QIODevice::WriteOnly | QIODevice::Truncate);
+        file.write(data);
+        return QUrl::fromLocalFile(file.fileName());
+    };
+    const QUrl &sourceUrl = writeFile("source", content);
+    const QUrl &targetUrl = writeFile("target", content);
+
+    QSharedPointer<WorkerData> data(new WorkerData);
+    data->jobFlags |= AbstractJobHandler::JobFlag::kCopyIntegrityChecking;
+    data->jobFlags |= AbstractJobHandler::JobFlag::kCopyIntegrityReread;
+    DoCopyFileWorker worker(data);
+    DFileInfoPointer sourceInfo(new DFileInfo(sourceUrl));
+    DFileInfoPointer targetInfo(new DFileInfo(targetUrl));
+    QSharedPointer<DFMIO::DFile> targetDevice { new DFile(targetUrl) };
+
+    stub_ext::StubExt stub;
+    stub.set_lamda(&DoCopyFileWorker::doHandleErrorAndWait, [] {
+        __DBG_STUB_INVOKE__
+        return AbstractJobHandler::SupportAction::kNoAction;
+    });
+
+    // the checksum of the source is what the copy read, the target is read back from disk
+    const ulong sourceCheckSum = adler32(adler32(0L, nullptr, 0), reinterpret_cast<const Bytef *>(content.constData()),
+                                         static_cast<uInt>(content.size()));
+    EXPECT_TRUE(worker.verifyFileIntegrity(512, sourceCheckSum, sourceInfo, targetInfo, targetDevice));
+
+    writeFile("target", corrupted);
+    targetInfo->refresh();
+    EXPECT_FALSE(worker.verifyFileIntegrity(512, sourceCheckSum, sourceInfo, targetInfo, targetDevice));
+}
+
+TEST_F(UT_DoCopyFileWorker, testVerifyFileIntegrityStreaming)
+{
+    QTemporaryDir dir;
+    const QByteArray content(4096, 'a');
+    QFile file(dir.filePath("source"));
+    file.open(QIODevice::WriteOnly | QIODevice::Truncate);
+    file.write(content);
+    file.close();
+    const QUrl &sourceUrl = QUrl::fromLocalFile(file.fileName());
+    const QUrl &targetUrl = QUrl::fromLocalFile(dir.filePath("target"));
+
+    QSharedPointer<WorkerData> data(new WorkerData);
+    data->jobFlags |= AbstractJobHandler::JobFlag::kCopyIntegrityChecking;
+    DoCopyFileWorker worker(data);
+    DFileInfoPointer sourceInfo(new DFileInfo(sourceUrl));
+    DFileInfoPointer targetInfo(new DFileInfo(targetUrl));
+    QSharedPointer<DFMIO::DFile> targetDevice { new DFile(targetUrl) };
+
+    stub_ext::StubExt stub;
+    bool reread = false;
+    stub.set_lamda(&DoCopyFileWorker::rereadTargetCheckSum, [&reread] {
+        __DBG_STUB_INVOKE__
+        reread = true;
+        return false;
+    });
+    stub.set_lamda(&DoCopyFileWorker::doHandleErrorAndWait, [] {
+        __DBG_STUB_INVOKE__
+        return AbstractJobHandler::SupportAction::kNoAction;
+    });
+
+    // the default check uses the checksum of the written buffers, the target is not read back
+    const ulong checkSum = adler32(adler32(0L, nullptr, 0), reinterpret_cast<const Bytef *>(content.constData()),
+                                   static_cast<uInt>(content.size()));
+    worker.writtenCheckSum = checkSum;
+    worker.writtenSize = content.size();
+    EXPECT_TRUE(worker.verifyFileIntegrity(512, checkSum, sourceInfo, targetInfo, targetDevice));
+    EXPECT_FALSE(reread);
+
+    // a short write fails the check even if the buffers matched
+    worker.writtenSize = content.size() - 1;
+    EXPECT_FALSE(worker.verifyFileIntegrity(512, checkSum, sourceInfo, targetInfo, targetDevice));
+    EXPECT_FALSE(reread);
+}
+
 int OpenFunc(const char *__file, int __oflag, ...){
     Q_UNUSED(__file);
     Q_UNUSED(__oflag);
@@ -0,0 +1,155 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "stubext.h"
+
+#include "plugins/common/core/dfmplugin-fileoperations/fileoperations/fileoperationutils/fileclonehelper.h"
+#include "plugins/common/core/dfmplugin-fileoperations/fileoperations/fileoperationutils/docopyfileworker.h"
+#include "plugins/common/core/dfmplugin-fileoperations/fileoperations/fileoperationutils/workerdata.h"
+
+#include <QTemporaryDir>
+#include <QFile>
+
+#include <gtest/gtest.h>
+
+#include <sys/ioctl.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+
+DPFILEOPERATIONS_USE_NAMESPACE
+
+static int ioctlCount { 0 };
+static int ioctlErrno { 0 };
+
+static int IoctlFunc(int, unsigned long, ...)
+{
+    ++ioctlCount;
+    if (ioctlErrno == 0)
+        return 0;
+    errno = ioctlErrno;
+    return -1;
+}
+
+class UT_FileCloneHelper : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        ioctlCount = 0;
+        ioctlErrno = 0;
+        FileCloneHelper::supportCache.clear();
+        stub.set(&::ioctl, IoctlFunc);
+
+        QFile source(dir.filePath("source"));
+        source.open(QIODevice::WriteOnly);
+        source.write(QByteArray(4096, 'a'));
+        source.close();
+        sourceUrl = QUrl::fromLocalFile(source.fileName());
+        targetUrl = QUrl::fromLocalFile(dir.filePath("target"));
+    }
+    void TearDown() override
+    {
+        stub.clear();
+        FileCloneHelper::supportCache.clear();
+    }
+
+    int openSource() { return open(QFile::encodeName(sourceUrl.path()).constData(), O_RDONLY); }
+    int openTarget() { return open(QFile::encodeName(targetUrl.path()).constData(), O_CREAT | O_WRONLY | O_TRUNC, 0644); }
+
+    stub_ext::StubExt stub;
+    QTemporaryDir dir;
+    QUrl sourceUrl;
+    QUrl targetUrl;
+};
+
+TEST_F(UT_FileCloneHelper, testCloned)
+{
+    int sourceFd = openSource();
+    int targetFd = openTarget();
+    EXPECT_EQ(FileCloneHelper::CloneResult::kCloned, FileCloneHelper::cloneFile(sourceFd, targetFd));
+    EXPECT_EQ(FileCloneHelper::CloneResult::kCloned, FileCloneHelper::cloneFile(sourceFd, targetFd));
+    EXPECT_EQ(2, ioctlCount);
+    close(sourceFd);
+    close(targetFd);
+}
+
+TEST_F(UT_FileCloneHelper, testUnsupportedIsRemembered)
+{
+    ioctlErrno = EOPNOTSUPP;
+    int sourceFd = openSource();
+    int targetFd = openTarget();
+    EXPECT_EQ(FileCloneHelper::CloneResult::kNotSupported, FileCloneHelper::cloneFile(sourceFd, targetFd));
+    // the device pair is known to be unsupported, the ioctl is not tried again
+    EXPECT_EQ(FileCloneHelper::CloneResult::kNotSupported, FileCloneHelper::cloneFile(sourceFd, targetFd));
+    EXPECT_EQ(1, ioctlCount);
+    close(sourceFd);
+    close(targetFd);
+}
+
+TEST_F(UT_FileCloneHelper, testFailedOnSupportedDevice)
+{
+    int sourceFd = openSource();
+    int targetFd = openTarget();
+    ASSERT_EQ(FileCloneHelper::CloneResult::kCloned, FileCloneHelper::cloneFile(sourceFd, targetFd));
+
+    // EINVAL on a pair that cloned before is a per file failure, not a missing feature
+    ioctlErrno = EINVAL;
+    EXPECT_EQ(FileCloneHelper::CloneResult::kFailed, FileCloneHelper::cloneFile(sourceFd, targetFd));
+    ioctlErrno = 0;
+    EXPECT_EQ(FileCloneHelper::CloneResult::kCloned, FileCloneHelper::cloneFile(sourceFd, targetFd));
+    close(sourceFd);
+    close(targetFd);
+}
+
+TEST_F(UT_FileCloneHelper, testCloneFsType)
+{
+    EXPECT_TRUE(FileCloneHelper::isCloneFsType("btrfs"));
+    EXPECT_TRUE(FileCloneHelper::isCloneFsType("xfs"));
+    EXPECT_TRUE(FileCloneHelper::isCloneFsType("bcachefs"));
+    EXPECT_FALSE(FileCloneHelper::isCloneFsType("ext4"));
+    EXPECT_FALSE(FileCloneHelper::isCloneFsType("vfat"));
+}
+
+TEST_F(UT_FileCloneHelper, testWorkerFallsBackWhenNotCloned)
+{
+    QSharedPointer<WorkerData> data(new WorkerData);
+    DoCopyFileWorker worker(data);
+    DFileInfoPointer fromInfo(new DFileInfo(sourceUrl));
+    DFileInfoPointer toInfo(new DFileInfo(targetUrl));
+    stub.set_lamda(static_cast<void (DoCopyFileWorker::*)(const QUrl &, const QUrl &)>(&DoCopyFileWorker::setTargetPermissions),
+                   [] { __DBG_STUB_INVOKE__ });
+
+    ioctlErrno = EXDEV;
+    EXPECT_FALSE(worker.doCloneFile(fromInfo, toInfo));
+    EXPECT_EQ(0, data->clonedFileCount.loadAcquire());
+    EXPECT_EQ(0, data->currentWriteSize.load());
+    // the target created for the clone is removed, the fallback copy creates it again
+    EXPECT_FALSE(QFile::exists(targetUrl.path()));
+
+    // the pair is known to be unsupported, the target is not even created
+    EXPECT_FALSE(worker.doCloneFile(fromInfo, toInfo));
+    EXPECT_EQ(1, ioctlCount);
+    EXPECT_FALSE(QFile::exists(targetUrl.path()));
+
+    FileCloneHelper::supportCache.clear();
+    ioctlErrno = 0;
+    EXPECT_TRUE(worker.doCloneFile(fromInfo, toInfo));
+    EXPECT_EQ(1, data->clonedFileCount.loadAcquire());
+    EXPECT_EQ(4096, data->currentWriteSize.load());
+}
+
+TEST_F(UT_FileCloneHelper, testWorkerKeepsExistingTarget)
+{
+    QSharedPointer<WorkerData> data(new WorkerData);
+    DoCopyFileWorker worker(data);
+    DFileInfoPointer fromInfo(new DFileInfo(sourceUrl));
+    DFileInfoPointer toInfo(new DFileInfo(targetUrl));
+    close(openTarget());
+
+    // a target that existed before the clone is left for the fallback copy to overwrite
+    ioctlErrno = EOPNOTSUPP;
+    EXPECT_FALSE(worker.doCloneFile(fromInfo, toInfo));
+    EXPECT_TRUE(QFile::exists(targetUrl.path()));
+}
@@ -622,7 +622,6 @@ TEST_F(UT_FileOperateBaseWorker, testDoCopyLocalBigFile)
             sorcefile.write(data);
         }
         sorcefile.close();
-        worker.threadPool.reset(new QThreadPool);
         worker.initThreadCopy();
         EXPECT_FALSE(worker.doCopyLocalBigFile(sorceInfo, targetInfo, &skip));
         sorceInfo->refresh();
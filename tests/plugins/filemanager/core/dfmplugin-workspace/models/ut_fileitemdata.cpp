@@ -179,6 +179,20 @@ TEST_F(UT_FileItemData, FileLastModifiedData){
     }
 }
 
+TEST_F(UT_FileItemData, FileLastModifiedDataChanged){
+    itemData->data(kItemCreateFileInfoRole);
+
+    QDateTime modified(QDate(2024, 1, 1), QTime(8, 0, 0));
+    stub.set_lamda(VADDR(SyncFileInfo, timeOf), [&modified](FileInfo *, const FileInfo::FileTimeType) {
+        return QVariant(modified);
+    });
+
+    EXPECT_EQ(itemData->data(kItemFileLastModifiedRole).toString(), modified.toString(FileUtils::dateTimeFormat()));
+
+    modified = modified.addSecs(60);
+    EXPECT_EQ(itemData->data(kItemFileLastModifiedRole).toString(), modified.toString(FileUtils::dateTimeFormat()));
+}
+
 TEST_F(UT_FileItemData, IconData){
     QIcon defaultIcon("defaultIcon");
     stub.set_lamda(ADDR(FileItemData, fileIcon), [&defaultIcon]{
@@ -446,6 +446,44 @@ TEST_F(UT_RootInfo, HandleTraversalFinish)
     EXPECT_TRUE(rootInfoObj->traversalFinish);
 }
 
+TEST_F(UT_RootInfo, MergeSnapshotOneByOne)
+{
+    auto sortInfo = [](const QString &name) {
+        SortInfoPointer info(new SortFileInfo);
+        info->setUrl(QUrl::fromLocalFile("/tmp/snapshot/" + name));
+        info->setFile(true);
+        return info;
+    };
+    const SortInfoPointer kept = sortInfo("kept");
+    const SortInfoPointer gone = sortInfo("gone");
+    rootInfoObj->addChildren(QList<SortInfoPointer> { kept, gone });
+    rootInfoObj->snapshotPending.insert(kept->fileUrl(), kept);
+    rootInfoObj->snapshotPending.insert(gone->fileUrl(), gone);
+    rootInfoObj->snapshotShown = true;
+
+    QList<SortInfoPointer> added;
+    QList<SortInfoPointer> removed;
+    QObject::connect(rootInfoObj, &RootInfo::watcherAddFiles, rootInfoObj,
+                     [&added](const QList<SortInfoPointer> &children) { added.append(children); });
+    QObject::connect(rootInfoObj, &RootInfo::watcherRemoveFiles, rootInfoObj,
+                     [&removed](const QList<SortInfoPointer> &children) { removed.append(children); });
+
+    // a shown row listed again must not be added a second time
+    rootInfoObj->mergeSnapshot({ sortInfo("kept"), sortInfo("new") });
+    ASSERT_EQ(1, added.count());
+    EXPECT_EQ(QUrl::fromLocalFile("/tmp/snapshot/new"), added.first()->fileUrl());
+
+    rootInfoObj->handleTraversalFinish("travseToken");
+    ASSERT_EQ(1, removed.count());
+    EXPECT_EQ(gone, removed.first());
+    EXPECT_FALSE(rootInfoObj->snapshotShown);
+    EXPECT_TRUE(rootInfoObj->snapshotPending.isEmpty());
+    EXPECT_EQ((QList<QUrl> { kept->fileUrl(), QUrl::fromLocalFile("/tmp/snapshot/new") }), rootInfoObj->childrenUrlList);
+    // the membership set follows the list
+    EXPECT_EQ((QSet<QUrl> { kept->fileUrl(), QUrl::fromLocalFile("/tmp/snapshot/new") }), rootInfoObj->childrenUrlSet);
+    EXPECT_FALSE(rootInfoObj->containsChild(gone->fileUrl()));
+}
+
 TEST_F(UT_RootInfo, HandleTraversalSort)
 {
 
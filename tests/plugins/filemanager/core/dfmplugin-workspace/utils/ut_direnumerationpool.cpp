@@ -0,0 +1,58 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "plugins/filemanager/core/dfmplugin-workspace/utils/direnumerationpool.h"
+
+#include <gtest/gtest.h>
+
+DPWORKSPACE_USE_NAMESPACE
+
+TEST(UT_DirEnumerationPool, SlowDeviceLimit)
+{
+    const QUrl &dir = QUrl("smb://127.0.0.1/share/dir");
+    QString first;
+    QString second;
+    ASSERT_TRUE(DirEnumerationPool::instance()->acquire(dir, &first, nullptr));
+    ASSERT_TRUE(DirEnumerationPool::instance()->acquire(dir, &second, nullptr));
+    EXPECT_EQ(first, second);
+
+    // the device is busy, a stopped traversal gives up instead of waiting
+    QString third;
+    EXPECT_FALSE(DirEnumerationPool::instance()->acquire(dir, &third, [] { return true; }));
+
+    DirEnumerationPool::instance()->release(first);
+    EXPECT_TRUE(DirEnumerationPool::instance()->acquire(dir, &third, [] { return true; }));
+    DirEnumerationPool::instance()->release(third);
+
+    // other devices are not affected by a busy one
+    QString other;
+    EXPECT_TRUE(DirEnumerationPool::instance()->acquire(QUrl("smb://127.0.0.2/share"), &other, [] { return true; }));
+    EXPECT_NE(second, other);
+    DirEnumerationPool::instance()->release(other);
+    DirEnumerationPool::instance()->release(second);
+}
+
+TEST(UT_DirEnumerationPool, RemoteDoesNotBlockLocal)
+{
+    auto pool = DirEnumerationPool::instance();
+    // fill the whole remote budget with hanging enumerations on distinct hosts
+    QStringList remoteKeys;
+    for (int i = 0; i < pool->remoteSlots.max; ++i) {
+        QString key;
+        ASSERT_TRUE(pool->acquire(QUrl(QString("smb://127.0.1.%1/share").arg(i + 1)), &key, nullptr));
+        remoteKeys.append(key);
+    }
+    QString blocked;
+    EXPECT_FALSE(pool->acquire(QUrl("smb://127.0.2.1/share"), &blocked, [] { return true; }));
+
+    // local enumerations draw from their own budget
+    QString local;
+    EXPECT_TRUE(pool->acquire(QUrl::fromLocalFile("/"), &local, [] { return true; }));
+    pool->release(local);
+
+    for (const auto &key : remoteKeys)
+        pool->release(key);
+    EXPECT_EQ(0, pool->remoteSlots.running);
+    EXPECT_EQ(0, pool->localSlots.running);
+}
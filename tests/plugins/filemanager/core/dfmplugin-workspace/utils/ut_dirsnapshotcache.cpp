@@ -0,0 +1,94 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "stubext.h"
+#include "plugins/filemanager/core/dfmplugin-workspace/utils/dirsnapshotcache.h"
+
+#include <dfm-base/base/standardpaths.h>
+
+#include <gtest/gtest.h>
+
+#include <QTemporaryDir>
+#include <QFile>
+
+DFMBASE_USE_NAMESPACE
+DPWORKSPACE_USE_NAMESPACE
+
+class UT_DirSnapshotCache : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        QString (*location)(StandardPaths::StandardLocation) = &StandardPaths::location;
+        stub.set_lamda(location, [this](StandardPaths::StandardLocation) {
+            __DBG_STUB_INVOKE__
+            return cacheDir.path();
+        });
+    }
+    void TearDown() override
+    {
+        stub.clear();
+    }
+
+    SortInfoPointer createChild(const QString &name, qint64 size, bool isDir)
+    {
+        SortInfoPointer sortInfo(new SortFileInfo);
+        sortInfo->setUrl(QUrl::fromLocalFile(dir.path() + "/" + name));
+        sortInfo->setSize(size);
+        sortInfo->setDir(isDir);
+        sortInfo->setFile(!isDir);
+        sortInfo->setReadable(true);
+        return sortInfo;
+    }
+
+    stub_ext::StubExt stub;
+    QTemporaryDir cacheDir;
+    QTemporaryDir dir;
+};
+
+TEST_F(UT_DirSnapshotCache, SaveAndLoad)
+{
+    const QUrl &url = QUrl::fromLocalFile(dir.path());
+    DirSnapshotCache::DirKey key;
+    ASSERT_TRUE(DirSnapshotCache::dirKey(url, &key));
+    EXPECT_TRUE(key.isValid());
+
+    DirSnapshotCache::Snapshot snapshot;
+    snapshot.children << createChild("a.txt", 12, false) << createChild("目录", 0, true);
+    snapshot.sortOrder = Qt::DescendingOrder;
+    snapshot.isMixDirAndFile = true;
+    EXPECT_TRUE(DirSnapshotCache::save(url, key, snapshot));
+
+    DirSnapshotCache::Snapshot loaded;
+    ASSERT_TRUE(DirSnapshotCache::load(url, key, &loaded));
+    ASSERT_EQ(2, loaded.children.count());
+    EXPECT_EQ(snapshot.children.at(0)->fileUrl(), loaded.children.at(0)->fileUrl());
+    EXPECT_EQ(12, loaded.children.at(0)->fileSize());
+    EXPECT_TRUE(loaded.children.at(0)->isFile());
+    EXPECT_EQ(snapshot.children.at(1)->fileUrl(), loaded.children.at(1)->fileUrl());
+    EXPECT_TRUE(loaded.children.at(1)->isDir());
+    EXPECT_TRUE(loaded.children.at(1)->isReadable());
+    EXPECT_EQ(Qt::DescendingOrder, loaded.sortOrder);
+    EXPECT_TRUE(loaded.isMixDirAndFile);
+}
+
+TEST_F(UT_DirSnapshotCache, StaleKey)
+{
+    const QUrl &url = QUrl::fromLocalFile(dir.path());
+    DirSnapshotCache::DirKey key;
+    ASSERT_TRUE(DirSnapshotCache::dirKey(url, &key));
+
+    DirSnapshotCache::Snapshot snapshot;
+    snapshot.children << createChild("a.txt", 12, false);
+    EXPECT_TRUE(DirSnapshotCache::save(url, key, snapshot));
+
+    DirSnapshotCache::DirKey changed = key;
+    changed.mtimeNsec += 1;
+    DirSnapshotCache::Snapshot loaded;
+    EXPECT_FALSE(DirSnapshotCache::load(url, changed, &loaded));
+
+    DirSnapshotCache::remove(url);
+    EXPECT_FALSE(DirSnapshotCache::load(url, key, &loaded));
+    EXPECT_FALSE(DirSnapshotCache::dirKey(QUrl::fromLocalFile(dir.path() + "/nothing"), &key));
+}
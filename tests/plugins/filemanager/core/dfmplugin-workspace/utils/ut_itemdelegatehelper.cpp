@@ -0,0 +1,42 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "plugins/filemanager/core/dfmplugin-workspace/utils/itemdelegatehelper.h"
+
+#include <QImage>
+#include <QPainter>
+
+#include <gtest/gtest.h>
+
+using namespace dfmplugin_workspace;
+
+class UT_ItemDelegateHelper : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        image = QImage(400, 100, QImage::Format_ARGB32);
+        painter.begin(&image);
+    }
+    void TearDown() override
+    {
+        painter.end();
+    }
+
+    QImage image;
+    QPainter painter;
+};
+
+TEST_F(UT_ItemDelegateHelper, LayoutCachedTextWithPlaceholders)
+{
+    const QRectF rect(0, 0, 400, 20);
+    const QString &name("a%2b%3c%8");
+    const QStringList &lines = ItemDelegateHelper::layoutCachedText(name, rect, 20, Qt::AlignLeft, Qt::ElideRight, &painter, false);
+    EXPECT_EQ(lines.join(""), name);
+
+    // the cached lines of one name are never served for another
+    const QString &other("a%3b%2c%8");
+    EXPECT_EQ(ItemDelegateHelper::layoutCachedText(other, rect, 20, Qt::AlignLeft, Qt::ElideRight, &painter, false).join(""), other);
+    EXPECT_EQ(ItemDelegateHelper::layoutCachedText(name, rect, 20, Qt::AlignLeft, Qt::ElideRight, &painter, false).join(""), name);
+}
@@ -0,0 +1,118 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "plugins/filemanager/core/dfmplugin-workspace/utils/visibleurllist.h"
+
+#include <gtest/gtest.h>
+
+using namespace dfmplugin_workspace;
+
+static QUrl testUrl(int i)
+{
+    return QUrl::fromLocalFile(QString("/tmp/file%1").arg(i));
+}
+
+class UT_VisibleUrlList : public testing::Test
+{
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+
+    VisibleUrlList list;
+};
+
+TEST_F(UT_VisibleUrlList, SetUrls)
+{
+    QList<QUrl> urls;
+    for (int i = 0; i < 2000; ++i)
+        urls.append(testUrl(i));
+    list.setUrls(urls);
+
+    EXPECT_EQ(2000, list.count());
+    EXPECT_EQ(urls, list.toList());
+    EXPECT_EQ(testUrl(1500), list.at(1500));
+    EXPECT_EQ(777, list.indexOf(testUrl(777)));
+    EXPECT_EQ(-1, list.indexOf(testUrl(5000)));
+    EXPECT_EQ(QUrl(), list.at(2000));
+}
+
+TEST_F(UT_VisibleUrlList, InsertAndRemove)
+{
+    QList<QUrl> expected;
+    // insert in the middle often enough to split chunks
+    for (int i = 0; i < 3000; ++i) {
+        const int row = expected.count() / 2;
+        expected.insert(row, testUrl(i));
+        list.insert(row, testUrl(i));
+    }
+    list.insert(-1, testUrl(9999));
+    expected.append(testUrl(9999));
+
+    EXPECT_EQ(expected, list.toList());
+    for (int row : { 0, 511, 512, 1700, 3000 })
+        EXPECT_EQ(row, list.indexOf(expected.at(row)));
+
+    for (int i = 0; i < 1000; ++i) {
+        const int row = (i * 7) % expected.count();
+        EXPECT_TRUE(list.contains(expected.at(row)));
+        list.removeAt(row);
+        EXPECT_FALSE(list.contains(expected.at(row)));
+        expected.removeAt(row);
+    }
+    EXPECT_EQ(expected, list.toList());
+    EXPECT_EQ(expected.count(), list.count());
+    EXPECT_EQ(expected.count() - 1, list.indexOf(expected.last()));
+
+    list.clear();
+    EXPECT_TRUE(list.isEmpty());
+    list.insert(0, testUrl(1));
+    EXPECT_EQ(0, list.indexOf(testUrl(1)));
+}
+
+TEST_F(UT_VisibleUrlList, RangeInsertAndRemove)
+{
+    QList<QUrl> expected;
+    int next = 0;
+    auto batch = [&next](int size) {
+        QList<QUrl> urls;
+        for (int i = 0; i < size; ++i)
+            urls.append(testUrl(next++));
+        return urls;
+    };
+    auto insertBoth = [&](int row, const QList<QUrl> &urls) {
+        list.insert(row, urls);
+        for (int i = 0; i < urls.count(); ++i)
+            expected.insert(qMin(row, expected.count()) + i, urls.at(i));
+    };
+
+    // appended batches, small batches that fit a chunk and big ones that split it
+    for (int i = 0; i < 6; ++i)
+        insertBoth(expected.count(), batch(500));
+    insertBoth(0, batch(10));
+    insertBoth(1234, batch(700));
+    insertBoth(1234, batch(3));
+    insertBoth(-1, batch(1));
+    EXPECT_EQ(expected, list.toList());
+    for (int row : { 0, 9, 10, 1233, 1234, 1937, expected.count() - 1 })
+        EXPECT_EQ(row, list.indexOf(expected.at(row)));
+
+    // ranges inside one chunk, across chunks and up to the end
+    for (auto range : { qMakePair(5, 3), qMakePair(100, 1500), qMakePair(0, 1), qMakePair(1000, 100000) }) {
+        const QList<QUrl> removed = expected.mid(range.first, range.second);
+        list.remove(range.first, range.second);
+        expected.erase(expected.begin() + range.first, expected.begin() + qMin(expected.count(), range.first + range.second));
+        EXPECT_EQ(expected, list.toList());
+        EXPECT_EQ(expected.count(), list.count());
+        for (const auto &url : removed)
+            EXPECT_FALSE(list.contains(url));
+    }
+    for (int row = 0; row < expected.count(); row += 97)
+        EXPECT_EQ(row, list.indexOf(expected.at(row)));
+
+    list.remove(0, list.count());
+    expected.clear();
+    EXPECT_TRUE(list.isEmpty());
+    insertBoth(0, batch(2));
+    EXPECT_EQ(1, list.indexOf(testUrl(next - 1)));
+}
@@ -57,6 +57,34 @@ TEST(FSearchHandlerTest, ut_loadDatabase)
     EXPECT_TRUE(handler.loadDatabase("/", ""));
 }
 
+TEST(FSearchHandlerTest, ut_loadSharedDatabase)
+{
+    int builds = 0;
+    int refreshes = 0;
+    stub_ext::StubExt st;
+    st.set_lamda(load_database, [&] { __DBG_STUB_INVOKE__ ++builds; return true; });
+    st.set_lamda(db_location_refresh, [&] { __DBG_STUB_INVOKE__ ++refreshes; return 0u; });
+    st.set_lamda(db_location_refresh_dir, [&] { __DBG_STUB_INVOKE__ ++refreshes; return 0u; });
+
+    FSearchHandler first;
+    first.init();
+    Database *ownDb = first.app->db;
+    EXPECT_TRUE(first.loadSharedDatabase("/tmp/ut_fsearch"));
+    EXPECT_NE(ownDb, first.app->db);
+    first.releaseSharedDatabase();
+    EXPECT_EQ(ownDb, first.app->db);
+
+    // the second search refreshes the database built by the first one
+    FSearchHandler::markDirChanged("/tmp/ut_fsearch/dir");
+    FSearchHandler second;
+    second.init();
+    EXPECT_TRUE(second.loadSharedDatabase("/tmp/ut_fsearch"));
+    second.releaseSharedDatabase();
+
+    EXPECT_EQ(1, builds);
+    EXPECT_EQ(2, refreshes);
+}
+
 TEST(FSearchHandlerTest, ut_updateDatabase)
 {
     stub_ext::StubExt st;
@@ -8,9 +8,14 @@
 #include <dfm-base/base/schemefactory.h>
 #include <dfm-base/file/local/localdiriterator.h>
 #include <dfm-base/file/local/syncfileinfo.h>
+#include <dfm-base/utils/systempathutil.h>
 
 #include <gtest/gtest.h>
 
+#include <QTemporaryDir>
+#include <QDir>
+#include <QFile>
+
 DPSEARCH_USE_NAMESPACE
 DFMBASE_USE_NAMESPACE
 
@@ -26,6 +31,7 @@ TEST(IteratorSearcherTest, ut_search_2)
 {
     stub_ext::StubExt st;
     st.set_lamda(&IteratorSearcher::doSearch, [] { __DBG_STUB_INVOKE__ });
+    st.set_lamda(&IteratorSearcher::doLocalSearch, [] { __DBG_STUB_INVOKE__ });
 
     IteratorSearcher search(QUrl::fromLocalFile("/home"), "key");
     search.allResults << QUrl::fromLocalFile("/home");
@@ -65,7 +71,7 @@ TEST(IteratorSearcherTest, tryNotify)
     search.allResults << QUrl::fromLocalFile("/home");
     search.tryNotify();
 
-    EXPECT_EQ(search.lastEmit, 100);
+    EXPECT_EQ(search.lastEmit.loadAcquire(), 100);
 }
 
 TEST(IteratorSearcherTest, doSearch_1)
@@ -102,3 +108,63 @@ TEST(IteratorSearcherTest, doSearch_2)
     EXPECT_FALSE(search.allResults.isEmpty());
     EXPECT_TRUE(search.searchPathList.isEmpty());
 }
+
+TEST(IteratorSearcherTest, doLocalSearch)
+{
+    QTemporaryDir dir;
+    QDir(dir.path()).mkpath("a/b/Key_dir");
+    QDir(dir.path()).mkpath(".hidden");
+    QFile(dir.filePath("a/the_KEY.txt")).open(QIODevice::WriteOnly);
+    QFile(dir.filePath("a/b/other.txt")).open(QIODevice::WriteOnly);
+    QFile(dir.filePath(".hidden/key.txt")).open(QIODevice::WriteOnly);
+
+    IteratorSearcher search(QUrl::fromLocalFile(dir.path()), "key");
+    search.status.storeRelease(AbstractSearcher::kRuning);
+    search.doLocalSearch();
+
+    QList<QUrl> results = search.takeAll();
+    std::sort(results.begin(), results.end());
+    ASSERT_EQ(results.count(), 2);
+    EXPECT_EQ(results.at(0), QUrl::fromLocalFile(dir.filePath("a/b/Key_dir")));
+    EXPECT_EQ(results.at(1), QUrl::fromLocalFile(dir.filePath("a/the_KEY.txt")));
+    EXPECT_TRUE(search.pendingDirs.isEmpty());
+}
+
+TEST(IteratorSearcherTest, doLocalSearchSystemPath)
+{
+    QTemporaryDir dir;
+    QDir(dir.path()).mkpath("Documents");
+    QDir(dir.path()).mkpath("Other");
+    const QString &systemDir = dir.filePath("Documents");
+
+    stub_ext::StubExt st;
+    st.set_lamda(&SystemPathUtil::isSystemPath, [systemDir](SystemPathUtil *, QString path) {
+        __DBG_STUB_INVOKE__
+        return path == systemDir;
+    });
+    st.set_lamda(&SystemPathUtil::systemPathDisplayNameByPath, [systemDir](SystemPathUtil *, QString path) {
+        __DBG_STUB_INVOKE__
+        return path == systemDir ? QString("文档") : QString();
+    });
+
+    IteratorSearcher search(QUrl::fromLocalFile(dir.path()), "文档");
+    search.status.storeRelease(AbstractSearcher::kRuning);
+    search.doLocalSearch();
+
+    const QList<QUrl> &results = search.takeAll();
+    ASSERT_EQ(results.count(), 1);
+    EXPECT_EQ(results.first(), QUrl::fromLocalFile(systemDir));
+}
+
+TEST(IteratorSearcherTest, matchName)
+{
+    IteratorSearcher literal(QUrl::fromLocalFile("/home"), "Key");
+    EXPECT_TRUE(literal.isLiteralKey);
+    EXPECT_TRUE(literal.matchName("a_key_b"));
+    EXPECT_FALSE(literal.matchName("a_ke_b"));
+
+    IteratorSearcher wildcard(QUrl::fromLocalFile("/home"), "k*y");
+    EXPECT_FALSE(wildcard.isLiteralKey);
+    EXPECT_TRUE(wildcard.matchName("kEEy"));
+    EXPECT_FALSE(wildcard.matchName("akey"));
+}